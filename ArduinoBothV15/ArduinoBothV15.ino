@@ -18,6 +18,9 @@
  *   2. Open Serial Monitor at 115200 baud
  *   3. Type "HELP" to see available commands
  *   4. Follow calibration procedures in documentation
+ *   5. Host tools may prefix commands with "#<id> " to get tagged,
+ *      OK/ERR-terminated responses and send up to CMD_QUEUE_DEPTH
+ *      commands at once (see CommandQueue.h)
  * 
  * Author: System Rewrite v1.0 - Complete Edition
  * Date: 2026-02-16
@@ -27,6 +30,18 @@
 #include "SensorReader.h"
 #include "Calibration.h"
 #include "EEPROMManager.h"
+#include "CalHistory.h"
+#include "FastFormat.h"
+#include "OutputQueue.h"
+#include "CommandQueue.h"
+#include "Scheduler.h"
+#include "Perf.h"
+#include "MemoryMonitor.h"
+#include "LatencyHistogram.h"
+#include "LowPower.h"
+#include "Watchdog.h"
+#include "Hal.h"
+#include "CRC16.h"
 
 /*******************************************************************************
  * GLOBAL OBJECTS
@@ -35,198 +50,441 @@
 SensorReader sensor(PIN_EC_SENSOR, PIN_TEMP_SENSOR, PIN_PH_SENSOR);
 Calibration calibration(&sensor);
 EEPROMManager eepromManager;
+CalHistory calHistory;
+CommandQueue commandQueue;
+
+/*******************************************************************************
+ * CALLOAD STAGING
+ * 
+ * CALLOAD chunks are collected here and only applied once the complete
+ * image has arrived and passed the magic/version/CRC checks. The buffer
+ * is taken from the heap by the chunk at offset 0 and given back once the
+ * image is complete, so the 182 bytes are only used during a transfer.
+ ******************************************************************************/
+CalImage* calLoadImage = NULL;
+uint16_t calLoadReceived = 0;
+
+// EELOAD writes each block straight to EEPROM (no room to stage 1 KB);
+// this is the next offset expected
+uint16_t eeLoadReceived = 0;
+
+/*******************************************************************************
+ * PENDING CONFIRMATION STATE
+ * 
+ * Destructive commands (CLEAR, ...) ask to be repeated before they run.
+ * Instead of busy-waiting for the repeat, the request is parked here with
+ * a deadline and loop() keeps running. Repeating the same command within
+ * the window runs the action; any other command or the deadline cancels it.
+ ******************************************************************************/
+typedef void (*ConfirmAction)();
+
+const char*   pendingConfirmCommand  = NULL;   // NULL = nothing pending
+ConfirmAction pendingConfirmAction   = NULL;
+unsigned long pendingConfirmStart    = 0;
+
+/*******************************************************************************
+ * BOOT METRICS
+ ******************************************************************************/
+unsigned long bootReadyMs = 0;   // millis() at the end of setup()
+
+/*******************************************************************************
+ * LATENCY HISTOGRAMS (LATENCY, LATENCY RESET)
+ ******************************************************************************/
+LatencyHistogram loopLatency;      // One scheduler pass
+LatencyHistogram commandLatency;   // Line received -> response queued
+unsigned long latencyResetMs = 0;  // millis() of the last reset
+
+/*******************************************************************************
+ * TASKS
+ * 
+ * loop() only runs the scheduler. Tasks run in table order whenever they
+ * are due, each to completion; period 0 = every pass. Sampling and
+ * filtering run at fixed periods in the background, so READ/CAL_* just
+ * use the latest filtered values. TASKS prints the overrun statistics.
+ ******************************************************************************/
+
+void taskTxDrain() {
+  SerialOut.drain();
+}
+
+void taskSampleEC() {
+  sensor.sampleEC();
+}
+
+void taskSampleTemp() {
+  sensor.sampleTemp();
+}
+
+void taskSamplepH() {
+  sensor.samplepH();
+}
+
+void taskFilter() {
+  sensor.updateFilters();
+}
+
+void taskCommandRx() {
+  commandQueue.poll();
+}
+
+/*
+ * One command per run; the rest wait in the queue. The latency includes
+ * the time spent waiting there behind earlier commands.
+ */
+void taskCommandRun() {
+  String command;
+  char tag[CMD_TAG_MAX];
+  unsigned long receivedUs;
+  if (commandQueue.pop(command, tag, receivedUs)) {
+    if (tag[0] == '\0') {
+      runCommand(command);
+    } else {
+      runTaggedCommand(command, tag);
+    }
+    commandLatency.record(halMicros() - receivedUs);
+  }
+}
+
+void taskHousekeeping() {
+  checkConfirmationTimeout();
+}
+
+const char TASK_NAME_TX[]   PROGMEM = "TX";
+const char TASK_NAME_EC[]   PROGMEM = "EC";
+const char TASK_NAME_TEMP[] PROGMEM = "TEMP";
+const char TASK_NAME_PH[]   PROGMEM = "PH";
+const char TASK_NAME_FILT[] PROGMEM = "FILT";
+const char TASK_NAME_RX[]   PROGMEM = "RX";
+const char TASK_NAME_CMD[]  PROGMEM = "CMD";
+const char TASK_NAME_HK[]   PROGMEM = "HK";
+
+const SchedulerTask tasks[] PROGMEM = {
+  // name          function           period                  deadline
+  { TASK_NAME_TX,   taskTxDrain,       0,                      IO_DEADLINE_MS },
+  { TASK_NAME_EC,   taskSampleEC,      EC_SAMPLE_PERIOD_MS,    EC_SAMPLE_PERIOD_MS },
+  { TASK_NAME_TEMP, taskSampleTemp,    TEMP_SAMPLE_PERIOD_MS,  TEMP_SAMPLE_PERIOD_MS },
+  { TASK_NAME_PH,   taskSamplepH,      PH_SAMPLE_PERIOD_MS,    PH_SAMPLE_PERIOD_MS },
+  { TASK_NAME_FILT, taskFilter,        FILTER_PERIOD_MS,       PH_SAMPLE_PERIOD_MS },
+  { TASK_NAME_RX,   taskCommandRx,     0,                      IO_DEADLINE_MS },
+  { TASK_NAME_CMD,  taskCommandRun,    0,                      COMMAND_DEADLINE_MS },
+  { TASK_NAME_HK,   taskHousekeeping,  HOUSEKEEPING_PERIOD_MS, HOUSEKEEPING_PERIOD_MS }
+};
+
+const uint8_t TASK_COUNT = sizeof(tasks) / sizeof(tasks[0]);
+static_assert(TASK_COUNT <= SCHEDULER_MAX_TASKS, "Raise SCHEDULER_MAX_TASKS");
+
+Scheduler scheduler(tasks, TASK_COUNT);
 
 /*******************************************************************************
  * ARDUINO SETUP
  ******************************************************************************/
 void setup() {
-  Serial.begin(SERIAL_BAUD_RATE);
-  while (!Serial && millis() < 3000);
+  halSerialBegin(SERIAL_BAUD_RATE, SERIAL_WAIT_MS);
   
-  Serial.println();
-  Serial.println(F("SENSOR SYSTEM v1.0"));
-  Serial.println(F("EC|pH|Temp"));
-  Serial.println();
+  // After the USB wait, which is longer than the watchdog timeout
+  watchdogBegin();
   
-  Serial.print(F("Init sensors... "));
+  SerialOut.println();
+  SerialOut.println(F("SENSOR SYSTEM v1.0"));
+  SerialOut.println(F("EC|pH|Temp"));
+  printResetCause();
+  SerialOut.println();
+  
+  SerialOut.print(F("Init sensors... "));
   sensor.begin();
-  Serial.println(F("OK"));
+  SerialOut.println(F("OK"));
   
-  Serial.print(F("Init cal... "));
+  SerialOut.print(F("Init cal... "));
   calibration.begin();
-  Serial.println(F("OK"));
+  SerialOut.println(F("OK"));
   
-  Serial.print(F("Loading EEPROM... "));
+  SerialOut.print(F("Loading EEPROM... "));
   if (eepromManager.load(calibration)) {
-    Serial.println(F("OK"));
+    SerialOut.println(F("OK"));
     calibration.showStatus();
   } else {
-    Serial.println(F("No EEPROM data"));
-    Serial.println(F("Using defaults"));
+    SerialOut.println(F("No EEPROM data"));
+    SerialOut.println(F("Using defaults"));
   }
   
-  Serial.println();
-  Serial.println(F("Ready."));
-  Serial.println();
+  calHistory.begin();
+  calibration.setFitListener(onCalibrationFit);
+  
+  SerialOut.println();
+  SerialOut.println(F("Ready."));
+  SerialOut.println();
+  
+  bootReadyMs = halMillis();
+  scheduler.begin();
 }
 
 /*******************************************************************************
  * ARDUINO LOOP
  ******************************************************************************/
 void loop() {
-  if (Serial.available() > 0) {
-    String command = Serial.readStringUntil('\n');
-    command.trim();
-    command.toUpperCase();
-    
-    if (command.length() == 0) {
-      return;
-    }
-    
-    Serial.print(F("> "));
-    Serial.println(command);
-    
+  unsigned long passStart = halMicros();
+  scheduler.run();
+  loopLatency.record(halMicros() - passStart);
+  
+  // Nothing due and nothing to send or parse: sleep until the next timer
+  // tick or received byte (no-op if LOW_POWER_IDLE is 0)
+  if (scheduler.msUntilNextRelease() > 0 && halSerialAvailable() == 0 &&
+      commandQueue.count() == 0 && SerialOut.pending() == 0) {
+    Power.idle();
+  }
+}
+
+/*******************************************************************************
+ * COMMAND EXECUTION
+ * 
+ * Untagged commands keep the interactive format ("> CMD", output, blank line).
+ * Tagged commands ("#<id> CMD") get every output line prefixed with "#<id> "
+ * and a closing "#<id> OK" or "#<id> ERR", so hosts can pipeline requests.
+ ******************************************************************************/
+void runCommand(String command) {
+  SerialOut.print(F("> "));
+  SerialOut.println(command);
+  
+  dispatchCommand(command);
+  
+  SerialOut.println();
+}
+
+void runTaggedCommand(String command, const char* tag) {
+  SerialOut.beginResponse(tag);
+  if (command.length() == 0) {
+    SerialOut.println(F("ERROR: Empty command"));
+  } else {
+    dispatchCommand(command);
+  }
+  bool failed = SerialOut.endResponse();
+  
+  SerialOut.print('#');
+  SerialOut.print(tag);
+  SerialOut.println(failed ? F(" ERR") : F(" OK"));
+}
+
+void dispatchCommand(String command) {
+  PERF_SCOPE(PERF_COMMAND);
+  
+  if (!handleConfirmation(command)) {
     handleCommand(command);
-    
-    Serial.println();
   }
 }
 
+/*******************************************************************************
+ * CONFIRMATION HANDLING
+ ******************************************************************************/
+
+/*
+ * Park a destructive command until it is repeated within CONFIRM_TIMEOUT_MS.
+ */
+void requestConfirmation(const char* command, ConfirmAction action) {
+  pendingConfirmCommand = command;
+  pendingConfirmAction = action;
+  pendingConfirmStart = halMillis();
+  
+  SerialOut.print(command);
+  SerialOut.print(F(": Type "));
+  SerialOut.print(command);
+  SerialOut.print(F(" again to confirm ("));
+  SerialOut.print(CONFIRM_TIMEOUT_MS / 1000);
+  SerialOut.println(F("s)"));
+}
+
+/*
+ * Called with every received command before normal dispatch.
+ * Returns true if the command was the confirmation and has been consumed.
+ */
+bool handleConfirmation(const String& command) {
+  if (pendingConfirmCommand == NULL) {
+    return false;
+  }
+  
+  if (command == pendingConfirmCommand) {
+    ConfirmAction action = pendingConfirmAction;
+    pendingConfirmCommand = NULL;
+    pendingConfirmAction = NULL;
+    action();
+    return true;
+  }
+  
+  // Any other command cancels the pending one and then runs normally
+  cancelConfirmation();
+  return false;
+}
+
+/*
+ * Expire a pending confirmation once its window has passed.
+ */
+void checkConfirmationTimeout() {
+  if (pendingConfirmCommand != NULL &&
+      halMillis() - pendingConfirmStart >= CONFIRM_TIMEOUT_MS) {
+    cancelConfirmation();
+  }
+}
+
+void cancelConfirmation() {
+  SerialOut.print(pendingConfirmCommand);
+  SerialOut.println(F(" cancelled"));
+  pendingConfirmCommand = NULL;
+  pendingConfirmAction = NULL;
+}
+
 /*******************************************************************************
  * COMMAND HANDLER - COMPLETE IMPLEMENTATION
  ******************************************************************************/
 void handleCommand(String command) {
+  // Command names stay in flash (see isCommand)
+  
   // Parse for commands with arguments (SET commands)
-  if (command.startsWith("SET_EC_LOW_")) {
+  if (hasPrefix(command, PSTR("SET_EC_LOW_"))) {
     int pointNum = command.charAt(11) - '0';  // Extract digit from "SET_EC_LOW_X"
-    float value = parseFloatArg(command, String("SET_EC_LOW_") + String(pointNum));
+    float value = parseFloatArg(command, String(F("SET_EC_LOW_")) + String(pointNum));
     if (pointNum >= 1 && pointNum <= 5) {
       calibration.setECLowRef(pointNum - 1, value);
     } else {
-      Serial.println(F("ERROR: Invalid point number"));
+      SerialOut.println(F("ERROR: Invalid point number"));
     }
     return;
   }
   
-  if (command.startsWith("SET_EC_HIGH_")) {
+  if (hasPrefix(command, PSTR("SET_EC_HIGH_"))) {
     int pointNum = command.charAt(12) - '0';
-    float value = parseFloatArg(command, String("SET_EC_HIGH_") + String(pointNum));
+    float value = parseFloatArg(command, String(F("SET_EC_HIGH_")) + String(pointNum));
     if (pointNum >= 1 && pointNum <= 2) {
       calibration.setECHighRef(pointNum - 1, value);
     } else {
-      Serial.println(F("ERROR: Invalid point number"));
+      SerialOut.println(F("ERROR: Invalid point number"));
     }
     return;
   }
   
-  if (command.startsWith("SET_PH_")) {
+  if (hasPrefix(command, PSTR("SET_PH_"))) {
     int pointNum = command.charAt(7) - '0';
-    float value = parseFloatArg(command, String("SET_PH_") + String(pointNum));
+    float value = parseFloatArg(command, String(F("SET_PH_")) + String(pointNum));
     if (pointNum >= 1 && pointNum <= 3) {
       calibration.setpHRef(pointNum - 1, value);
     } else {
-      Serial.println(F("ERROR: Invalid point number"));
+      SerialOut.println(F("ERROR: Invalid point number"));
     }
     return;
   }
   
-  if (command.startsWith("SET_TEMP_")) {
+  if (hasPrefix(command, PSTR("SET_TEMP_"))) {
     int pointNum = command.charAt(9) - '0';
-    float value = parseFloatArg(command, String("SET_TEMP_") + String(pointNum));
+    float value = parseFloatArg(command, String(F("SET_TEMP_")) + String(pointNum));
     if (pointNum >= 1 && pointNum <= 3) {
       calibration.setTempRef(pointNum - 1, value);
     } else {
-      Serial.println(F("ERROR: Invalid point number"));
+      SerialOut.println(F("ERROR: Invalid point number"));
     }
     return;
   }
   
   // Parse for FORCE calibration commands with voltage argument
-  if (command.startsWith("FORCE_EC_LOW_")) {
+  if (hasPrefix(command, PSTR("FORCE_EC_LOW_"))) {
     int pointNum = command.charAt(13) - '0';  // Extract digit from "FORCE_EC_LOW_X"
-    float voltage = parseFloatArg(command, String("FORCE_EC_LOW_") + String(pointNum));
+    float voltage = parseFloatArg(command, String(F("FORCE_EC_LOW_")) + String(pointNum));
     if (pointNum >= 1 && pointNum <= 5) {
       calibration.forceECLowPoint(pointNum - 1, voltage);
     } else {
-      Serial.println(F("ERROR: Invalid point number"));
+      SerialOut.println(F("ERROR: Invalid point number"));
     }
     return;
   }
   
-  if (command.startsWith("FORCE_EC_HIGH_")) {
+  if (hasPrefix(command, PSTR("FORCE_EC_HIGH_"))) {
     int pointNum = command.charAt(14) - '0';
-    float voltage = parseFloatArg(command, String("FORCE_EC_HIGH_") + String(pointNum));
+    float voltage = parseFloatArg(command, String(F("FORCE_EC_HIGH_")) + String(pointNum));
     if (pointNum >= 1 && pointNum <= 2) {
       calibration.forceECHighPoint(pointNum - 1, voltage);
     } else {
-      Serial.println(F("ERROR: Invalid point number"));
+      SerialOut.println(F("ERROR: Invalid point number"));
     }
     return;
   }
   
-  if (command.startsWith("FORCE_PH_")) {
+  if (hasPrefix(command, PSTR("FORCE_PH_"))) {
     int pointNum = command.charAt(9) - '0';
-    float voltage = parseFloatArg(command, String("FORCE_PH_") + String(pointNum));
+    float voltage = parseFloatArg(command, String(F("FORCE_PH_")) + String(pointNum));
     if (pointNum >= 1 && pointNum <= 3) {
       calibration.forcepHPoint(pointNum - 1, voltage);
     } else {
-      Serial.println(F("ERROR: Invalid point number"));
+      SerialOut.println(F("ERROR: Invalid point number"));
     }
     return;
   }
   
-  if (command.startsWith("FORCE_TEMP_")) {
+  if (hasPrefix(command, PSTR("FORCE_TEMP_"))) {
     int pointNum = command.charAt(11) - '0';
-    float voltage = parseFloatArg(command, String("FORCE_TEMP_") + String(pointNum));
+    float voltage = parseFloatArg(command, String(F("FORCE_TEMP_")) + String(pointNum));
     if (pointNum >= 1 && pointNum <= 3) {
       calibration.forceTempPoint(pointNum - 1, voltage);
     } else {
-      Serial.println(F("ERROR: Invalid point number"));
+      SerialOut.println(F("ERROR: Invalid point number"));
     }
     return;
   }
   
   // EC calibration mode commands
-  if (command == "CALMODE_EC_LOW_3") { cmd_CALMODE_EC_LOW_3(); return; }
-  if (command == "CALMODE_EC_LOW_4") { cmd_CALMODE_EC_LOW_4(); return; }
-  if (command == "CALMODE_EC_LOW_5") { cmd_CALMODE_EC_LOW_5(); return; }
-  if (command == "CALMODE_EC_HIGH_2") { cmd_CALMODE_EC_HIGH_2(); return; }
+  if (isCommand(command, PSTR("CALMODE_EC_LOW_3"))) { cmd_CALMODE_EC_LOW_3(); return; }
+  if (isCommand(command, PSTR("CALMODE_EC_LOW_4"))) { cmd_CALMODE_EC_LOW_4(); return; }
+  if (isCommand(command, PSTR("CALMODE_EC_LOW_5"))) { cmd_CALMODE_EC_LOW_5(); return; }
+  if (isCommand(command, PSTR("CALMODE_EC_HIGH_2"))) { cmd_CALMODE_EC_HIGH_2(); return; }
   
   // EC calibration point commands
-  if (command == "CAL_EC_LOW_1") { cmd_CAL_EC_LOW_1(); return; }
-  if (command == "CAL_EC_LOW_2") { cmd_CAL_EC_LOW_2(); return; }
-  if (command == "CAL_EC_LOW_3") { cmd_CAL_EC_LOW_3(); return; }
-  if (command == "CAL_EC_LOW_4") { cmd_CAL_EC_LOW_4(); return; }
-  if (command == "CAL_EC_LOW_5") { cmd_CAL_EC_LOW_5(); return; }
-  if (command == "CAL_EC_HIGH_1") { cmd_CAL_EC_HIGH_1(); return; }
-  if (command == "CAL_EC_HIGH_2") { cmd_CAL_EC_HIGH_2(); return; }
+  if (isCommand(command, PSTR("CAL_EC_LOW_1"))) { cmd_CAL_EC_LOW_1(); return; }
+  if (isCommand(command, PSTR("CAL_EC_LOW_2"))) { cmd_CAL_EC_LOW_2(); return; }
+  if (isCommand(command, PSTR("CAL_EC_LOW_3"))) { cmd_CAL_EC_LOW_3(); return; }
+  if (isCommand(command, PSTR("CAL_EC_LOW_4"))) { cmd_CAL_EC_LOW_4(); return; }
+  if (isCommand(command, PSTR("CAL_EC_LOW_5"))) { cmd_CAL_EC_LOW_5(); return; }
+  if (isCommand(command, PSTR("CAL_EC_HIGH_1"))) { cmd_CAL_EC_HIGH_1(); return; }
+  if (isCommand(command, PSTR("CAL_EC_HIGH_2"))) { cmd_CAL_EC_HIGH_2(); return; }
   
   // pH calibration commands
-  if (command == "CALMODE_PH_3") { cmd_CALMODE_PH_3(); return; }
-  if (command == "CAL_PH_1") { cmd_CAL_PH_1(); return; }
-  if (command == "CAL_PH_2") { cmd_CAL_PH_2(); return; }
-  if (command == "CAL_PH_3") { cmd_CAL_PH_3(); return; }
+  if (isCommand(command, PSTR("CALMODE_PH_3"))) { cmd_CALMODE_PH_3(); return; }
+  if (isCommand(command, PSTR("CAL_PH_1"))) { cmd_CAL_PH_1(); return; }
+  if (isCommand(command, PSTR("CAL_PH_2"))) { cmd_CAL_PH_2(); return; }
+  if (isCommand(command, PSTR("CAL_PH_3"))) { cmd_CAL_PH_3(); return; }
   
   // Temperature calibration commands
-  if (command == "CALMODE_TEMP_3") { cmd_CALMODE_TEMP_3(); return; }
-  if (command == "CAL_TEMP_1") { cmd_CAL_TEMP_1(); return; }
-  if (command == "CAL_TEMP_2") { cmd_CAL_TEMP_2(); return; }
-  if (command == "CAL_TEMP_3") { cmd_CAL_TEMP_3(); return; }
+  if (isCommand(command, PSTR("CALMODE_TEMP_3"))) { cmd_CALMODE_TEMP_3(); return; }
+  if (isCommand(command, PSTR("CAL_TEMP_1"))) { cmd_CAL_TEMP_1(); return; }
+  if (isCommand(command, PSTR("CAL_TEMP_2"))) { cmd_CAL_TEMP_2(); return; }
+  if (isCommand(command, PSTR("CAL_TEMP_3"))) { cmd_CAL_TEMP_3(); return; }
   
   // General commands
-  if (command == "READ") { cmd_READ(); return; }
-  if (command == "DIAG") { cmd_DIAG(); return; }
-  if (command == "EQUATIONS") { cmd_EQUATIONS(); return; }
-  if (command == "STATUS_COMPACT") { cmd_STATUS_COMPACT(); return; }
-  if (command == "QUALITY") { cmd_QUALITY(); return; }
-  if (command == "CLEAR") { cmd_CLEAR(); return; }
-  if (command == "SAVE") { cmd_SAVE(); return; }
-  if (command == "LOAD") { cmd_LOAD(); return; }
+  if (isCommand(command, PSTR("READ"))) { cmd_READ(); return; }
+  if (isCommand(command, PSTR("DIAG"))) { cmd_DIAG(); return; }
+  if (isCommand(command, PSTR("MEM"))) { cmd_MEM(); return; }
+  if (isCommand(command, PSTR("EQUATIONS"))) { cmd_EQUATIONS(); return; }
+  if (isCommand(command, PSTR("STATUS_COMPACT"))) { cmd_STATUS_COMPACT(); return; }
+  if (isCommand(command, PSTR("QUALITY"))) { cmd_QUALITY(); return; }
+  if (isCommand(command, PSTR("CLEAR"))) { cmd_CLEAR(); return; }
+  if (isCommand(command, PSTR("SAVE"))) { cmd_SAVE(); return; }
+  if (isCommand(command, PSTR("LOAD"))) { cmd_LOAD(); return; }
+  if (isCommand(command, PSTR("CALDUMP"))) { cmd_CALDUMP(); return; }
+  if (isCommand(command, PSTR("CALHIST"))) { cmd_CALHIST(); return; }
+  if (isCommand(command, PSTR("PROFILES"))) { cmd_PROFILES(); return; }
+  if (isCommand(command, PSTR("TASKS"))) { cmd_TASKS(); return; }
+  if (isCommand(command, PSTR("TASKS RESET"))) { cmd_TASKS_RESET(); return; }
+  if (isCommand(command, PSTR("PERF"))) { cmd_PERF(); return; }
+  if (isCommand(command, PSTR("PERF RESET"))) { cmd_PERF_RESET(); return; }
+  if (isCommand(command, PSTR("LATENCY"))) { cmd_LATENCY(); return; }
+  if (isCommand(command, PSTR("LATENCY RESET"))) { cmd_LATENCY_RESET(); return; }
+  if (isCommand(command, PSTR("POWER"))) { cmd_POWER(); return; }
+  if (isCommand(command, PSTR("POWER RESET"))) { cmd_POWER_RESET(); return; }
+  if (hasPrefix(command, PSTR("PROFILE "))) { cmd_PROFILE(command); return; }
+  if (hasPrefix(command, PSTR("PROBE_ID "))) { cmd_PROBE_ID(command); return; }
+  if (hasPrefix(command, PSTR("CALLOAD "))) { cmd_CALLOAD(command); return; }
+  if (isCommand(command, PSTR("EEDUMP"))) { cmd_EEDUMP(); return; }
+  if (hasPrefix(command, PSTR("EELOAD "))) { cmd_EELOAD(command); return; }
   
   // Unknown command
-  Serial.print(F("ERROR: Unknown command: "));
-  Serial.println(command);
-  Serial.println(F("Type HELP for list of commands"));
+  SerialOut.print(F("ERROR: Unknown command: "));
+  SerialOut.println(command);
+  SerialOut.println(F("Type HELP for list of commands"));
 }
 
 /*******************************************************************************
@@ -239,6 +497,28 @@ float parseFloatArg(String command, String commandName) {
   return command.toFloat();
 }
 
+/*
+ * Compare the command with a name in flash (PSTR). String literals would
+ * each be copied to RAM at boot; the dispatch table alone has ~570 bytes.
+ */
+bool isCommand(const String& command, const char* name) {
+  return strcmp_P(command.c_str(), name) == 0;
+}
+
+bool hasPrefix(const String& command, const char* prefix) {
+  return strncmp_P(command.c_str(), prefix, strlen_P(prefix)) == 0;
+}
+
+/*
+ * Value of one hex digit, or -1 if c is not a hex digit
+ */
+int8_t hexNibble(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  return -1;
+}
+
 /*******************************************************************************
  * EC CALIBRATION MODE COMMANDS
  ******************************************************************************/
@@ -341,62 +621,121 @@ void cmd_READ() {
   float pH = calibration.getCalibratedpH();
   float temp = calibration.getCalibratedTemperature();
   
-  Serial.println(F("SENSOR READINGS"));
+  SerialOut.println(F("SENSOR READINGS"));
   
   // EC
-  Serial.print(F("EC:   "));
+  SerialOut.print(F("EC:   "));
   if (ec < 0) {
-    Serial.println(F("NOT CALIBRATED"));
+    SerialOut.println(F("NOT CALIBRATED"));
   } else {
-    Serial.print(ec, 1);
-    Serial.println(F(" uS/cm"));
+    printFixed(SerialOut, ec, 1);
+    SerialOut.println(F(" uS/cm"));
   }
   
   // Temperature
-  Serial.print(F("Temp: "));
-  Serial.print(temp, 1);
-  Serial.print(F(" C"));
+  SerialOut.print(F("Temp: "));
+  printFixed(SerialOut, temp, 1);
+  SerialOut.print(F(" C"));
   if (!calibration.isTempCalibrated()) {
-    Serial.println(F(" (uncalibrated)"));
+    SerialOut.println(F(" (uncalibrated)"));
   } else {
-    Serial.println();
+    SerialOut.println();
   }
   
   // pH
-  Serial.print(F("pH:   "));
+  SerialOut.print(F("pH:   "));
   if (pH < 0) {
-    Serial.println(F("NOT CALIBRATED"));
+    SerialOut.println(F("NOT CALIBRATED"));
   } else {
-    Serial.print(pH, 2);
-    Serial.println();
+    printFixed(SerialOut, pH, 2);
+    SerialOut.println();
   }
 }
 
 void cmd_DIAG() {
-  Serial.println(F("DIAG"));
+  SerialOut.println(F("DIAG"));
+  
+  SerialOut.print(F("ADC: EC="));
+  SerialOut.print(sensor.readRawADC_EC());
+  SerialOut.print(F(" T="));
+  SerialOut.print(sensor.readRawADC_Temp());
+  SerialOut.print(F(" pH="));
+  SerialOut.println(sensor.readRawADC_pH());
   
-  Serial.print(F("ADC: EC="));
-  Serial.print(sensor.readRawADC_EC());
-  Serial.print(F(" T="));
-  Serial.print(sensor.readRawADC_Temp());
-  Serial.print(F(" pH="));
-  Serial.println(sensor.readRawADC_pH());
+  SerialOut.print(F("mV:  EC="));
+  printFixed(SerialOut, sensor.readVoltage_EC(), 1);
+  SerialOut.print(F(" T="));
+  printFixed(SerialOut, sensor.readVoltage_Temp(), 1);
+  SerialOut.print(F(" pH="));
+  printlnFixed(SerialOut, sensor.readVoltage_pH(), 1);
   
-  Serial.print(F("mV:  EC="));
-  Serial.print(sensor.readVoltage_EC(), 1);
-  Serial.print(F(" T="));
-  Serial.print(sensor.readVoltage_Temp(), 1);
-  Serial.print(F(" pH="));
-  Serial.println(sensor.readVoltage_pH(), 1);
+  SerialOut.print(F("Raw: T="));
+  printFixed(SerialOut, sensor.readTemperature(), 1);
+  SerialOut.print(F("C pH="));
+  printFixed(SerialOut, sensor.readpH(), 2);
+  SerialOut.println(F("(est)"));
   
-  Serial.print(F("Raw: T="));
-  Serial.print(sensor.readTemperature(), 1);
-  Serial.print(F("C pH="));
-  Serial.print(sensor.readpH(), 2);
-  Serial.println(F("(est)"));
+  unsigned long verifyStart = halMicros();
+  bool eepromOK = eepromManager.verify();
+  unsigned long verifyTime = halMicros() - verifyStart;
+  SerialOut.print(F("EEPROM: "));
+  SerialOut.print(eepromOK ? F("OK") : F("FAIL"));
+  SerialOut.print(F(" (verify "));
+  SerialOut.print(verifyTime);
+  SerialOut.println(F("us)"));
   
-  Serial.print(F("EEPROM: "));
-  Serial.println(eepromManager.verify() ? F("OK") : F("FAIL"));
+  SerialOut.print(F("Profile: "));
+  SerialOut.print(eepromManager.getProfile());
+  printProbeId(eepromManager.getProfile());
+  SerialOut.println();
+  
+  SerialOut.print(F("Boot: ready "));
+  SerialOut.print(bootReadyMs);
+  SerialOut.print(F("ms, first reading "));
+  SerialOut.print(sensor.getFirstReadingMs());
+  SerialOut.println(F("ms"));
+  
+  printResetCause();
+  
+  MemoryStats mem;
+  if (!readMemoryStats(mem)) {
+    SerialOut.println(F("Mem: n/a"));
+    return;
+  }
+  SerialOut.print(F("Mem: heap "));
+  SerialOut.print(mem.heapFree);
+  SerialOut.print(F(" free (largest "));
+  SerialOut.print(mem.largestBlock);
+  SerialOut.print(F("), stack peak "));
+  SerialOut.print(mem.stackPeak);
+  SerialOut.print(F(", headroom "));
+  SerialOut.print(mem.stackHeadroom);
+  SerialOut.println(mem.stackHeadroom < MEM_LOW_HEADROOM ? F(" LOW") : F(""));
+}
+
+void cmd_MEM() {
+  // Bytes; "Stack headroom" is the smallest heap/stack gap since reset
+  MemoryStats mem;
+  if (!readMemoryStats(mem)) {
+    SerialOut.println(F("ERROR: No memory statistics on this build"));
+    return;
+  }
+  
+  SerialOut.println(F("MEM"));
+  SerialOut.print(F("Heap free: "));
+  SerialOut.println(mem.heapFree);
+  SerialOut.print(F("Largest block: "));
+  SerialOut.println(mem.largestBlock);
+  SerialOut.print(F("Fragments: "));
+  SerialOut.println(mem.fragments);
+  SerialOut.print(F("Stack peak: "));
+  SerialOut.println(mem.stackPeak);
+  SerialOut.print(F("Stack headroom: "));
+  SerialOut.println(mem.stackHeadroom);
+  
+  if (mem.stackHeadroom < MEM_LOW_HEADROOM) {
+    SerialOut.println(F("WARNING: Low memory headroom"));
+  }
 }
 
 void cmd_EQUATIONS() {
@@ -410,44 +749,58 @@ void cmd_STATUS() {
 void cmd_STATUS_COMPACT() {
   // Machine-readable compact status for Python parsing
   // Format: SENSOR:calibrated,pointCount,R2|SENSOR:calibrated,pointCount,R2|...
-  // Example: ECL:1,4,0.9987|ECH:0,0,0.0000|PH:1,3,0.9995|T:1,3,0.9998
+  //         |MEM:heapFree,largestBlock,stackPeak,stackHeadroom
+  // Example: ECL:1,4,0.9987|ECH:0,0,0.0000|PH:1,3,0.9995|T:1,3,0.9998|MEM:812,684,402,355
   
-  Serial.print(F("STATUS_COMPACT:"));
+  SerialOut.print(F("STATUS_COMPACT:"));
   
   // EC Low
-  Serial.print(F("ECL:"));
-  Serial.print(calibration.isECLowCalibrated() ? 1 : 0);
-  Serial.print(F(","));
-  Serial.print(calibration.getECLowPointCount());
-  Serial.print(F(","));
-  Serial.print(calibration.getECLowR2(), 4);
-  Serial.print(F("|"));
+  SerialOut.print(F("ECL:"));
+  SerialOut.print(calibration.isECLowCalibrated() ? 1 : 0);
+  SerialOut.print(F(","));
+  SerialOut.print(calibration.getECLowPointCount());
+  SerialOut.print(F(","));
+  printFixed(SerialOut, calibration.getECLowR2(), 4);
+  SerialOut.print(F("|"));
   
   // EC High
-  Serial.print(F("ECH:"));
-  Serial.print(calibration.isECHighCalibrated() ? 1 : 0);
-  Serial.print(F(","));
-  Serial.print(calibration.getECHighPointCount());
-  Serial.print(F(","));
-  Serial.print(calibration.getECHighR2(), 4);
-  Serial.print(F("|"));
+  SerialOut.print(F("ECH:"));
+  SerialOut.print(calibration.isECHighCalibrated() ? 1 : 0);
+  SerialOut.print(F(","));
+  SerialOut.print(calibration.getECHighPointCount());
+  SerialOut.print(F(","));
+  printFixed(SerialOut, calibration.getECHighR2(), 4);
+  SerialOut.print(F("|"));
   
   // pH
-  Serial.print(F("PH:"));
-  Serial.print(calibration.ispHCalibrated() ? 1 : 0);
-  Serial.print(F(","));
-  Serial.print(calibration.getpHPointCount());
-  Serial.print(F(","));
-  Serial.print(calibration.getpHR2(), 4);
-  Serial.print(F("|"));
+  SerialOut.print(F("PH:"));
+  SerialOut.print(calibration.ispHCalibrated() ? 1 : 0);
+  SerialOut.print(F(","));
+  SerialOut.print(calibration.getpHPointCount());
+  SerialOut.print(F(","));
+  printFixed(SerialOut, calibration.getpHR2(), 4);
+  SerialOut.print(F("|"));
   
   // Temperature
-  Serial.print(F("T:"));
-  Serial.print(calibration.isTempCalibrated() ? 1 : 0);
-  Serial.print(F(","));
-  Serial.print(calibration.getTempPointCount());
-  Serial.print(F(","));
-  Serial.println(calibration.getTempR2(), 4);
+  SerialOut.print(F("T:"));
+  SerialOut.print(calibration.isTempCalibrated() ? 1 : 0);
+  SerialOut.print(F(","));
+  SerialOut.print(calibration.getTempPointCount());
+  SerialOut.print(F(","));
+  printFixed(SerialOut, calibration.getTempR2(), 4);
+  SerialOut.print(F("|"));
+  
+  // Memory (see cmd_MEM; all 0 where not available)
+  MemoryStats mem;
+  readMemoryStats(mem);
+  SerialOut.print(F("MEM:"));
+  SerialOut.print(mem.heapFree);
+  SerialOut.print(F(","));
+  SerialOut.print(mem.largestBlock);
+  SerialOut.print(F(","));
+  SerialOut.print(mem.stackPeak);
+  SerialOut.print(F(","));
+  SerialOut.println(mem.stackHeadroom);
 }
 
 void cmd_QUALITY() {
@@ -460,123 +813,608 @@ void cmd_PLOT_DATA() {
   
   // EC Low
   if (calibration.getECLowPointCount() > 0) {
-    Serial.print(F("PLOT_ECL|"));
+    SerialOut.print(F("PLOT_ECL|"));
     CalibrationData ecLowData = calibration.getECLowData();
     for (uint8_t i = 0; i < 5; i++) {
       if (ecLowData.voltages[i] > 0.0) {
-        Serial.print(ecLowData.voltages[i], 1);
-        Serial.print(F(","));
-        Serial.print(ecLowData.references[i], 1);
-        Serial.print(F("|"));
+        printFixed(SerialOut, ecLowData.voltages[i], 1);
+        SerialOut.print(F(","));
+        printFixed(SerialOut, ecLowData.references[i], 1);
+        SerialOut.print(F("|"));
       }
     }
     CalibrationEquation ecLowEq = calibration.getECLowEquation();
-    Serial.print(ecLowEq.C, 6);
-    Serial.print(F(","));
-    Serial.print(ecLowEq.D, 2);
-    Serial.print(F(","));
-    Serial.println(ecLowEq.R2, 4);
+    printFixed(SerialOut, ecLowEq.C, 6);
+    SerialOut.print(F(","));
+    printFixed(SerialOut, ecLowEq.D, 2);
+    SerialOut.print(F(","));
+    printlnFixed(SerialOut, ecLowEq.R2, 4);
   }
   
   // EC High
   if (calibration.getECHighPointCount() > 0) {
-    Serial.print(F("PLOT_ECH|"));
+    SerialOut.print(F("PLOT_ECH|"));
     CalibrationData ecHighData = calibration.getECHighData();
     for (uint8_t i = 0; i < 2; i++) {
       if (ecHighData.voltages[i] > 0.0) {
-        Serial.print(ecHighData.voltages[i], 1);
-        Serial.print(F(","));
-        Serial.print(ecHighData.references[i], 1);
-        Serial.print(F("|"));
+        printFixed(SerialOut, ecHighData.voltages[i], 1);
+        SerialOut.print(F(","));
+        printFixed(SerialOut, ecHighData.references[i], 1);
+        SerialOut.print(F("|"));
       }
     }
     CalibrationEquation ecHighEq = calibration.getECHighEquation();
-    Serial.print(ecHighEq.C, 6);
-    Serial.print(F(","));
-    Serial.print(ecHighEq.D, 2);
-    Serial.print(F(","));
-    Serial.println(ecHighEq.R2, 4);
+    printFixed(SerialOut, ecHighEq.C, 6);
+    SerialOut.print(F(","));
+    printFixed(SerialOut, ecHighEq.D, 2);
+    SerialOut.print(F(","));
+    printlnFixed(SerialOut, ecHighEq.R2, 4);
   }
   
   // pH
   if (calibration.getpHPointCount() > 0) {
-    Serial.print(F("PLOT_PH|"));
+    SerialOut.print(F("PLOT_PH|"));
     CalibrationData pHData = calibration.getpHData();
     for (uint8_t i = 0; i < 3; i++) {
       if (pHData.voltages[i] > 0.0) {
-        Serial.print(pHData.voltages[i], 1);
-        Serial.print(F(","));
-        Serial.print(pHData.references[i], 2);
-        Serial.print(F("|"));
+        printFixed(SerialOut, pHData.voltages[i], 1);
+        SerialOut.print(F(","));
+        printFixed(SerialOut, pHData.references[i], 2);
+        SerialOut.print(F("|"));
       }
     }
     CalibrationEquation pHEq = calibration.getpHEquation();
-    Serial.print(pHEq.C, 6);
-    Serial.print(F(","));
-    Serial.print(pHEq.D, 2);
-    Serial.print(F(","));
-    Serial.println(pHEq.R2, 4);
+    printFixed(SerialOut, pHEq.C, 6);
+    SerialOut.print(F(","));
+    printFixed(SerialOut, pHEq.D, 2);
+    SerialOut.print(F(","));
+    printlnFixed(SerialOut, pHEq.R2, 4);
   }
   
   // Temperature
   if (calibration.getTempPointCount() > 0) {
-    Serial.print(F("PLOT_T|"));
+    SerialOut.print(F("PLOT_T|"));
     CalibrationData tempData = calibration.getTempData();
     for (uint8_t i = 0; i < 3; i++) {
       if (tempData.voltages[i] > 0.0) {
-        Serial.print(tempData.voltages[i], 1);
-        Serial.print(F(","));
-        Serial.print(tempData.references[i], 1);
-        Serial.print(F("|"));
+        printFixed(SerialOut, tempData.voltages[i], 1);
+        SerialOut.print(F(","));
+        printFixed(SerialOut, tempData.references[i], 1);
+        SerialOut.print(F("|"));
       }
     }
     CalibrationEquation tempEq = calibration.getTempEquation();
-    Serial.print(tempEq.C, 6);
-    Serial.print(F(","));
-    Serial.print(tempEq.D, 2);
-    Serial.print(F(","));
-    Serial.println(tempEq.R2, 4);
+    printFixed(SerialOut, tempEq.C, 6);
+    SerialOut.print(F(","));
+    printFixed(SerialOut, tempEq.D, 2);
+    SerialOut.print(F(","));
+    printlnFixed(SerialOut, tempEq.R2, 4);
   }
 }
 
 void cmd_CLEAR() {
-  Serial.println(F("CLEAR: Type CLEAR again to confirm (5s)"));
-  
-  unsigned long startTime = millis();
-  while (millis() - startTime < 5000) {
-    if (Serial.available() > 0) {
-      String confirm = Serial.readStringUntil('\n');
-      confirm.trim();
-      confirm.toUpperCase();
-      
-      if (confirm == "CLEAR") {
-        calibration.setECLowMode(LOW_4PT);
-        calibration.setECHighMode(HIGH_2PT);
-        calibration.setpHMode(PH_3PT);
-        calibration.setTempMode(TEMP_3PT);
-        Serial.println(F("Cleared. SAVE to wipe EEPROM"));
-        return;
-      }
-    }
-  }
-  Serial.println(F("Clear cancelled"));
+  requestConfirmation(CMD_CLEAR, confirmed_CLEAR);
+}
+
+void confirmed_CLEAR() {
+  resetCalibration();
+  SerialOut.println(F("Cleared. SAVE to wipe EEPROM"));
+}
+
+/*
+ * Back to the default modes with no calibration points
+ */
+void resetCalibration() {
+  calibration.setECLowMode(LOW_4PT);
+  calibration.setECHighMode(HIGH_2PT);
+  calibration.setpHMode(PH_3PT);
+  calibration.setTempMode(TEMP_3PT);
 }
 
 void cmd_SAVE() {
   if (eepromManager.save(calibration)) {
-    Serial.println(F("Saved OK"));
+    SerialOut.println(F("Saved OK"));
   } else {
-    Serial.println(F("ERR: Save failed"));
+    SerialOut.println(F("ERR: Save failed"));
   }
 }
 
 void cmd_LOAD() {
   if (eepromManager.load(calibration)) {
-    Serial.println(F("Loaded OK"));
+    SerialOut.println(F("Loaded OK"));
+    calibration.showStatus();
+  } else {
+    SerialOut.println(F("Load failed - using current"));
+  }
+}
+
+/*******************************************************************************
+ * CALIBRATION PROFILES
+ * 
+ * One complete calibration per probe set (see Config.h). SAVE/LOAD work
+ * on the active profile; PROFILE <n> switches to another one by loading
+ * its saved record, so a probe swap needs no re-fit. Like LOAD, switching
+ * discards unsaved changes. A profile with no saved record starts from
+ * the defaults; one whose records are all damaged is not switched to.
+ ******************************************************************************/
+
+void cmd_PROFILE(String command) {
+  String arg = command.substring(8);  // After "PROFILE "
+  arg.trim();
+  
+  if (arg.length() != 1 || arg.charAt(0) < '0' || arg.charAt(0) >= '0' + PROFILE_COUNT) {
+    SerialOut.print(F("ERROR: PROFILE expects 0-"));
+    SerialOut.println(PROFILE_COUNT - 1);
+    return;
+  }
+  
+  uint8_t profile = arg.charAt(0) - '0';
+  EEPROMManager::LoadResult result = eepromManager.selectProfile(profile, calibration);
+  
+  if (result == EEPROMManager::LOAD_CORRUPT) {
+    // Not switched: the records may be restorable (EELOAD), and the
+    // calibration in RAM still belongs to the current profile
+    uint8_t current = eepromManager.getProfile();
+    SerialOut.println(F("ERROR: Saved calibration is corrupt, not switched"));
+    SerialOut.print(F("Profile "));
+    SerialOut.print(current);
+    printProbeId(current);
+    SerialOut.println(F(" still active"));
+    return;
+  }
+  
+  SerialOut.print(F("Profile "));
+  SerialOut.print(profile);
+  printProbeId(profile);
+  SerialOut.println(F(" active"));
+  
+  if (result == EEPROMManager::LOAD_OK) {
+    calibration.showStatus();
+  } else {
+    resetCalibration();
+    SerialOut.println(F("No saved calibration: calibrate and SAVE"));
+  }
+}
+
+void cmd_PROFILES() {
+  eepromManager.printProfiles();
+}
+
+/*
+ * PROBE_ID <id>: tag the active profile (1-8 of A-Z 0-9 - _)
+ */
+void cmd_PROBE_ID(String command) {
+  String id = command.substring(9);  // After "PROBE_ID "
+  id.trim();
+  
+  if (id.length() == 0 || id.length() > PROBE_ID_LEN) {
+    SerialOut.print(F("ERROR: Probe ID must be 1-"));
+    SerialOut.print(PROBE_ID_LEN);
+    SerialOut.println(F(" characters"));
+    return;
+  }
+  
+  for (uint8_t i = 0; i < id.length(); i++) {
+    char c = id.charAt(i);
+    if (!isAlphaNumeric(c) && c != '-' && c != '_') {
+      SerialOut.println(F("ERROR: Probe ID may only use A-Z 0-9 - _"));
+      return;
+    }
+  }
+  
+  char buffer[PROBE_ID_LEN + 1];
+  id.toCharArray(buffer, sizeof(buffer));
+  if (!eepromManager.setProbeId(buffer)) {
+    SerialOut.println(F("ERROR: Probe ID not written"));
+    return;
+  }
+  
+  SerialOut.print(F("Profile "));
+  SerialOut.print(eepromManager.getProfile());
+  printProbeId(eepromManager.getProfile());
+  SerialOut.println();
+}
+
+/*
+ * " (<probe id>)", or nothing if the profile has none
+ */
+void printProbeId(uint8_t profile) {
+  char id[PROBE_ID_LEN + 1];
+  eepromManager.getProbeId(profile, id);
+  if (id[0] != '\0') {
+    SerialOut.print(F(" ("));
+    SerialOut.print(id);
+    SerialOut.print(')');
+  }
+}
+
+/*
+ * "Reset: WATCHDOG in task CMD (2 since power-on)" - the task that hung,
+ * or "outside tasks" if the scheduler was between tasks
+ */
+void printResetCause() {
+  uint8_t flags = getResetFlags();
+  
+  SerialOut.print(F("Reset: "));
+  printResetFlags(SerialOut, flags);
+  
+  if (flags & RESET_WATCHDOG) {
+    const __FlashStringHelper* task = scheduler.getTaskName(getResetTask());
+    if (task != NULL) {
+      SerialOut.print(F(" in task "));
+      SerialOut.print(task);
+    } else {
+      SerialOut.print(F(" outside tasks"));
+    }
+    SerialOut.print(F(" ("));
+    SerialOut.print(getWatchdogResets());
+    SerialOut.print(F(" since power-on)"));
+  }
+  SerialOut.println();
+}
+
+/*******************************************************************************
+ * CALIBRATION HISTORY
+ * 
+ * Every successful fit is appended to the EEPROM history log; CALHIST
+ * streams it oldest first (format in CalHistory.cpp).
+ ******************************************************************************/
+
+void onCalibrationFit(uint8_t sensor, const CalibrationEquation& eq) {
+  calHistory.append(eepromManager.getProfile(), sensor, eq);
+}
+
+void cmd_CALHIST() {
+  calHistory.print();
+}
+
+/*******************************************************************************
+ * SCHEDULER STATISTICS
+ * 
+ * TASKS lists every task with its overruns and longest run (format in
+ * Scheduler.cpp); TASKS RESET starts a new measurement.
+ ******************************************************************************/
+
+void cmd_TASKS() {
+  scheduler.printStats();
+}
+
+void cmd_TASKS_RESET() {
+  scheduler.resetStats();
+  SerialOut.println(F("Task statistics reset"));
+}
+
+/*******************************************************************************
+ * PERFORMANCE PROBES
+ * 
+ * PERF prints the timing probes (format in Perf.cpp), PERF RESET clears
+ * them. PROFILE already selects calibration profiles, hence the name.
+ ******************************************************************************/
+
+void cmd_PERF() {
+#if PERF_PROBES
+  Perf.print();
+#else
+  SerialOut.println(F("ERROR: Probes disabled (PERF_PROBES in Config.h)"));
+#endif
+}
+
+void cmd_PERF_RESET() {
+#if PERF_PROBES
+  Perf.reset();
+  SerialOut.println(F("Probes reset"));
+#else
+  SerialOut.println(F("ERROR: Probes disabled (PERF_PROBES in Config.h)"));
+#endif
+}
+
+/*******************************************************************************
+ * LATENCY HISTOGRAMS
+ * 
+ * Format (one column per histogram, one row per bucket; LIMIT_US is the
+ * exclusive upper bound, "+" = open-ended last bucket):
+ *   LATENCY <ms since reset>
+ *   STAT,LOOP,CMD
+ *   COUNT,48210,12
+ *   P50_US,32,4096
+ *   P90_US,64,8192
+ *   P99_US,128,640000
+ *   MAX_US,100152,640396
+ *   LIMIT_US,LOOP,CMD
+ *   32,47011,0
+ *   ...
+ *   +,0,0
+ *   LATENCY END
+ ******************************************************************************/
+
+void printLatencyStat(const __FlashStringHelper* name, uint32_t loopValue, uint32_t cmdValue) {
+  SerialOut.print(name);
+  SerialOut.print(',');
+  SerialOut.print(loopValue);
+  SerialOut.print(',');
+  SerialOut.println(cmdValue);
+}
+
+void cmd_LATENCY() {
+  // Runs inside one scheduler pass, so neither histogram moves meanwhile
+  SerialOut.print(F("LATENCY "));
+  SerialOut.println(halMillis() - latencyResetMs);
+  
+  SerialOut.println(F("STAT,LOOP,CMD"));
+  printLatencyStat(F("COUNT"), loopLatency.getCount(), commandLatency.getCount());
+  printLatencyStat(F("P50_US"), loopLatency.percentileUs(50), commandLatency.percentileUs(50));
+  printLatencyStat(F("P90_US"), loopLatency.percentileUs(90), commandLatency.percentileUs(90));
+  printLatencyStat(F("P99_US"), loopLatency.percentileUs(99), commandLatency.percentileUs(99));
+  printLatencyStat(F("MAX_US"), loopLatency.getMaxUs(), commandLatency.getMaxUs());
+  
+  SerialOut.println(F("LIMIT_US,LOOP,CMD"));
+  for (uint8_t i = 0; i < LATENCY_BUCKETS; i++) {
+    uint32_t limit = LatencyHistogram::bucketLimitUs(i);
+    if (limit == 0) {
+      SerialOut.print('+');
+    } else {
+      SerialOut.print(limit);
+    }
+    SerialOut.print(',');
+    SerialOut.print(loopLatency.getBucket(i));
+    SerialOut.print(',');
+    SerialOut.println(commandLatency.getBucket(i));
+  }
+  
+  SerialOut.println(F("LATENCY END"));
+}
+
+void cmd_LATENCY_RESET() {
+  loopLatency.reset();
+  commandLatency.reset();
+  latencyResetMs = halMillis();
+  SerialOut.println(F("Latency histograms reset"));
+}
+
+/*******************************************************************************
+ * POWER
+ * 
+ * POWER prints the sleep statistics and current estimate (format in
+ * LowPower.cpp); the achieved sample cadence is the AVG_PERIOD_MS column
+ * of TASKS. POWER RESET clears both.
+ ******************************************************************************/
+
+void cmd_POWER() {
+  Power.printStats();
+}
+
+void cmd_POWER_RESET() {
+  Power.resetStats();
+  scheduler.resetStats();
+  SerialOut.println(F("Power and task statistics reset"));
+}
+
+/*******************************************************************************
+ * CALIBRATION IMAGE TRANSFER
+ * 
+ * CALDUMP prints the complete calibration state as the same image SAVE
+ * writes to EEPROM (magic, version, data, CRC16), as a series of lines
+ * that are themselves valid CALLOAD commands:
+ * 
+ *   CALDUMP 182
+ *   CALLOAD 0 57EC0104...
+ *   CALLOAD 16 ...
+ *   ...
+ * 
+ * Sending those CALLOAD lines back (to this or another unit) restores the
+ * state once the last chunk arrives. CALLOAD does not write EEPROM; SAVE
+ * afterwards to persist. Chunks must arrive in order; offset 0 restarts.
+ ******************************************************************************/
+
+void cmd_CALDUMP() {
+  CalImage image;
+  eepromManager.exportImage(calibration, image);
+  const uint8_t* bytes = (const uint8_t*)&image;
+  
+  SerialOut.print(F("CALDUMP "));
+  SerialOut.println(CAL_IMAGE_SIZE);
+  
+  for (uint16_t offset = 0; offset < CAL_IMAGE_SIZE; offset += CAL_CHUNK_BYTES) {
+    SerialOut.print(F("CALLOAD "));
+    SerialOut.print(offset);
+    SerialOut.print(' ');
+    for (uint16_t i = offset; i < offset + CAL_CHUNK_BYTES && i < CAL_IMAGE_SIZE; i++) {
+      printHex8(SerialOut, bytes[i]);
+    }
+    SerialOut.println();
+  }
+}
+
+void cmd_CALLOAD(String command) {
+  // Format: CALLOAD <offset> <hex bytes>
+  int space = command.indexOf(' ', 8);
+  if (space < 0) {
+    SerialOut.println(F("ERROR: Usage CALLOAD <offset> <hex>"));
+    return;
+  }
+  
+  long offset = command.substring(8, space).toInt();
+  String hex = command.substring(space + 1);
+  hex.trim();
+  uint16_t count = hex.length() / 2;
+  
+  if (offset == 0) {
+    calLoadReceived = 0;
+    if (calLoadImage == NULL) {
+      calLoadImage = (CalImage*)malloc(sizeof(CalImage));
+    }
+    if (calLoadImage == NULL) {
+      SerialOut.println(F("ERROR: CALLOAD out of memory"));
+      return;
+    }
+  }
+  
+  if (offset != (long)calLoadReceived) {
+    SerialOut.print(F("ERROR: CALLOAD expected offset "));
+    SerialOut.println(calLoadReceived);
+    return;
+  }
+  
+  if ((hex.length() % 2) != 0 || count == 0 || count > CAL_CHUNK_BYTES ||
+      calLoadReceived + count > CAL_IMAGE_SIZE) {
+    SerialOut.println(F("ERROR: CALLOAD bad chunk"));
+    return;
+  }
+  
+  for (uint16_t i = 0; i < count; i++) {
+    int8_t hi = hexNibble(hex.charAt(2 * i));
+    int8_t lo = hexNibble(hex.charAt(2 * i + 1));
+    if (hi < 0 || lo < 0) {
+      SerialOut.println(F("ERROR: CALLOAD bad hex"));
+      return;
+    }
+    ((uint8_t*)calLoadImage)[calLoadReceived + i] = (uint8_t)((hi << 4) | lo);
+  }
+  calLoadReceived += count;
+  
+  if (calLoadReceived < CAL_IMAGE_SIZE) {
+    SerialOut.print(F("CALLOAD "));
+    SerialOut.print(calLoadReceived);
+    SerialOut.print('/');
+    SerialOut.println(CAL_IMAGE_SIZE);
+    return;
+  }
+  
+  // Complete image: validate and apply
+  calLoadReceived = 0;
+  bool imported = eepromManager.importImage(*calLoadImage, calibration);
+  free(calLoadImage);
+  calLoadImage = NULL;
+  
+  if (imported) {
+    SerialOut.println(F("CALLOAD OK (SAVE to persist)"));
+    calibration.showStatus();
+  } else {
+    SerialOut.println(F("ERR: CALLOAD rejected"));
+  }
+}
+
+/*******************************************************************************
+ * RAW EEPROM IMAGE TRANSFER
+ * 
+ * EEDUMP prints the whole EEPROM (calibration journal, history, free
+ * space) in EE_CHUNK_BYTES blocks, each with the CRC16 of its bytes. The
+ * lines are themselves valid EELOAD commands:
+ * 
+ *   EEDUMP 1024
+ *   EELOAD 0 57EC0204... 3A1F
+ *   EELOAD 16 ... 91C2
+ *   ...
+ *   EEDUMP END
+ * 
+ * EELOAD checks each block's CRC16 and writes it to EEPROM right away.
+ * Blocks must arrive in order; offset 0 restarts. After the last block
+ * the calibration is reloaded from the new image. tools/eeprom_tool
+ * drives both commands to back up and restore units from files.
+ ******************************************************************************/
+
+void cmd_EEDUMP() {
+  uint8_t block[EE_CHUNK_BYTES];
+  
+  SerialOut.print(F("EEDUMP "));
+  SerialOut.println(EEPROM_SIZE);
+  
+  for (uint16_t offset = 0; offset < EEPROM_SIZE; offset += EE_CHUNK_BYTES) {
+    eepromManager.readRaw(offset, block, EE_CHUNK_BYTES);
+    
+    SerialOut.print(F("EELOAD "));
+    SerialOut.print(offset);
+    SerialOut.print(' ');
+    for (uint8_t i = 0; i < EE_CHUNK_BYTES; i++) {
+      printHex8(SerialOut, block[i]);
+    }
+    SerialOut.print(' ');
+    uint16_t crc = crc16Update(CRC16_INIT, block, EE_CHUNK_BYTES);
+    printHex8(SerialOut, highByte(crc));
+    printHex8(SerialOut, lowByte(crc));
+    SerialOut.println();
+  }
+  
+  SerialOut.println(F("EEDUMP END"));
+}
+
+void cmd_EELOAD(String command) {
+  // Format: EELOAD <offset> <hex bytes> <crc16 hex>
+  int space = command.indexOf(' ', 7);
+  int crcSpace = command.lastIndexOf(' ');
+  if (space < 0 || crcSpace <= space) {
+    SerialOut.println(F("ERROR: Usage EELOAD <offset> <hex> <crc>"));
+    return;
+  }
+  
+  long offset = command.substring(7, space).toInt();
+  String hex = command.substring(space + 1, crcSpace);
+  String crcHex = command.substring(crcSpace + 1);
+  
+  if (offset == 0) {
+    eeLoadReceived = 0;
+  }
+  
+  if (offset != (long)eeLoadReceived) {
+    SerialOut.print(F("ERROR: EELOAD expected offset "));
+    SerialOut.println(eeLoadReceived);
+    return;
+  }
+  
+  if (hex.length() != 2 * EE_CHUNK_BYTES || crcHex.length() != 4) {
+    SerialOut.println(F("ERROR: EELOAD bad block"));
+    return;
+  }
+  
+  uint8_t block[EE_CHUNK_BYTES];
+  for (uint8_t i = 0; i < EE_CHUNK_BYTES; i++) {
+    int8_t hi = hexNibble(hex.charAt(2 * i));
+    int8_t lo = hexNibble(hex.charAt(2 * i + 1));
+    if (hi < 0 || lo < 0) {
+      SerialOut.println(F("ERROR: EELOAD bad hex"));
+      return;
+    }
+    block[i] = (uint8_t)((hi << 4) | lo);
+  }
+  
+  uint16_t crc = 0;
+  for (uint8_t i = 0; i < 4; i++) {
+    int8_t nibble = hexNibble(crcHex.charAt(i));
+    if (nibble < 0) {
+      SerialOut.println(F("ERROR: EELOAD bad hex"));
+      return;
+    }
+    crc = (crc << 4) | (uint8_t)nibble;
+  }
+  
+  if (crc != crc16Update(CRC16_INIT, block, EE_CHUNK_BYTES)) {
+    SerialOut.println(F("ERROR: EELOAD CRC mismatch"));
+    return;
+  }
+  
+  if (!eepromManager.writeRaw(eeLoadReceived, block, EE_CHUNK_BYTES)) {
+    SerialOut.println(F("ERROR: EELOAD write failed"));
+    return;
+  }
+  eeLoadReceived += EE_CHUNK_BYTES;
+  
+  if (eeLoadReceived < EEPROM_SIZE) {
+    SerialOut.print(F("EELOAD "));
+    SerialOut.print(eeLoadReceived);
+    SerialOut.print('/');
+    SerialOut.println(EEPROM_SIZE);
+    return;
+  }
+  
+  // Complete image: pick up the new calibration and history
+  eeLoadReceived = 0;
+  if (eepromManager.load(calibration)) {
     calibration.showStatus();
   } else {
-    Serial.println(F("Load failed - using current"));
+    SerialOut.println(F("EELOAD: Image holds no calibration, current kept"));
   }
+  calHistory.begin();
+  SerialOut.println(F("EELOAD OK"));
 }
 
 /*******************************************************************************
@@ -0,0 +1,40 @@
+/*******************************************************************************
+ * CRC16.CPP - Table-Driven CRC-16-CCITT Implementation
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "CRC16.h"
+
+/*******************************************************************************
+ * NIBBLE TABLE
+ *
+ * CRC16_NIBBLE[n] = CRC of the 4-bit value n shifted through the top of
+ * the register (n << 12, four polynomial steps).
+ ******************************************************************************/
+static const uint16_t CRC16_NIBBLE[16] PROGMEM = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+/*******************************************************************************
+ * UPDATE
+ ******************************************************************************/
+uint16_t crc16Update(uint16_t crc, uint8_t data) {
+  // High nibble, then low nibble
+  crc = (crc << 4) ^ pgm_read_word(&CRC16_NIBBLE[(crc >> 12) ^ (data >> 4)]);
+  crc = (crc << 4) ^ pgm_read_word(&CRC16_NIBBLE[(crc >> 12) ^ (data & 0x0F)]);
+  return crc;
+}
+
+uint16_t crc16Update(uint16_t crc, const uint8_t data[], uint16_t length) {
+  for (uint16_t i = 0; i < length; i++) {
+    crc = crc16Update(crc, data[i]);
+  }
+  return crc;
+}
+
+/*******************************************************************************
+ * END OF CRC16 IMPLEMENTATION
+ ******************************************************************************/
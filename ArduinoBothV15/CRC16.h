@@ -0,0 +1,38 @@
+/*******************************************************************************
+ * CRC16.H - Table-Driven CRC-16-CCITT
+ *
+ * Purpose:
+ *   CRC-16-CCITT (polynomial 0x1021, initial value 0xFFFF, MSB first) used
+ *   for the EEPROM image checksum and journal seals.
+ *
+ * Why a table:
+ *   The bitwise form loops 8 times per byte. A 16-entry PROGMEM nibble
+ *   table (32 bytes of flash) does the same work with two lookups per
+ *   byte, without the 512 bytes a full byte table would cost.
+ *
+ * Incremental use:
+ *   uint16_t crc = CRC16_INIT;
+ *   crc = crc16Update(crc, byte);          // one byte at a time
+ *   crc = crc16Update(crc, buffer, len);   // or a whole block
+ *
+ *   Results are identical to the previous bitwise implementation, so
+ *   existing EEPROM images stay valid.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef CRC16_H
+#define CRC16_H
+
+#include <Arduino.h>
+
+const uint16_t CRC16_INIT = 0xFFFF;
+
+/*
+ * Add one byte / a block of bytes to a running CRC.
+ */
+uint16_t crc16Update(uint16_t crc, uint8_t data);
+uint16_t crc16Update(uint16_t crc, const uint8_t data[], uint16_t length);
+
+#endif // CRC16_H
@@ -0,0 +1,174 @@
+/*******************************************************************************
+ * CALHISTORY.CPP - On-Device Calibration History Log Implementation
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "CalHistory.h"
+#include "CRC16.h"
+#include "FastFormat.h"
+#include "OutputQueue.h"
+
+/*******************************************************************************
+ * CONSTRUCTOR
+ ******************************************************************************/
+CalHistory::CalHistory()
+  : _newest(HISTORY_NO_RECORD),
+    _fit(0),
+    _count(0)
+{
+}
+
+/*******************************************************************************
+ * INITIALIZATION
+ *
+ * Finds the newest intact record. Fit numbers are compared with
+ * wrap-around arithmetic, like journal sequence numbers.
+ ******************************************************************************/
+void CalHistory::begin() {
+  _newest = HISTORY_NO_RECORD;
+  _count = 0;
+
+  HistoryRecord record;
+  for (uint8_t i = 0; i < HISTORY_SLOTS; i++) {
+    if (!_readRecord(i, record)) {
+      continue;
+    }
+
+    _count++;
+    if (_newest == HISTORY_NO_RECORD || (int16_t)(record.fit - _fit) > 0) {
+      _newest = i;
+      _fit = record.fit;
+    }
+  }
+}
+
+/*******************************************************************************
+ * LOGGING
+ *
+ * Overwrites the slot after the newest record (the oldest one). Only cells
+ * that differ are written; the CRC16 goes last so an interrupted append
+ * leaves an invalid record instead of a wrong one.
+ ******************************************************************************/
+bool CalHistory::append(uint8_t profile, uint8_t sensor, const CalibrationEquation& eq) {
+  uint8_t slot = 0;
+  uint16_t fit = 1;
+  if (_newest != HISTORY_NO_RECORD) {
+    slot = (_newest + 1) % HISTORY_SLOTS;
+    fit = _fit + 1;
+  }
+
+  HistoryRecord old;
+  bool replaced = _readRecord(slot, old);
+
+  HistoryRecord record;
+  record.fit = fit;
+  record.sensor = sensor | (profile << 4);
+  record.eq.C = eq.C;
+  record.eq.D = eq.D;
+  record.eq.R2 = eq.R2;
+  record.eq.RMSE = eq.RMSE;
+  record.crc = _crcFor(record);
+
+  uint16_t base = _slotAddress(slot);
+  const uint8_t* bytes = (const uint8_t*)&record;
+  for (uint16_t i = 0; i < HISTORY_RECORD_SIZE; i++) {
+    halNvUpdate(base + i, bytes[i]);
+  }
+
+  if (!_readRecord(slot, old)) {
+    SerialOut.println(F("WARN: History record not written"));
+    return false;
+  }
+
+  _newest = slot;
+  _fit = fit;
+  if (!replaced) {
+    _count++;
+  }
+  return true;
+}
+
+/*******************************************************************************
+ * OUTPUT (CALHIST)
+ *
+ * Format (oldest first, one line per fit):
+ *   CALHIST <count>/<slots>
+ *   FIT,PROFILE,SENSOR,C,D,R2,RMSE
+ *   12,0,PH,-0.005712,17.54,0.9961,0.071
+ *   ...
+ *   CALHIST END
+ ******************************************************************************/
+void CalHistory::print() {
+  SerialOut.print(F("CALHIST "));
+  SerialOut.print(_count);
+  SerialOut.print('/');
+  SerialOut.println(HISTORY_SLOTS);
+  SerialOut.println(F("FIT,PROFILE,SENSOR,C,D,R2,RMSE"));
+
+  if (_newest != HISTORY_NO_RECORD) {
+    HistoryRecord record;
+    for (uint8_t n = 1; n <= HISTORY_SLOTS; n++) {
+      uint8_t slot = (_newest + n) % HISTORY_SLOTS;
+      if (!_readRecord(slot, record)) {
+        continue;
+      }
+
+      SerialOut.print(record.fit);
+      SerialOut.print(',');
+      SerialOut.print(record.sensor >> 4);
+      switch (record.sensor & 0x0F) {
+        case DIRTY_EC_LOW:  SerialOut.print(F(",ECL,")); break;
+        case DIRTY_EC_HIGH: SerialOut.print(F(",ECH,")); break;
+        case DIRTY_PH:      SerialOut.print(F(",PH,"));  break;
+        default:            SerialOut.print(F(",TEMP,")); break;
+      }
+      printFixed(SerialOut, record.eq.C, 6);
+      SerialOut.print(',');
+      printFixed(SerialOut, record.eq.D, 2);
+      SerialOut.print(',');
+      printFixed(SerialOut, record.eq.R2, 4);
+      SerialOut.print(',');
+      printlnFixed(SerialOut, record.eq.RMSE, 3);
+    }
+  }
+
+  SerialOut.println(F("CALHIST END"));
+}
+
+/*******************************************************************************
+ * PRIVATE HELPER METHODS
+ ******************************************************************************/
+
+uint16_t CalHistory::_slotAddress(uint8_t slot) {
+  return HISTORY_START + (uint16_t)slot * HISTORY_RECORD_SIZE;
+}
+
+/*
+ * Read one record; false if its CRC16 or sensor/profile field is not
+ * valid (erased cells or a torn append).
+ */
+bool CalHistory::_readRecord(uint8_t slot, HistoryRecord& record) {
+  halNvGet(_slotAddress(slot), record);
+
+  if (record.crc != _crcFor(record)) {
+    return false;
+  }
+
+  if ((record.sensor >> 4) >= PROFILE_COUNT) {
+    return false;
+  }
+  
+  uint8_t sensor = record.sensor & 0x0F;
+  return sensor == DIRTY_EC_LOW || sensor == DIRTY_EC_HIGH ||
+         sensor == DIRTY_PH || sensor == DIRTY_TEMP;
+}
+
+uint16_t CalHistory::_crcFor(const HistoryRecord& record) {
+  return crc16Update(CRC16_INIT, (const uint8_t*)&record, offsetof(HistoryRecord, crc));
+}
+
+/*******************************************************************************
+ * END OF CALHISTORY IMPLEMENTATION
+ ******************************************************************************/
@@ -0,0 +1,78 @@
+/*******************************************************************************
+ * CALHISTORY.H - On-Device Calibration History Log
+ *
+ * Purpose:
+ *   Keeps the result of every successful fit (C, D, R², RMSE per sensor)
+ *   in a circular log in the EEPROM space after the calibration journal.
+ *   Drift of a probe's slope and offset across recalibrations can then be
+ *   read back with CALHIST, without a host-side database. Each record
+ *   carries the calibration profile (probe set) it was fitted for.
+ *
+ * How it works:
+ *   - begin() scans the HISTORY_SLOTS records once for the newest one
+ *   - append() writes the next record over the oldest, CRC16 last
+ *   - print() streams all intact records, oldest first
+ *
+ * Record layout: HistoryRecord in Config.h
+ *
+ * Does NOT handle:
+ *   - The current calibration (see EEPROMManager)
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef CALHISTORY_H
+#define CALHISTORY_H
+
+#include <Arduino.h>
+#include "Hal.h"
+#include "Config.h"
+#include "Calibration.h"
+
+/*******************************************************************************
+ * CLASS: CalHistory
+ ******************************************************************************/
+class CalHistory {
+public:
+  /***************************************************************************
+   * CONSTRUCTOR & INITIALIZATION
+   ***************************************************************************/
+  CalHistory();
+  void begin();
+
+  /***************************************************************************
+   * LOGGING
+   *
+   * sensor is the DIRTY_* bit of the fitted sensor, profile the active
+   * calibration profile.
+   ***************************************************************************/
+  bool append(uint8_t profile, uint8_t sensor, const CalibrationEquation& eq);
+
+  /***************************************************************************
+   * OUTPUT (CALHIST)
+   ***************************************************************************/
+  void print();
+
+  /***************************************************************************
+   * STATUS
+   ***************************************************************************/
+  uint8_t getCount() const { return _count; }
+
+private:
+  /***************************************************************************
+   * PRIVATE MEMBER VARIABLES
+   ***************************************************************************/
+  uint8_t  _newest;   // Slot of the newest record (HISTORY_NO_RECORD = empty)
+  uint16_t _fit;      // Its fit number
+  uint8_t  _count;    // Intact records in the log
+
+  /***************************************************************************
+   * PRIVATE HELPER METHODS
+   ***************************************************************************/
+  uint16_t _slotAddress(uint8_t slot);
+  bool _readRecord(uint8_t slot, HistoryRecord& record);
+  uint16_t _crcFor(const HistoryRecord& record);
+};
+
+#endif // CALHISTORY_H
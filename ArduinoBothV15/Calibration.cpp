@@ -20,6 +20,9 @@
  ******************************************************************************/
 
 #include "Calibration.h"
+#include "FastFormat.h"
+#include "OutputQueue.h"
+#include "Perf.h"
 
 /*******************************************************************************
  * CONSTRUCTOR
@@ -37,6 +40,7 @@ Calibration::Calibration(SensorReader* sensor)
     _ecHighR2(0.0), _ecHighRMSE(0.0),
     _isECLowCal(false), _isECHighCal(false),
     _ecLowCount(0), _ecHighCount(0),
+    _ecRangeThresholdMv(EC_RANGE_THRESHOLD_MV),
     // pH calibration
     _pHMode(PH_3PT),
     _pHC(0.0), _pHD(0.0),
@@ -48,7 +52,10 @@ Calibration::Calibration(SensorReader* sensor)
     _tempC(0.0), _tempD(0.0),
     _tempR2(0.0), _tempRMSE(0.0),
     _isTempCal(false),
-    _tempCount(0)
+    _tempCount(0),
+    // Nothing persisted yet
+    _dirty(DIRTY_ALL),
+    _fitListener(NULL)
 {
 }
 
@@ -82,9 +89,9 @@ void Calibration::begin() {
     _tempVolts[i] = 0.0;
   }
   
-  Serial.print(F("Cal init: ECL="));
-  Serial.print(_ecLowMode);
-  Serial.println(F("pt pH=3pt Temp=3pt"));
+  SerialOut.print(F("Cal init: ECL="));
+  SerialOut.print(_ecLowMode);
+  SerialOut.println(F("pt pH=3pt Temp=3pt"));
 }
 
 /*******************************************************************************
@@ -122,7 +129,7 @@ void Calibration::_linearRegression(const float x[], const float y[],
   float denominator = count * sumX2 - sumX * sumX;
   
   if (abs(denominator) < 0.0001) {
-    Serial.println(F("ERROR: Cannot calculate regression (all voltages identical)"));
+    SerialOut.println(F("ERROR: Cannot calculate regression (all voltages identical)"));
     C = 0.0;
     D = 0.0;
     return;
@@ -212,11 +219,11 @@ float Calibration::_calculateRMSE(const float x[], const float y[],
 bool Calibration::_validatePoints(const float volts[], uint8_t count, 
                                   const char* sensorName) {
   if (count < 2) {
-    Serial.print(F("ERR: "));
-    Serial.print(sensorName);
-    Serial.print(F(" needs 2+ pts (have "));
-    Serial.print(count);
-    Serial.println(F(")"));
+    SerialOut.print(F("ERR: "));
+    SerialOut.print(sensorName);
+    SerialOut.print(F(" needs 2+ pts (have "));
+    SerialOut.print(count);
+    SerialOut.println(F(")"));
     return false;
   }
   
@@ -226,17 +233,17 @@ bool Calibration::_validatePoints(const float volts[], uint8_t count,
       float separation = abs(volts[i] - volts[j]);
       
       if (separation < MIN_VOLTAGE_SEPARATION) {
-        Serial.print(F("ERR: "));
-        Serial.print(sensorName);
-        Serial.print(F(" P"));
-        Serial.print(i + 1);
-        Serial.print(F("-P"));
-        Serial.print(j + 1);
-        Serial.print(F(" too close ("));
-        Serial.print(separation, 1);
-        Serial.print(F("mV < "));
-        Serial.print(MIN_VOLTAGE_SEPARATION, 1);
-        Serial.println(F("mV min) Stabilize!"));
+        SerialOut.print(F("ERR: "));
+        SerialOut.print(sensorName);
+        SerialOut.print(F(" P"));
+        SerialOut.print(i + 1);
+        SerialOut.print(F("-P"));
+        SerialOut.print(j + 1);
+        SerialOut.print(F(" too close ("));
+        printFixed(SerialOut, separation, 1);
+        SerialOut.print(F("mV < "));
+        printFixed(SerialOut, MIN_VOLTAGE_SEPARATION, 1);
+        SerialOut.println(F("mV min) Stabilize!"));
         return false;
       }
     }
@@ -254,13 +261,13 @@ bool Calibration::_validatePoints(const float volts[], uint8_t count,
   float span = maxVolt - minVolt;
   
   if (span < MIN_VOLTAGE_SPAN) {
-    Serial.print(F("ERR: "));
-    Serial.print(sensorName);
-    Serial.print(F(" span "));
-    Serial.print(span, 1);
-    Serial.print(F("mV < "));
-    Serial.print(MIN_VOLTAGE_SPAN, 1);
-    Serial.println(F("mV min. Check solutions"));
+    SerialOut.print(F("ERR: "));
+    SerialOut.print(sensorName);
+    SerialOut.print(F(" span "));
+    printFixed(SerialOut, span, 1);
+    SerialOut.print(F("mV < "));
+    printFixed(SerialOut, MIN_VOLTAGE_SPAN, 1);
+    SerialOut.println(F("mV min. Check solutions"));
     return false;
   }
   
@@ -281,6 +288,7 @@ void Calibration::_resetECLowCalibrationData() {
   _ecLowRMSE = 0.0;
   _isECLowCal = false;
   _ecLowCount = 0;
+  _dirty |= DIRTY_EC_LOW;
 }
 
 void Calibration::_resetECHighCalibrationData() {
@@ -293,6 +301,7 @@ void Calibration::_resetECHighCalibrationData() {
   _ecHighRMSE = 0.0;
   _isECHighCal = false;
   _ecHighCount = 0;
+  _dirty |= DIRTY_EC_HIGH;
 }
 
 void Calibration::_resetpHCalibrationData() {
@@ -305,6 +314,7 @@ void Calibration::_resetpHCalibrationData() {
   _pHRMSE = 0.0;
   _ispHCal = false;
   _pHCount = 0;
+  _dirty |= DIRTY_PH;
 }
 
 void Calibration::_resetTempCalibrationData() {
@@ -317,6 +327,7 @@ void Calibration::_resetTempCalibrationData() {
   _tempRMSE = 0.0;
   _isTempCal = false;
   _tempCount = 0;
+  _dirty |= DIRTY_TEMP;
 }
 
 /*******************************************************************************
@@ -393,20 +404,20 @@ void Calibration::setECLowMode(ECLowMode mode) {
   _ecLowMode = mode;
   _resetECLowCalibrationData();
   
-  Serial.print(F("ECL mode: "));
-  Serial.print((uint8_t)mode);
-  Serial.println(F("pt"));
+  SerialOut.print(F("ECL mode: "));
+  SerialOut.print((uint8_t)mode);
+  SerialOut.println(F("pt"));
   
-  Serial.print(F("Pts: "));
+  SerialOut.print(F("Pts: "));
   for (uint8_t i = 0; i < EC_LOW_CAL_POINTS; i++) {
     if (_isECLowPointRequired(i)) {
-      Serial.print(i + 1);
-      Serial.print(F("("));
-      Serial.print(_ecLowRef[i], 0);
-      Serial.print(F(") "));
+      SerialOut.print(i + 1);
+      SerialOut.print(F("("));
+      printFixed(SerialOut, _ecLowRef[i], 0);
+      SerialOut.print(F(") "));
     }
   }
-  Serial.println();
+  SerialOut.println();
 }
 
 /*******************************************************************************
@@ -416,10 +427,10 @@ void Calibration::setECHighMode(ECHighMode mode) {
   _ecHighMode = mode;
   _resetECHighCalibrationData();
   
-  Serial.print(F("ECH mode: "));
-  Serial.print((uint8_t)mode);
-  Serial.println(F("pt"));
-  Serial.println(F("Pts: 1(1413) 2(12880)"));
+  SerialOut.print(F("ECH mode: "));
+  SerialOut.print((uint8_t)mode);
+  SerialOut.println(F("pt"));
+  SerialOut.println(F("Pts: 1(1413) 2(12880)"));
 }
 
 /*******************************************************************************
@@ -429,10 +440,10 @@ void Calibration::setpHMode(pHMode mode) {
   _pHMode = mode;
   _resetpHCalibrationData();
   
-  Serial.print(F("pH mode: "));
-  Serial.print((uint8_t)mode);
-  Serial.println(F("pt"));
-  Serial.println(F("Pts: 1(4.00) 2(7.00) 3(10.00)"));
+  SerialOut.print(F("pH mode: "));
+  SerialOut.print((uint8_t)mode);
+  SerialOut.println(F("pt"));
+  SerialOut.println(F("Pts: 1(4.00) 2(7.00) 3(10.00)"));
 }
 
 /*******************************************************************************
@@ -442,10 +453,10 @@ void Calibration::setTempMode(TempMode mode) {
   _tempMode = mode;
   _resetTempCalibrationData();
   
-  Serial.print(F("Temp mode: "));
-  Serial.print((uint8_t)mode);
-  Serial.println(F("pt"));
-  Serial.println(F("Pts: 1(25C) 2(32C) 3(40C)"));
+  SerialOut.print(F("Temp mode: "));
+  SerialOut.print((uint8_t)mode);
+  SerialOut.println(F("pt"));
+  SerialOut.println(F("Pts: 1(25C) 2(32C) 3(40C)"));
 }
 
 /*******************************************************************************
@@ -456,16 +467,16 @@ void Calibration::setTempMode(TempMode mode) {
 void Calibration::calibrateECLowPoint(uint8_t pointNum) {
   // Validate point number (0-4, but check if required for current mode)
   if (pointNum >= EC_LOW_CAL_POINTS) {
-    Serial.println(F("ERR: ECL pt# invalid"));
+    SerialOut.println(F("ERR: ECL pt# invalid"));
     return;
   }
   
   if (!_isECLowPointRequired(pointNum)) {
-    Serial.print(F("ERR: Pt"));
-    Serial.print(pointNum + 1);
-    Serial.print(F(" not in "));
-    Serial.print((uint8_t)_ecLowMode);
-    Serial.println(F("pt mode"));
+    SerialOut.print(F("ERR: Pt"));
+    SerialOut.print(pointNum + 1);
+    SerialOut.print(F(" not in "));
+    SerialOut.print((uint8_t)_ecLowMode);
+    SerialOut.println(F("pt mode"));
     return;
   }
   
@@ -474,6 +485,7 @@ void Calibration::calibrateECLowPoint(uint8_t pointNum) {
   float temperature = _sensor->readTemperature();
   
   _ecLowVolts[pointNum] = voltage;
+  _dirty |= DIRTY_EC_LOW;
   
   bool alreadyCaptured = false;
   for (uint8_t i = 0; i < pointNum; i++) {
@@ -492,23 +504,23 @@ void Calibration::calibrateECLowPoint(uint8_t pointNum) {
     }
   }
   
-  Serial.print(F("ECL P"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(": Vmv="));
-  Serial.print(voltage, 1);
-  Serial.print(F(" T="));
-  Serial.print(temperature, 1);
-  Serial.print(F("C Ref="));
-  Serial.print(_ecLowRef[pointNum], 1);
-  Serial.print(F("uS L"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(":"));
-  Serial.print(_ecLowCount);
-  Serial.print(F("/"));
-  Serial.println(_getRequiredECLowPoints());
+  SerialOut.print(F("ECL P"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(": Vmv="));
+  printFixed(SerialOut, voltage, 1);
+  SerialOut.print(F(" T="));
+  printFixed(SerialOut, temperature, 1);
+  SerialOut.print(F("C Ref="));
+  printFixed(SerialOut, _ecLowRef[pointNum], 1);
+  SerialOut.print(F("uS L"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(":"));
+  SerialOut.print(_ecLowCount);
+  SerialOut.print(F("/"));
+  SerialOut.println(_getRequiredECLowPoints());
   
   if (_ecLowCount == _getRequiredECLowPoints()) {
-    Serial.println(F("ECL: calc..."));
+    SerialOut.println(F("ECL: calc..."));
     _calculateECLowEquation();
   }
 }
@@ -518,7 +530,7 @@ void Calibration::calibrateECLowPoint(uint8_t pointNum) {
  ******************************************************************************/
 void Calibration::calibrateECHighPoint(uint8_t pointNum) {
   if (pointNum >= EC_HIGH_CAL_POINTS) {
-    Serial.println(F("ERR: ECH pt# invalid"));
+    SerialOut.println(F("ERR: ECH pt# invalid"));
     return;
   }
   
@@ -526,6 +538,7 @@ void Calibration::calibrateECHighPoint(uint8_t pointNum) {
   float temperature = _sensor->readTemperature();
   
   _ecHighVolts[pointNum] = voltage;
+  _dirty |= DIRTY_EC_HIGH;
   
   _ecHighCount = 0;
   for (uint8_t i = 0; i < EC_HIGH_CAL_POINTS; i++) {
@@ -534,23 +547,23 @@ void Calibration::calibrateECHighPoint(uint8_t pointNum) {
     }
   }
   
-  Serial.print(F("ECH P"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(": Vmv="));
-  Serial.print(voltage, 1);
-  Serial.print(F(" T="));
-  Serial.print(temperature, 1);
-  Serial.print(F("C Ref="));
-  Serial.print(_ecHighRef[pointNum], 1);
-  Serial.print(F("uS H"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(":"));
-  Serial.print(_ecHighCount);
-  Serial.print(F("/"));
-  Serial.println(_getRequiredECHighPoints());
+  SerialOut.print(F("ECH P"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(": Vmv="));
+  printFixed(SerialOut, voltage, 1);
+  SerialOut.print(F(" T="));
+  printFixed(SerialOut, temperature, 1);
+  SerialOut.print(F("C Ref="));
+  printFixed(SerialOut, _ecHighRef[pointNum], 1);
+  SerialOut.print(F("uS H"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(":"));
+  SerialOut.print(_ecHighCount);
+  SerialOut.print(F("/"));
+  SerialOut.println(_getRequiredECHighPoints());
   
   if (_ecHighCount == _getRequiredECHighPoints()) {
-    Serial.println(F("ECH: calc..."));
+    SerialOut.println(F("ECH: calc..."));
     _calculateECHighEquation();
   }
 }
@@ -560,7 +573,7 @@ void Calibration::calibrateECHighPoint(uint8_t pointNum) {
  ******************************************************************************/
 void Calibration::calibratepHPoint(uint8_t pointNum) {
   if (pointNum >= PH_CAL_POINTS) {
-    Serial.println(F("ERR: pH pt# invalid"));
+    SerialOut.println(F("ERR: pH pt# invalid"));
     return;
   }
   
@@ -568,6 +581,7 @@ void Calibration::calibratepHPoint(uint8_t pointNum) {
   float temperature = _sensor->readTemperature();
   
   _pHVolts[pointNum] = voltage;
+  _dirty |= DIRTY_PH;
   
   _pHCount = 0;
   for (uint8_t i = 0; i < PH_CAL_POINTS; i++) {
@@ -576,23 +590,23 @@ void Calibration::calibratepHPoint(uint8_t pointNum) {
     }
   }
   
-  Serial.print(F("pH P"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(": Vmv="));
-  Serial.print(voltage, 1);
-  Serial.print(F(" T="));
-  Serial.print(temperature, 1);
-  Serial.print(F("C Ref="));
-  Serial.print(_pHRef[pointNum], 2);
-  Serial.print(F("pH P"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(":"));
-  Serial.print(_pHCount);
-  Serial.print(F("/"));
-  Serial.println(_getRequiredpHPoints());
+  SerialOut.print(F("pH P"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(": Vmv="));
+  printFixed(SerialOut, voltage, 1);
+  SerialOut.print(F(" T="));
+  printFixed(SerialOut, temperature, 1);
+  SerialOut.print(F("C Ref="));
+  printFixed(SerialOut, _pHRef[pointNum], 2);
+  SerialOut.print(F("pH P"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(":"));
+  SerialOut.print(_pHCount);
+  SerialOut.print(F("/"));
+  SerialOut.println(_getRequiredpHPoints());
   
   if (_pHCount == _getRequiredpHPoints()) {
-    Serial.println(F("pH: calc..."));
+    SerialOut.println(F("pH: calc..."));
     _calculatepHEquation();
   }
 }
@@ -602,13 +616,14 @@ void Calibration::calibratepHPoint(uint8_t pointNum) {
  ******************************************************************************/
 void Calibration::calibrateTempPoint(uint8_t pointNum) {
   if (pointNum >= TEMP_CAL_POINTS) {
-    Serial.println(F("ERR: Temp pt# invalid"));
+    SerialOut.println(F("ERR: Temp pt# invalid"));
     return;
   }
   
   float voltage = _sensor->readVoltage_Temp();
   
   _tempVolts[pointNum] = voltage;
+  _dirty |= DIRTY_TEMP;
   
   _tempCount = 0;
   for (uint8_t i = 0; i < TEMP_CAL_POINTS; i++) {
@@ -617,21 +632,21 @@ void Calibration::calibrateTempPoint(uint8_t pointNum) {
     }
   }
   
-  Serial.print(F("Temp P"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(": Vmv="));
-  Serial.print(voltage, 1);
-  Serial.print(F(" Ref="));
-  Serial.print(_tempRef[pointNum], 1);
-  Serial.print(F("C T"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(":"));
-  Serial.print(_tempCount);
-  Serial.print(F("/"));
-  Serial.println(_getRequiredTempPoints());
+  SerialOut.print(F("Temp P"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(": Vmv="));
+  printFixed(SerialOut, voltage, 1);
+  SerialOut.print(F(" Ref="));
+  printFixed(SerialOut, _tempRef[pointNum], 1);
+  SerialOut.print(F("C T"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(":"));
+  SerialOut.print(_tempCount);
+  SerialOut.print(F("/"));
+  SerialOut.println(_getRequiredTempPoints());
   
   if (_tempCount == _getRequiredTempPoints()) {
-    Serial.println(F("Temp: calc..."));
+    SerialOut.println(F("Temp: calc..."));
     _calculateTempEquation();
   }
 }
@@ -643,20 +658,21 @@ void Calibration::calibrateTempPoint(uint8_t pointNum) {
  ******************************************************************************/
 void Calibration::forceECLowPoint(uint8_t pointNum, float voltage_mV) {
   if (pointNum >= EC_LOW_CAL_POINTS) {
-    Serial.println(F("ERR: ECL pt# invalid"));
+    SerialOut.println(F("ERR: ECL pt# invalid"));
     return;
   }
   
   if (!_isECLowPointRequired(pointNum)) {
-    Serial.print(F("ERR: Pt"));
-    Serial.print(pointNum + 1);
-    Serial.print(F(" not in "));
-    Serial.print((uint8_t)_ecLowMode);
-    Serial.println(F("pt mode"));
+    SerialOut.print(F("ERR: Pt"));
+    SerialOut.print(pointNum + 1);
+    SerialOut.print(F(" not in "));
+    SerialOut.print((uint8_t)_ecLowMode);
+    SerialOut.println(F("pt mode"));
     return;
   }
   
   _ecLowVolts[pointNum] = voltage_mV;
+  _dirty |= DIRTY_EC_LOW;
   
   _ecLowCount = 0;
   for (uint8_t i = 0; i < EC_LOW_CAL_POINTS; i++) {
@@ -665,21 +681,21 @@ void Calibration::forceECLowPoint(uint8_t pointNum, float voltage_mV) {
     }
   }
   
-  Serial.print(F("F-ECL P"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(": Vmv="));
-  Serial.print(voltage_mV, 1);
-  Serial.print(F(" Ref="));
-  Serial.print(_ecLowRef[pointNum], 1);
-  Serial.print(F("uS L"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(":"));
-  Serial.print(_ecLowCount);
-  Serial.print(F("/"));
-  Serial.println(_getRequiredECLowPoints());
+  SerialOut.print(F("F-ECL P"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(": Vmv="));
+  printFixed(SerialOut, voltage_mV, 1);
+  SerialOut.print(F(" Ref="));
+  printFixed(SerialOut, _ecLowRef[pointNum], 1);
+  SerialOut.print(F("uS L"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(":"));
+  SerialOut.print(_ecLowCount);
+  SerialOut.print(F("/"));
+  SerialOut.println(_getRequiredECLowPoints());
   
   if (_ecLowCount == _getRequiredECLowPoints()) {
-    Serial.println(F("ECL: calc..."));
+    SerialOut.println(F("ECL: calc..."));
     _calculateECLowEquation();
   }
 }
@@ -689,32 +705,33 @@ void Calibration::forceECLowPoint(uint8_t pointNum, float voltage_mV) {
  ******************************************************************************/
 void Calibration::forceECHighPoint(uint8_t pointNum, float voltage_mV) {
   if (pointNum >= EC_HIGH_CAL_POINTS) {
-    Serial.println(F("ERR: ECH pt# invalid"));
+    SerialOut.println(F("ERR: ECH pt# invalid"));
     return;
   }
   
   _ecHighVolts[pointNum] = voltage_mV;
+  _dirty |= DIRTY_EC_HIGH;
   
   _ecHighCount = 0;
   for (uint8_t i = 0; i < EC_HIGH_CAL_POINTS; i++) {
     if (_ecHighVolts[i] > 0.0) _ecHighCount++;
   }
   
-  Serial.print(F("F-ECH P"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(": Vmv="));
-  Serial.print(voltage_mV, 1);
-  Serial.print(F(" Ref="));
-  Serial.print(_ecHighRef[pointNum], 1);
-  Serial.print(F("uS H"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(":"));
-  Serial.print(_ecHighCount);
-  Serial.print(F("/"));
-  Serial.println(_getRequiredECHighPoints());
+  SerialOut.print(F("F-ECH P"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(": Vmv="));
+  printFixed(SerialOut, voltage_mV, 1);
+  SerialOut.print(F(" Ref="));
+  printFixed(SerialOut, _ecHighRef[pointNum], 1);
+  SerialOut.print(F("uS H"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(":"));
+  SerialOut.print(_ecHighCount);
+  SerialOut.print(F("/"));
+  SerialOut.println(_getRequiredECHighPoints());
   
   if (_ecHighCount == _getRequiredECHighPoints()) {
-    Serial.println(F("ECH: calc..."));
+    SerialOut.println(F("ECH: calc..."));
     _calculateECHighEquation();
   }
 }
@@ -724,32 +741,33 @@ void Calibration::forceECHighPoint(uint8_t pointNum, float voltage_mV) {
  ******************************************************************************/
 void Calibration::forcepHPoint(uint8_t pointNum, float voltage_mV) {
   if (pointNum >= PH_CAL_POINTS) {
-    Serial.println(F("ERR: pH pt# invalid"));
+    SerialOut.println(F("ERR: pH pt# invalid"));
     return;
   }
   
   _pHVolts[pointNum] = voltage_mV;
+  _dirty |= DIRTY_PH;
   
   _pHCount = 0;
   for (uint8_t i = 0; i < PH_CAL_POINTS; i++) {
     if (_pHVolts[i] > 0.0) _pHCount++;
   }
   
-  Serial.print(F("F-pH P"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(": Vmv="));
-  Serial.print(voltage_mV, 1);
-  Serial.print(F(" Ref="));
-  Serial.print(_pHRef[pointNum], 2);
-  Serial.print(F("pH P"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(":"));
-  Serial.print(_pHCount);
-  Serial.print(F("/"));
-  Serial.println(_getRequiredpHPoints());
+  SerialOut.print(F("F-pH P"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(": Vmv="));
+  printFixed(SerialOut, voltage_mV, 1);
+  SerialOut.print(F(" Ref="));
+  printFixed(SerialOut, _pHRef[pointNum], 2);
+  SerialOut.print(F("pH P"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(":"));
+  SerialOut.print(_pHCount);
+  SerialOut.print(F("/"));
+  SerialOut.println(_getRequiredpHPoints());
   
   if (_pHCount == _getRequiredpHPoints()) {
-    Serial.println(F("pH: calc..."));
+    SerialOut.println(F("pH: calc..."));
     _calculatepHEquation();
   }
 }
@@ -759,32 +777,33 @@ void Calibration::forcepHPoint(uint8_t pointNum, float voltage_mV) {
  ******************************************************************************/
 void Calibration::forceTempPoint(uint8_t pointNum, float voltage_mV) {
   if (pointNum >= TEMP_CAL_POINTS) {
-    Serial.println(F("ERR: Temp pt# invalid"));
+    SerialOut.println(F("ERR: Temp pt# invalid"));
     return;
   }
   
   _tempVolts[pointNum] = voltage_mV;
+  _dirty |= DIRTY_TEMP;
   
   _tempCount = 0;
   for (uint8_t i = 0; i < TEMP_CAL_POINTS; i++) {
     if (_tempVolts[i] > 0.0) _tempCount++;
   }
   
-  Serial.print(F("F-Temp P"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(": Vmv="));
-  Serial.print(voltage_mV, 1);
-  Serial.print(F(" Ref="));
-  Serial.print(_tempRef[pointNum], 1);
-  Serial.print(F("C T"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(":"));
-  Serial.print(_tempCount);
-  Serial.print(F("/"));
-  Serial.println(_getRequiredTempPoints());
+  SerialOut.print(F("F-Temp P"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(": Vmv="));
+  printFixed(SerialOut, voltage_mV, 1);
+  SerialOut.print(F(" Ref="));
+  printFixed(SerialOut, _tempRef[pointNum], 1);
+  SerialOut.print(F("C T"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(":"));
+  SerialOut.print(_tempCount);
+  SerialOut.print(F("/"));
+  SerialOut.println(_getRequiredTempPoints());
   
   if (_tempCount == _getRequiredTempPoints()) {
-    Serial.println(F("Temp: calc..."));
+    SerialOut.println(F("Temp: calc..."));
     _calculateTempEquation();
   }
 }
@@ -794,28 +813,30 @@ void Calibration::forceTempPoint(uint8_t pointNum, float voltage_mV) {
  ******************************************************************************/
 void Calibration::setECLowRef(uint8_t pointNum, float value) {
   if (pointNum >= EC_LOW_CAL_POINTS) {
-    Serial.println(F("ERR: Invalid pt#"));
+    SerialOut.println(F("ERR: Invalid pt#"));
     return;
   }
   _ecLowRef[pointNum] = value;
-  Serial.print(F("ECL P"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(" ref="));
-  Serial.print(value, 1);
-  Serial.println(F("uS"));
+  _dirty |= DIRTY_EC_LOW;
+  SerialOut.print(F("ECL P"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(" ref="));
+  printFixed(SerialOut, value, 1);
+  SerialOut.println(F("uS"));
 }
 
 void Calibration::setECHighRef(uint8_t pointNum, float value) {
   if (pointNum >= EC_HIGH_CAL_POINTS) {
-    Serial.println(F("ERR: Invalid pt#"));
+    SerialOut.println(F("ERR: Invalid pt#"));
     return;
   }
   _ecHighRef[pointNum] = value;
-  Serial.print(F("ECH P"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(" ref="));
-  Serial.print(value, 1);
-  Serial.println(F("uS"));
+  _dirty |= DIRTY_EC_HIGH;
+  SerialOut.print(F("ECH P"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(" ref="));
+  printFixed(SerialOut, value, 1);
+  SerialOut.println(F("uS"));
 }
 
 /*******************************************************************************
@@ -823,15 +844,16 @@ void Calibration::setECHighRef(uint8_t pointNum, float value) {
  ******************************************************************************/
 void Calibration::setpHRef(uint8_t pointNum, float value) {
   if (pointNum >= PH_CAL_POINTS) {
-    Serial.println(F("ERR: Invalid pt#"));
+    SerialOut.println(F("ERR: Invalid pt#"));
     return;
   }
   _pHRef[pointNum] = value;
-  Serial.print(F("pH P"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(" ref="));
-  Serial.print(value, 2);
-  Serial.println(F("pH"));
+  _dirty |= DIRTY_PH;
+  SerialOut.print(F("pH P"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(" ref="));
+  printFixed(SerialOut, value, 2);
+  SerialOut.println(F("pH"));
 }
 
 /*******************************************************************************
@@ -839,15 +861,16 @@ void Calibration::setpHRef(uint8_t pointNum, float value) {
  ******************************************************************************/
 void Calibration::setTempRef(uint8_t pointNum, float value) {
   if (pointNum >= TEMP_CAL_POINTS) {
-    Serial.println(F("ERR: Invalid pt#"));
+    SerialOut.println(F("ERR: Invalid pt#"));
     return;
   }
   _tempRef[pointNum] = value;
-  Serial.print(F("Temp P"));
-  Serial.print(pointNum + 1);
-  Serial.print(F(" ref="));
-  Serial.print(value, 1);
-  Serial.println(F("C"));
+  _dirty |= DIRTY_TEMP;
+  SerialOut.print(F("Temp P"));
+  SerialOut.print(pointNum + 1);
+  SerialOut.print(F(" ref="));
+  printFixed(SerialOut, value, 1);
+  SerialOut.println(F("C"));
 }
 
 /*******************************************************************************
@@ -856,6 +879,7 @@ void Calibration::setTempRef(uint8_t pointNum, float value) {
  * Calculates calibration equation after all points are captured.
  ******************************************************************************/
 void Calibration::_calculateECLowEquation() {
+  PERF_SCOPE(PERF_FIT_EC_LOW);
   uint8_t requiredPoints = _getRequiredECLowPoints();
   
   // Collect only the points required for current mode
@@ -885,20 +909,22 @@ void Calibration::_calculateECLowEquation() {
   
   // Mark as calibrated
   _isECLowCal = true;
+  _dirty |= DIRTY_EC_LOW;
+  _notifyFit(DIRTY_EC_LOW, _ecLowC, _ecLowD, _ecLowR2, _ecLowRMSE);
   
   // Print results
-  Serial.print(F("EC_LOW: C="));
-  Serial.print(_ecLowC, 6);
-  Serial.print(F(" D="));
-  Serial.print(_ecLowD, 2);
-  Serial.print(F(" R2="));
-  Serial.print(_ecLowR2, 4);
-  Serial.print(F(" RMSE="));
-  Serial.println(_ecLowRMSE, 2);
+  SerialOut.print(F("EC_LOW: C="));
+  printFixed(SerialOut, _ecLowC, 6);
+  SerialOut.print(F(" D="));
+  printFixed(SerialOut, _ecLowD, 2);
+  SerialOut.print(F(" R2="));
+  printFixed(SerialOut, _ecLowR2, 4);
+  SerialOut.print(F(" RMSE="));
+  printlnFixed(SerialOut, _ecLowRMSE, 2);
   
   if (_ecLowR2 < MIN_R_SQUARED) {
-    Serial.print(F("WARN: Low R2="));
-    Serial.println(_ecLowR2, 4);
+    SerialOut.print(F("WARN: Low R2="));
+    printlnFixed(SerialOut, _ecLowR2, 4);
   }
 }
 
@@ -906,6 +932,7 @@ void Calibration::_calculateECLowEquation() {
  * EQUATION CALCULATION - EC HIGH RANGE
  ******************************************************************************/
 void Calibration::_calculateECHighEquation() {
+  PERF_SCOPE(PERF_FIT_EC_HIGH);
   // Validate points
   if (!_validatePoints(_ecHighVolts, EC_HIGH_CAL_POINTS, "EC High")) {
     return;
@@ -920,20 +947,22 @@ void Calibration::_calculateECHighEquation() {
   
   // Mark as calibrated
   _isECHighCal = true;
+  _dirty |= DIRTY_EC_HIGH;
+  _notifyFit(DIRTY_EC_HIGH, _ecHighC, _ecHighD, _ecHighR2, _ecHighRMSE);
   
   // Print results
-  Serial.print(F("EC_HIGH: C="));
-  Serial.print(_ecHighC, 6);
-  Serial.print(F(" D="));
-  Serial.print(_ecHighD, 2);
-  Serial.print(F(" R2="));
-  Serial.print(_ecHighR2, 4);
-  Serial.print(F(" RMSE="));
-  Serial.println(_ecHighRMSE, 2);
+  SerialOut.print(F("EC_HIGH: C="));
+  printFixed(SerialOut, _ecHighC, 6);
+  SerialOut.print(F(" D="));
+  printFixed(SerialOut, _ecHighD, 2);
+  SerialOut.print(F(" R2="));
+  printFixed(SerialOut, _ecHighR2, 4);
+  SerialOut.print(F(" RMSE="));
+  printlnFixed(SerialOut, _ecHighRMSE, 2);
   
   if (_ecHighR2 < MIN_R_SQUARED) {
-    Serial.print(F("WARN: Low R2="));
-    Serial.println(_ecHighR2, 4);
+    SerialOut.print(F("WARN: Low R2="));
+    printlnFixed(SerialOut, _ecHighR2, 4);
   }
 }
 
@@ -941,6 +970,7 @@ void Calibration::_calculateECHighEquation() {
  * EQUATION CALCULATION - pH
  ******************************************************************************/
 void Calibration::_calculatepHEquation() {
+  PERF_SCOPE(PERF_FIT_PH);
   // Validate points
   if (!_validatePoints(_pHVolts, PH_CAL_POINTS, "pH")) {
     return;
@@ -955,20 +985,22 @@ void Calibration::_calculatepHEquation() {
   
   // Mark as calibrated
   _ispHCal = true;
+  _dirty |= DIRTY_PH;
+  _notifyFit(DIRTY_PH, _pHC, _pHD, _pHR2, _pHRMSE);
   
   // Print results
-  Serial.print(F("pH: C="));
-  Serial.print(_pHC, 6);
-  Serial.print(F(" D="));
-  Serial.print(_pHD, 2);
-  Serial.print(F(" R2="));
-  Serial.print(_pHR2, 4);
-  Serial.print(F(" RMSE="));
-  Serial.println(_pHRMSE, 3);
+  SerialOut.print(F("pH: C="));
+  printFixed(SerialOut, _pHC, 6);
+  SerialOut.print(F(" D="));
+  printFixed(SerialOut, _pHD, 2);
+  SerialOut.print(F(" R2="));
+  printFixed(SerialOut, _pHR2, 4);
+  SerialOut.print(F(" RMSE="));
+  printlnFixed(SerialOut, _pHRMSE, 3);
   
   if (_pHR2 < MIN_R_SQUARED) {
-    Serial.print(F("WARN: Low R2="));
-    Serial.println(_pHR2, 4);
+    SerialOut.print(F("WARN: Low R2="));
+    printlnFixed(SerialOut, _pHR2, 4);
   }
 }
 
@@ -976,6 +1008,7 @@ void Calibration::_calculatepHEquation() {
  * EQUATION CALCULATION - TEMPERATURE
  ******************************************************************************/
 void Calibration::_calculateTempEquation() {
+  PERF_SCOPE(PERF_FIT_TEMP);
   // Validate points
   if (!_validatePoints(_tempVolts, TEMP_CAL_POINTS, "Temperature")) {
     return;
@@ -990,23 +1023,41 @@ void Calibration::_calculateTempEquation() {
   
   // Mark as calibrated
   _isTempCal = true;
+  _dirty |= DIRTY_TEMP;
+  _notifyFit(DIRTY_TEMP, _tempC, _tempD, _tempR2, _tempRMSE);
   
   // Print results
-  Serial.print(F("TEMP: C="));
-  Serial.print(_tempC, 6);
-  Serial.print(F(" D="));
-  Serial.print(_tempD, 2);
-  Serial.print(F(" R2="));
-  Serial.print(_tempR2, 4);
-  Serial.print(F(" RMSE="));
-  Serial.println(_tempRMSE, 2);
+  SerialOut.print(F("TEMP: C="));
+  printFixed(SerialOut, _tempC, 6);
+  SerialOut.print(F(" D="));
+  printFixed(SerialOut, _tempD, 2);
+  SerialOut.print(F(" R2="));
+  printFixed(SerialOut, _tempR2, 4);
+  SerialOut.print(F(" RMSE="));
+  printlnFixed(SerialOut, _tempRMSE, 2);
   
   if (_tempR2 < MIN_R_SQUARED) {
-    Serial.print(F("WARN: Low R2="));
-    Serial.println(_tempR2, 4);
+    SerialOut.print(F("WARN: Low R2="));
+    printlnFixed(SerialOut, _tempR2, 4);
   }
 }
 
+/*
+ * Hand a new fit to the listener (calibration history)
+ */
+void Calibration::_notifyFit(uint8_t sensor, float C, float D, float R2, float RMSE) {
+  if (_fitListener == NULL) {
+    return;
+  }
+
+  CalibrationEquation eq;
+  eq.C = C;
+  eq.D = D;
+  eq.R2 = R2;
+  eq.RMSE = RMSE;
+  _fitListener(sensor, eq);
+}
+
 /*******************************************************************************
  * CALIBRATED READINGS - EC
  * 
@@ -1018,7 +1069,7 @@ float Calibration::getCalibratedEC() {
   float voltage = _sensor->readVoltage_EC();
   
   // Determine which range to use based on voltage threshold
-  if (voltage < EC_RANGE_THRESHOLD_MV) {
+  if (voltage < _ecRangeThresholdMv) {
     // Use LOW range equation
     if (!_isECLowCal) {
       // Not calibrated - return -1.0 to indicate error
@@ -1102,130 +1153,130 @@ float Calibration::getCalibratedTemperature() {
  * Displays detailed calibration information for all sensors.
  ******************************************************************************/
 void Calibration::showEquations() {
-  Serial.println(F("CALIBRATION EQUATIONS"));
-  Serial.println();
+  SerialOut.println(F("CALIBRATION EQUATIONS"));
+  SerialOut.println();
   
   // === EC LOW RANGE ===
-  Serial.println(F("--- EC LOW RANGE ---"));
+  SerialOut.println(F("--- EC LOW RANGE ---"));
   if (_isECLowCal) {
-    Serial.print(F("Equation: EC = "));
-    Serial.print(_ecLowC, 6);
-    Serial.print(F(" * V_mV + "));
-    Serial.println(_ecLowD, 2);
+    SerialOut.print(F("Equation: EC = "));
+    printFixed(SerialOut, _ecLowC, 6);
+    SerialOut.print(F(" * V_mV + "));
+    printlnFixed(SerialOut, _ecLowD, 2);
     
-    Serial.println(F("Calibration Points:"));
+    SerialOut.println(F("Calibration Points:"));
     for (uint8_t i = 0; i < EC_LOW_CAL_POINTS; i++) {
       if (_isECLowPointRequired(i) && _ecLowVolts[i] > 0.0) {
-        Serial.print(F("  P"));
-        Serial.print(i + 1);
-        Serial.print(F(": "));
-        Serial.print(_ecLowVolts[i], 1);
-        Serial.print(F("mV -> "));
-        Serial.print(_ecLowRef[i], 1);
-        Serial.println(F("uS/cm"));
+        SerialOut.print(F("  P"));
+        SerialOut.print(i + 1);
+        SerialOut.print(F(": "));
+        printFixed(SerialOut, _ecLowVolts[i], 1);
+        SerialOut.print(F("mV -> "));
+        printFixed(SerialOut, _ecLowRef[i], 1);
+        SerialOut.println(F("uS/cm"));
       }
     }
     
-    Serial.print(F("Quality: R2="));
-    Serial.print(_ecLowR2, 4);
-    Serial.print(F(" RMSE="));
-    Serial.print(_ecLowRMSE, 2);
-    Serial.println(F(" uS/cm"));
+    SerialOut.print(F("Quality: R2="));
+    printFixed(SerialOut, _ecLowR2, 4);
+    SerialOut.print(F(" RMSE="));
+    printFixed(SerialOut, _ecLowRMSE, 2);
+    SerialOut.println(F(" uS/cm"));
   } else {
-    Serial.println(F("NOT CALIBRATED"));
+    SerialOut.println(F("NOT CALIBRATED"));
   }
-  Serial.println();
+  SerialOut.println();
   
   // === EC HIGH RANGE ===
-  Serial.println(F("--- EC HIGH RANGE ---"));
+  SerialOut.println(F("--- EC HIGH RANGE ---"));
   if (_isECHighCal) {
-    Serial.print(F("Equation: EC = "));
-    Serial.print(_ecHighC, 6);
-    Serial.print(F(" * V_mV + "));
-    Serial.println(_ecHighD, 2);
+    SerialOut.print(F("Equation: EC = "));
+    printFixed(SerialOut, _ecHighC, 6);
+    SerialOut.print(F(" * V_mV + "));
+    printlnFixed(SerialOut, _ecHighD, 2);
     
-    Serial.println(F("Calibration Points:"));
+    SerialOut.println(F("Calibration Points:"));
     for (uint8_t i = 0; i < EC_HIGH_CAL_POINTS; i++) {
       if (_ecHighVolts[i] > 0.0) {
-        Serial.print(F("  P"));
-        Serial.print(i + 1);
-        Serial.print(F(": "));
-        Serial.print(_ecHighVolts[i], 1);
-        Serial.print(F("mV -> "));
-        Serial.print(_ecHighRef[i], 1);
-        Serial.println(F("uS/cm"));
+        SerialOut.print(F("  P"));
+        SerialOut.print(i + 1);
+        SerialOut.print(F(": "));
+        printFixed(SerialOut, _ecHighVolts[i], 1);
+        SerialOut.print(F("mV -> "));
+        printFixed(SerialOut, _ecHighRef[i], 1);
+        SerialOut.println(F("uS/cm"));
       }
     }
     
-    Serial.print(F("Quality: R2="));
-    Serial.print(_ecHighR2, 4);
-    Serial.print(F(" RMSE="));
-    Serial.print(_ecHighRMSE, 2);
-    Serial.println(F(" uS/cm"));
+    SerialOut.print(F("Quality: R2="));
+    printFixed(SerialOut, _ecHighR2, 4);
+    SerialOut.print(F(" RMSE="));
+    printFixed(SerialOut, _ecHighRMSE, 2);
+    SerialOut.println(F(" uS/cm"));
   } else {
-    Serial.println(F("NOT CALIBRATED"));
+    SerialOut.println(F("NOT CALIBRATED"));
   }
-  Serial.println();
+  SerialOut.println();
   
   // === pH ===
-  Serial.println(F("--- pH ---"));
+  SerialOut.println(F("--- pH ---"));
   if (_ispHCal) {
-    Serial.print(F("Equation: pH = "));
-    Serial.print(_pHC, 6);
-    Serial.print(F(" * V_mV + "));
-    Serial.println(_pHD, 2);
+    SerialOut.print(F("Equation: pH = "));
+    printFixed(SerialOut, _pHC, 6);
+    SerialOut.print(F(" * V_mV + "));
+    printlnFixed(SerialOut, _pHD, 2);
     
-    Serial.println(F("Calibration Points:"));
+    SerialOut.println(F("Calibration Points:"));
     for (uint8_t i = 0; i < PH_CAL_POINTS; i++) {
       if (_pHVolts[i] > 0.0) {
-        Serial.print(F("  P"));
-        Serial.print(i + 1);
-        Serial.print(F(": "));
-        Serial.print(_pHVolts[i], 1);
-        Serial.print(F("mV -> "));
-        Serial.print(_pHRef[i], 2);
-        Serial.println(F("pH"));
+        SerialOut.print(F("  P"));
+        SerialOut.print(i + 1);
+        SerialOut.print(F(": "));
+        printFixed(SerialOut, _pHVolts[i], 1);
+        SerialOut.print(F("mV -> "));
+        printFixed(SerialOut, _pHRef[i], 2);
+        SerialOut.println(F("pH"));
       }
     }
     
-    Serial.print(F("Quality: R2="));
-    Serial.print(_pHR2, 4);
-    Serial.print(F(" RMSE="));
-    Serial.print(_pHRMSE, 3);
-    Serial.println(F(" pH"));
+    SerialOut.print(F("Quality: R2="));
+    printFixed(SerialOut, _pHR2, 4);
+    SerialOut.print(F(" RMSE="));
+    printFixed(SerialOut, _pHRMSE, 3);
+    SerialOut.println(F(" pH"));
   } else {
-    Serial.println(F("NOT CALIBRATED"));
+    SerialOut.println(F("NOT CALIBRATED"));
   }
-  Serial.println();
+  SerialOut.println();
   
   // === TEMPERATURE ===
-  Serial.println(F("--- TEMPERATURE ---"));
+  SerialOut.println(F("--- TEMPERATURE ---"));
   if (_isTempCal) {
-    Serial.print(F("Equation: T = "));
-    Serial.print(_tempC, 6);
-    Serial.print(F(" * V_mV + "));
-    Serial.println(_tempD, 2);
+    SerialOut.print(F("Equation: T = "));
+    printFixed(SerialOut, _tempC, 6);
+    SerialOut.print(F(" * V_mV + "));
+    printlnFixed(SerialOut, _tempD, 2);
     
-    Serial.println(F("Calibration Points:"));
+    SerialOut.println(F("Calibration Points:"));
     for (uint8_t i = 0; i < TEMP_CAL_POINTS; i++) {
       if (_tempVolts[i] > 0.0) {
-        Serial.print(F("  P"));
-        Serial.print(i + 1);
-        Serial.print(F(": "));
-        Serial.print(_tempVolts[i], 1);
-        Serial.print(F("mV -> "));
-        Serial.print(_tempRef[i], 1);
-        Serial.println(F("C"));
+        SerialOut.print(F("  P"));
+        SerialOut.print(i + 1);
+        SerialOut.print(F(": "));
+        printFixed(SerialOut, _tempVolts[i], 1);
+        SerialOut.print(F("mV -> "));
+        printFixed(SerialOut, _tempRef[i], 1);
+        SerialOut.println(F("C"));
       }
     }
     
-    Serial.print(F("Quality: R2="));
-    Serial.print(_tempR2, 4);
-    Serial.print(F(" RMSE="));
-    Serial.print(_tempRMSE, 2);
-    Serial.println(F(" C"));
+    SerialOut.print(F("Quality: R2="));
+    printFixed(SerialOut, _tempR2, 4);
+    SerialOut.print(F(" RMSE="));
+    printFixed(SerialOut, _tempRMSE, 2);
+    SerialOut.println(F(" C"));
   } else {
-    Serial.println(F("NOT CALIBRATED"));
+    SerialOut.println(F("NOT CALIBRATED"));
   }
 }
 
@@ -1235,70 +1286,70 @@ void Calibration::showEquations() {
  * Displays summary of calibration status for all sensors.
  ******************************************************************************/
 void Calibration::showStatus() {
-  Serial.println(F("CALIBRATION STATUS"));
+  SerialOut.println(F("CALIBRATION STATUS"));
   
   // EC Low Range
-  Serial.print(F("EC Low Range:  "));
+  SerialOut.print(F("EC Low Range:  "));
   if (_isECLowCal) {
-    Serial.print(F("CALIBRATED ("));
-    Serial.print(_getRequiredECLowPoints());
-    Serial.print(F(" points, R2="));
-    Serial.print(_ecLowR2, 4);
-    Serial.println(F(")"));
+    SerialOut.print(F("CALIBRATED ("));
+    SerialOut.print(_getRequiredECLowPoints());
+    SerialOut.print(F(" points, R2="));
+    printFixed(SerialOut, _ecLowR2, 4);
+    SerialOut.println(F(")"));
   } else {
-    Serial.print(F("NOT CALIBRATED ("));
-    Serial.print(_ecLowCount);
-    Serial.print(F("/"));
-    Serial.print(_getRequiredECLowPoints());
-    Serial.println(F(" points captured)"));
+    SerialOut.print(F("NOT CALIBRATED ("));
+    SerialOut.print(_ecLowCount);
+    SerialOut.print(F("/"));
+    SerialOut.print(_getRequiredECLowPoints());
+    SerialOut.println(F(" points captured)"));
   }
   
   // EC High Range
-  Serial.print(F("EC High Range: "));
+  SerialOut.print(F("EC High Range: "));
   if (_isECHighCal) {
-    Serial.print(F("CALIBRATED ("));
-    Serial.print(_getRequiredECHighPoints());
-    Serial.print(F(" points, R2="));
-    Serial.print(_ecHighR2, 4);
-    Serial.println(F(")"));
+    SerialOut.print(F("CALIBRATED ("));
+    SerialOut.print(_getRequiredECHighPoints());
+    SerialOut.print(F(" points, R2="));
+    printFixed(SerialOut, _ecHighR2, 4);
+    SerialOut.println(F(")"));
   } else {
-    Serial.print(F("NOT CALIBRATED ("));
-    Serial.print(_ecHighCount);
-    Serial.print(F("/"));
-    Serial.print(_getRequiredECHighPoints());
-    Serial.println(F(" points captured)"));
+    SerialOut.print(F("NOT CALIBRATED ("));
+    SerialOut.print(_ecHighCount);
+    SerialOut.print(F("/"));
+    SerialOut.print(_getRequiredECHighPoints());
+    SerialOut.println(F(" points captured)"));
   }
   
   // pH
-  Serial.print(F("pH:            "));
+  SerialOut.print(F("pH:            "));
   if (_ispHCal) {
-    Serial.print(F("CALIBRATED ("));
-    Serial.print(_getRequiredpHPoints());
-    Serial.print(F(" points, R2="));
-    Serial.print(_pHR2, 4);
-    Serial.println(F(")"));
+    SerialOut.print(F("CALIBRATED ("));
+    SerialOut.print(_getRequiredpHPoints());
+    SerialOut.print(F(" points, R2="));
+    printFixed(SerialOut, _pHR2, 4);
+    SerialOut.println(F(")"));
   } else {
-    Serial.print(F("NOT CALIBRATED ("));
-    Serial.print(_pHCount);
-    Serial.print(F("/"));
-    Serial.print(_getRequiredpHPoints());
-    Serial.println(F(" points captured)"));
+    SerialOut.print(F("NOT CALIBRATED ("));
+    SerialOut.print(_pHCount);
+    SerialOut.print(F("/"));
+    SerialOut.print(_getRequiredpHPoints());
+    SerialOut.println(F(" points captured)"));
   }
   
   // Temperature
-  Serial.print(F("Temperature:   "));
+  SerialOut.print(F("Temperature:   "));
   if (_isTempCal) {
-    Serial.print(F("CALIBRATED ("));
-    Serial.print(_getRequiredTempPoints());
-    Serial.print(F(" points, R2="));
-    Serial.print(_tempR2, 4);
-    Serial.println(F(")"));
+    SerialOut.print(F("CALIBRATED ("));
+    SerialOut.print(_getRequiredTempPoints());
+    SerialOut.print(F(" points, R2="));
+    printFixed(SerialOut, _tempR2, 4);
+    SerialOut.println(F(")"));
   } else {
-    Serial.print(F("NOT CALIBRATED ("));
-    Serial.print(_tempCount);
-    Serial.print(F("/"));
-    Serial.print(_getRequiredTempPoints());
-    Serial.println(F(" points captured)"));
+    SerialOut.print(F("NOT CALIBRATED ("));
+    SerialOut.print(_tempCount);
+    SerialOut.print(F("/"));
+    SerialOut.print(_getRequiredTempPoints());
+    SerialOut.println(F(" points captured)"));
   }
 }
 
@@ -1308,51 +1359,51 @@ void Calibration::showStatus() {
  * Displays quality metrics (R² and RMSE) for all calibrated sensors.
  ******************************************************************************/
 void Calibration::showQuality() {
-  Serial.println(F("CALIBRATION QUALITY METRICS"));
+  SerialOut.println(F("CALIBRATION QUALITY METRICS"));
   
-  Serial.print(F("EC Low:  R2="));
+  SerialOut.print(F("EC Low:  R2="));
   if (_isECLowCal) {
-    Serial.print(_ecLowR2, 4);
-    Serial.print(F(" RMSE="));
-    Serial.print(_ecLowRMSE, 2);
-    Serial.println(F(" uS/cm"));
+    printFixed(SerialOut, _ecLowR2, 4);
+    SerialOut.print(F(" RMSE="));
+    printFixed(SerialOut, _ecLowRMSE, 2);
+    SerialOut.println(F(" uS/cm"));
   } else {
-    Serial.println(F("N/A"));
+    SerialOut.println(F("N/A"));
   }
   
-  Serial.print(F("EC High: R2="));
+  SerialOut.print(F("EC High: R2="));
   if (_isECHighCal) {
-    Serial.print(_ecHighR2, 4);
-    Serial.print(F(" RMSE="));
-    Serial.print(_ecHighRMSE, 2);
-    Serial.println(F(" uS/cm"));
+    printFixed(SerialOut, _ecHighR2, 4);
+    SerialOut.print(F(" RMSE="));
+    printFixed(SerialOut, _ecHighRMSE, 2);
+    SerialOut.println(F(" uS/cm"));
   } else {
-    Serial.println(F("N/A"));
+    SerialOut.println(F("N/A"));
   }
   
-  Serial.print(F("pH:      R2="));
+  SerialOut.print(F("pH:      R2="));
   if (_ispHCal) {
-    Serial.print(_pHR2, 4);
-    Serial.print(F(" RMSE="));
-    Serial.print(_pHRMSE, 3);
-    Serial.println(F(" pH"));
+    printFixed(SerialOut, _pHR2, 4);
+    SerialOut.print(F(" RMSE="));
+    printFixed(SerialOut, _pHRMSE, 3);
+    SerialOut.println(F(" pH"));
   } else {
-    Serial.println(F("N/A"));
+    SerialOut.println(F("N/A"));
   }
   
-  Serial.print(F("Temp:    R2="));
+  SerialOut.print(F("Temp:    R2="));
   if (_isTempCal) {
-    Serial.print(_tempR2, 4);
-    Serial.print(F(" RMSE="));
-    Serial.print(_tempRMSE, 2);
-    Serial.println(F(" C"));
+    printFixed(SerialOut, _tempR2, 4);
+    SerialOut.print(F(" RMSE="));
+    printFixed(SerialOut, _tempRMSE, 2);
+    SerialOut.println(F(" C"));
   } else {
-    Serial.println(F("N/A"));
+    SerialOut.println(F("N/A"));
   }
   
-  Serial.println();
-  Serial.println(F("R2 > 0.95 is good, closer to 1.0 is better"));
-  Serial.println(F("RMSE: Lower is better (average error magnitude)"));
+  SerialOut.println();
+  SerialOut.println(F("R2 > 0.95 is good, closer to 1.0 is better"));
+  SerialOut.println(F("RMSE: Lower is better (average error magnitude)"));
 }
 
 /*******************************************************************************
@@ -1429,6 +1480,7 @@ void Calibration::setECLowEquation(float C, float D, float R2, float RMSE) {
   _ecLowD = D;
   _ecLowR2 = R2;
   _ecLowRMSE = RMSE;
+  _dirty |= DIRTY_EC_LOW;
 }
 
 void Calibration::setECHighEquation(float C, float D, float R2, float RMSE) {
@@ -1436,6 +1488,7 @@ void Calibration::setECHighEquation(float C, float D, float R2, float RMSE) {
   _ecHighD = D;
   _ecHighR2 = R2;
   _ecHighRMSE = RMSE;
+  _dirty |= DIRTY_EC_HIGH;
 }
 
 // Set pH calibration equation
@@ -1444,6 +1497,7 @@ void Calibration::setpHEquation(float C, float D, float R2, float RMSE) {
   _pHD = D;
   _pHR2 = R2;
   _pHRMSE = RMSE;
+  _dirty |= DIRTY_PH;
 }
 
 // Set Temperature calibration equation
@@ -1452,6 +1506,7 @@ void Calibration::setTempEquation(float C, float D, float R2, float RMSE) {
   _tempD = D;
   _tempR2 = R2;
   _tempRMSE = RMSE;
+  _dirty |= DIRTY_TEMP;
 }
 
 // Set EC calibration data
@@ -1460,6 +1515,7 @@ void Calibration::setECLowData(const float volts[], const float refs[]) {
     _ecLowVolts[i] = volts[i];
     _ecLowRef[i] = refs[i];
   }
+  _dirty |= DIRTY_EC_LOW;
 }
 
 void Calibration::setECHighData(const float volts[], const float refs[]) {
@@ -1467,6 +1523,7 @@ void Calibration::setECHighData(const float volts[], const float refs[]) {
     _ecHighVolts[i] = volts[i];
     _ecHighRef[i] = refs[i];
   }
+  _dirty |= DIRTY_EC_HIGH;
 }
 
 // Set pH calibration data
@@ -1475,6 +1532,7 @@ void Calibration::setpHData(const float volts[], const float refs[]) {
     _pHVolts[i] = volts[i];
     _pHRef[i] = refs[i];
   }
+  _dirty |= DIRTY_PH;
 }
 
 // Set Temperature calibration data
@@ -1483,6 +1541,7 @@ void Calibration::setTempData(const float volts[], const float refs[]) {
     _tempVolts[i] = volts[i];
     _tempRef[i] = refs[i];
   }
+  _dirty |= DIRTY_TEMP;
 }
 
 // Set calibration flags (used when loading from EEPROM)
@@ -1492,6 +1551,7 @@ void Calibration::setCalibrationFlags(bool ecLowCal, bool ecHighCal,
   _isECHighCal = ecHighCal;
   _ispHCal = pHCal;
   _isTempCal = tempCal;
+  _dirty = DIRTY_ALL;
   
   // Update point counts based on flags
   if (_isECLowCal) {
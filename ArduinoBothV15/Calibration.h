@@ -47,6 +47,25 @@ struct CalibrationEquation {
   float RMSE;
 };
 
+/*******************************************************************************
+ * DIRTY FLAGS
+ * 
+ * One bit per sensor section of the stored image (mode, equation, voltages,
+ * references, calibrated flag). Set by every change to that section,
+ * cleared when the state matches EEPROM (after load or save).
+ ******************************************************************************/
+const uint8_t DIRTY_EC_LOW  = 0x01;
+const uint8_t DIRTY_EC_HIGH = 0x02;
+const uint8_t DIRTY_PH      = 0x04;
+const uint8_t DIRTY_TEMP    = 0x08;
+const uint8_t DIRTY_ALL     = 0x0F;
+
+/*
+ * Called after every successful fit with the sensor's DIRTY_* bit and the
+ * new equation (used for the EEPROM calibration history).
+ */
+typedef void (*FitListener)(uint8_t sensor, const CalibrationEquation& eq);
+
 /*******************************************************************************
  * CLASS: Calibration
  * 
@@ -125,6 +144,14 @@ public:
   float getCalibratedpH();
   float getCalibratedTemperature();
   
+  /*
+   * EC range switch point (default EC_RANGE_THRESHOLD_MV): below it the
+   * low range equation is used. Only host tools change it, to compare
+   * candidate thresholds on recorded data.
+   */
+  void setECRangeThreshold(float millivolts) { _ecRangeThresholdMv = millivolts; }
+  float getECRangeThreshold() const { return _ecRangeThresholdMv; }
+  
   /***************************************************************************
    * STATUS & INFORMATION DISPLAY
    ***************************************************************************/
@@ -200,6 +227,16 @@ public:
   void setTempData(const float volts[], const float refs[]);
   
   void setCalibrationFlags(bool ecLowCal, bool ecHighCal, bool pHCal, bool tempCal);
+  
+  // Sections changed since the last EEPROM load/save (DIRTY_* bits)
+  uint8_t getDirtyMask() const { return _dirty; }
+  void markClean() { _dirty = 0; }
+  
+  // Notified after each successful fit (NULL = nobody)
+  void setFitListener(FitListener listener) { _fitListener = listener; }
+
+  // tools/firmware_bench times the core math below
+  friend class FirmwareBench;
 
 private:
   /***************************************************************************
@@ -226,6 +263,7 @@ private:
   bool _isECHighCal;
   uint8_t _ecLowCount;
   uint8_t _ecHighCount;
+  float _ecRangeThresholdMv;
   
   // === pH CALIBRATION DATA ===
   pHMode _pHMode;
@@ -251,6 +289,10 @@ private:
   bool _isTempCal;
   uint8_t _tempCount;
   
+  // === PERSISTENCE STATE ===
+  uint8_t _dirty;  // DIRTY_* bits
+  FitListener _fitListener;
+  
   /***************************************************************************
    * PRIVATE METHODS - Calibration Calculation
    ***************************************************************************/
@@ -258,6 +300,7 @@ private:
   void _calculateECHighEquation();
   void _calculatepHEquation();
   void _calculateTempEquation();
+  void _notifyFit(uint8_t sensor, float C, float D, float R2, float RMSE);
   
   /***************************************************************************
    * PRIVATE METHODS - Core Math (shared by all sensors)
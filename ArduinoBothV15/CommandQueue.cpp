@@ -0,0 +1,173 @@
+/*******************************************************************************
+ * COMMANDQUEUE.CPP - Non-Blocking Serial Command Reception Implementation
+ *
+ * Replaces Serial.readStringUntil('\n'), which waits up to the stream
+ * timeout (1 s) whenever a line arrives in more than one piece.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "CommandQueue.h"
+#include "Hal.h"
+#include "OutputQueue.h"
+
+/*******************************************************************************
+ * CONSTRUCTOR
+ ******************************************************************************/
+CommandQueue::CommandQueue()
+  : _head(0),
+    _tail(0),
+    _count(0),
+    _rxLen(0),
+    _rxOverflow(false),
+    _dropped(0)
+{
+}
+
+/*******************************************************************************
+ * RECEPTION
+ ******************************************************************************/
+void CommandQueue::poll() {
+  // Keep reading while the queue is full: left in the 64-byte
+  // HardwareSerial buffer, a longer burst would be cut off by the RX
+  // interrupt without a reply. Lines that find no slot are answered with
+  // "ERROR: Busy" instead (see _endLine).
+  while (halSerialAvailable() > 0) {
+    char c = (char)halSerialRead();
+
+    if (c == '\n') {
+      _endLine();
+      continue;
+    }
+
+    if (_rxOverflow) {
+      continue;
+    }
+
+    if (_rxLen < CMD_LINE_MAX - 1) {
+      _rx[_rxLen++] = c;
+    } else {
+      _rxOverflow = true;
+    }
+  }
+}
+
+/*******************************************************************************
+ * RETRIEVAL
+ ******************************************************************************/
+bool CommandQueue::pop(String& command, char tag[CMD_TAG_MAX], unsigned long& receivedUs) {
+  if (_count == 0) {
+    return false;
+  }
+
+  command = _lines[_tail];
+  receivedUs = _receivedUs[_tail];
+  _tail = (_tail + 1) % CMD_QUEUE_DEPTH;
+  _count--;
+
+  command.trim();
+  command.toUpperCase();
+
+  // Optional "#<id> " request prefix
+  uint8_t prefix = _parseTag(command.c_str(), tag);
+  if (prefix > 0) {
+    command.remove(0, prefix);
+    command.trim();
+  }
+
+  return true;
+}
+
+/*******************************************************************************
+ * PRIVATE HELPER METHODS
+ ******************************************************************************/
+
+void CommandQueue::_endLine() {
+  bool overflow = _rxOverflow;
+  uint8_t len = _rxLen;
+  _rxLen = 0;
+  _rxOverflow = false;
+
+  // Strip surrounding whitespace (CR, spaces, tabs) and skip lines that
+  // had nothing else, as the blocking reader did
+  uint8_t start = 0;
+  while (start < len && isSpace(_rx[start])) {
+    start++;
+  }
+  while (len > start && isSpace(_rx[len - 1])) {
+    len--;
+  }
+  len -= start;
+  if (len == 0 && !overflow) {
+    return;
+  }
+
+  if (overflow) {
+    _reject(_rx + start, len, F("ERROR: Command too long"));
+    return;
+  }
+  if (_count == CMD_QUEUE_DEPTH) {
+    _reject(_rx + start, len, F("ERROR: Busy"));
+    return;
+  }
+
+  memcpy(_lines[_head], _rx + start, len);
+  _lines[_head][len] = '\0';
+  _receivedUs[_head] = halMicros();
+  _head = (_head + 1) % CMD_QUEUE_DEPTH;
+  _count++;
+}
+
+/*
+ * Answer a line that is not queued right away, tagged like any other
+ * response ("#<id> ERROR: ..." then "#<id> ERR") if it has a request id,
+ * so a pipelining host gets its terminator instead of a timeout.
+ */
+void CommandQueue::_reject(char* line, uint8_t len, const __FlashStringHelper* message) {
+  _dropped++;
+  line[len] = '\0';
+
+  char tag[CMD_TAG_MAX];
+  if (_parseTag(line, tag) == 0) {
+    SerialOut.println(message);
+    return;
+  }
+
+  SerialOut.beginResponse(tag);
+  SerialOut.println(message);
+  SerialOut.endResponse();
+  SerialOut.print('#');
+  SerialOut.print(tag);
+  SerialOut.println(F(" ERR"));
+}
+
+/*
+ * Split off a "#<id>" prefix (1 to CMD_TAG_MAX - 1 digits, then
+ * whitespace or the end). Returns the prefix length, 0 if there is none
+ * (tag is then "").
+ */
+uint8_t CommandQueue::_parseTag(const char* line, char tag[CMD_TAG_MAX]) {
+  tag[0] = '\0';
+  if (line[0] != '#') {
+    return 0;
+  }
+
+  uint8_t len = 0;
+  while (len < CMD_TAG_MAX - 1 && isDigit(line[len + 1])) {
+    len++;
+  }
+
+  char next = line[len + 1];
+  if (len == 0 || !(isSpace(next) || next == '\0')) {
+    return 0;
+  }
+
+  memcpy(tag, line + 1, len);
+  tag[len] = '\0';
+  return len + 1;
+}
+
+/*******************************************************************************
+ * END OF COMMANDQUEUE IMPLEMENTATION
+ ******************************************************************************/
@@ -0,0 +1,91 @@
+/*******************************************************************************
+ * COMMANDQUEUE.H - Non-Blocking Serial Command Reception
+ *
+ * Purpose:
+ *   Assembles incoming serial bytes into command lines without blocking
+ *   and keeps up to CMD_QUEUE_DEPTH complete commands waiting, so a host
+ *   can pipeline several commands in one RX burst. A line that arrives
+ *   while the queue is full is not kept; it is answered "ERROR: Busy".
+ *
+ * Request IDs:
+ *   A line may start with "#<id> " (id = 1-5 decimal digits). The id is
+ *   split off here; loop() tags every response line with it and closes
+ *   the response with "#<id> OK" or "#<id> ERR". Lines without a prefix
+ *   behave exactly as before.
+ *
+ * Pipelining limit:
+ *   A host may have at most CMD_QUEUE_DEPTH tagged commands unanswered
+ *   (sent, "#<id> OK/ERR" not yet received). Lines beyond that, and lines
+ *   longer than CMD_LINE_MAX, get "#<id> ERROR: Busy" / "#<id> ERROR:
+ *   Command too long" and "#<id> ERR" right away; resend them later.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef COMMANDQUEUE_H
+#define COMMANDQUEUE_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+const uint8_t CMD_TAG_MAX          = 6;   // 5 digits + '\0'
+
+/*******************************************************************************
+ * CLASS: CommandQueue
+ ******************************************************************************/
+class CommandQueue {
+public:
+  /***************************************************************************
+   * CONSTRUCTOR
+   ***************************************************************************/
+  CommandQueue();
+
+  /***************************************************************************
+   * RECEPTION
+   *
+   * poll() moves every byte Serial has buffered into the line assembler.
+   * Never waits for more bytes.
+   ***************************************************************************/
+  void poll();
+
+  /***************************************************************************
+   * RETRIEVAL
+   *
+   * Pops the oldest command. command is trimmed and upper-cased; tag holds
+   * the request id ("" if the line had none); receivedUs is micros() when
+   * its line ending was read. Returns false if empty.
+   * A malformed "#..." prefix is left in command (and reported as unknown).
+   ***************************************************************************/
+  bool pop(String& command, char tag[CMD_TAG_MAX], unsigned long& receivedUs);
+
+  /***************************************************************************
+   * STATUS
+   ***************************************************************************/
+  uint8_t count() const { return _count; }
+  uint16_t getDroppedCount() const { return _dropped; }
+
+private:
+  /***************************************************************************
+   * PRIVATE MEMBER VARIABLES
+   ***************************************************************************/
+  char     _lines[CMD_QUEUE_DEPTH][CMD_LINE_MAX];
+  unsigned long _receivedUs[CMD_QUEUE_DEPTH];   // micros() per line
+  uint8_t  _head;        // Next slot to fill
+  uint8_t  _tail;        // Oldest complete line
+  uint8_t  _count;       // Complete lines waiting
+
+  char     _rx[CMD_LINE_MAX];  // Line being assembled
+  uint8_t  _rxLen;
+  bool     _rxOverflow;  // Current line too long, discard until '\n'
+  uint16_t _dropped;     // Lines rejected (too long or queue full)
+
+  /***************************************************************************
+   * PRIVATE HELPER METHODS
+   ***************************************************************************/
+  void _endLine();
+  void _reject(char* line, uint8_t len, const __FlashStringHelper* message);
+  static uint8_t _parseTag(const char* line, char tag[CMD_TAG_MAX]);
+};
+
+#endif // COMMANDQUEUE_H
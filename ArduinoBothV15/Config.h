@@ -20,6 +20,7 @@
 #define CONFIG_H
 
 #include <Arduino.h>
+#include <stddef.h>   // offsetof() for the EEPROM image layout
 
 /*******************************************************************************
  * HARDWARE PIN ASSIGNMENTS
@@ -226,10 +227,14 @@ const float MIN_R_SQUARED          = 0.95;    // Minimum acceptable R²
  * SENSOR READING PARAMETERS
  ******************************************************************************/
 
-const uint8_t EC_SAMPLE_COUNT      = 3;       // EC samples to average
-const uint8_t TEMP_SAMPLE_COUNT    = 3;       // Temperature samples to average
-const uint8_t PH_SAMPLE_COUNT      = 10;      // pH samples to average
-const uint8_t PH_SAMPLE_DELAY_MS   = 20;      // Delay between pH samples (ms)
+const uint8_t EC_SAMPLE_COUNT      = 3;       // EC samples per filter window
+const uint8_t TEMP_SAMPLE_COUNT    = 3;       // Temperature samples per window
+const uint8_t PH_SAMPLE_COUNT      = 10;      // pH samples per filter window
+const uint8_t PH_SAMPLE_DELAY_MS   = 20;      // Spacing of pH samples (ms)
+
+// Sensor/ADC settling time after power-up. begin() does not wait for it;
+// a reading requested earlier waits only for the part still left.
+const uint8_t SENSOR_SETTLE_MS     = 100;
 
 /*******************************************************************************
  * OPTIONAL FILTERING
@@ -237,6 +242,27 @@ const uint8_t PH_SAMPLE_DELAY_MS   = 20;      // Delay between pH samples (ms)
 
 const float FILTER_ALPHA           = 0.3;     // Exponential filter coefficient
 
+/*******************************************************************************
+ * TASK SCHEDULER (see Scheduler.h)
+ * 
+ * Sampling runs in the background at fixed periods. A filter window is
+ * FILTER_PERIOD_MS long and collects about EC/TEMP/PH_SAMPLE_COUNT samples;
+ * the exponential filter is applied once per window.
+ ******************************************************************************/
+
+const uint16_t FILTER_PERIOD_MS      = PH_SAMPLE_COUNT * PH_SAMPLE_DELAY_MS;  // 200 ms
+const uint16_t EC_SAMPLE_PERIOD_MS   = FILTER_PERIOD_MS / EC_SAMPLE_COUNT;    // 66 ms
+const uint16_t TEMP_SAMPLE_PERIOD_MS = FILTER_PERIOD_MS / TEMP_SAMPLE_COUNT;  // 66 ms
+const uint16_t PH_SAMPLE_PERIOD_MS   = PH_SAMPLE_DELAY_MS;                    // 20 ms
+const uint16_t HOUSEKEEPING_PERIOD_MS = 100;  // Confirmation timeout etc.
+const uint8_t  SCHEDULER_MAX_TASKS   = 8;    // Run state kept in RAM per task
+
+// Deadlines: serial RX/TX must be serviced this often (at 115200 baud the
+// 64-byte RX buffer fills in 5.5 ms); a command that runs longer than
+// COMMAND_DEADLINE_MS counts as an overrun
+const uint16_t IO_DEADLINE_MS        = 5;
+const uint16_t COMMAND_DEADLINE_MS   = 100;
+
 /*******************************************************************************
  * EEPROM STORAGE STRUCTURE
  * 
@@ -245,12 +271,12 @@ const float FILTER_ALPHA           = 0.3;     // Exponential filter coefficient
  * Offset  Size  Content
  * ------  ----  -------------------------------------------------------
  *      0     2  Magic number (0xEC57)
- *      2     1  Version (1)
+ *      2     1  Version (1 or 2, below)
  *      3     1  EC low calibration mode (3, 4, or 5)
  *      4     1  EC high calibration mode (2)
  *      5     1  pH calibration mode (3)
  *      6     1  Temperature calibration mode (3)
- *      7     1  (padding)
+ *      7     1  Calibration profile (version 1: padding, 0xFF)
  *      
  *      8     4  EC Low equation C (float)
  *     12     4  EC Low equation D (float)
@@ -293,52 +319,193 @@ const float FILTER_ALPHA           = 0.3;     // Exponential filter coefficient
  ******************************************************************************/
 
 const uint16_t EEPROM_MAGIC        = 0xEC57;  // Magic number
-const uint8_t  EEPROM_VERSION      = 1;       // Storage format version
-
-// EEPROM address offsets
-const uint16_t ADDR_MAGIC          = 0;
-const uint16_t ADDR_VERSION        = 2;
-const uint16_t ADDR_EC_LOW_MODE    = 3;
-const uint16_t ADDR_EC_HIGH_MODE   = 4;
-const uint16_t ADDR_PH_MODE        = 5;
-const uint16_t ADDR_TEMP_MODE      = 6;
-
-const uint16_t ADDR_EC_LOW_EQ_C    = 8;
-const uint16_t ADDR_EC_LOW_EQ_D    = 12;
-const uint16_t ADDR_EC_LOW_EQ_R2   = 16;
-const uint16_t ADDR_EC_LOW_EQ_RMSE = 20;
-
-const uint16_t ADDR_EC_HIGH_EQ_C   = 24;
-const uint16_t ADDR_EC_HIGH_EQ_D   = 28;
-const uint16_t ADDR_EC_HIGH_EQ_R2  = 32;
-const uint16_t ADDR_EC_HIGH_EQ_RMSE= 36;
-
-const uint16_t ADDR_PH_EQ_C        = 40;
-const uint16_t ADDR_PH_EQ_D        = 44;
-const uint16_t ADDR_PH_EQ_R2       = 48;
-const uint16_t ADDR_PH_EQ_RMSE     = 52;
-
-const uint16_t ADDR_TEMP_EQ_C      = 56;
-const uint16_t ADDR_TEMP_EQ_D      = 60;
-const uint16_t ADDR_TEMP_EQ_R2     = 64;
-const uint16_t ADDR_TEMP_EQ_RMSE   = 68;
-
-const uint16_t ADDR_EC_LOW_VOLTS   = 72;
-const uint16_t ADDR_EC_HIGH_VOLTS  = 92;
-const uint16_t ADDR_PH_VOLTS       = 100;
-const uint16_t ADDR_TEMP_VOLTS     = 112;
-
-const uint16_t ADDR_EC_LOW_REFS    = 124;
-const uint16_t ADDR_EC_HIGH_REFS   = 144;
-const uint16_t ADDR_PH_REFS        = 152;
-const uint16_t ADDR_TEMP_REFS      = 164;
-
-const uint16_t ADDR_EC_LOW_CAL_FLAG = 176;
-const uint16_t ADDR_EC_HIGH_CAL_FLAG= 177;
-const uint16_t ADDR_PH_CAL_FLAG    = 178;
-const uint16_t ADDR_TEMP_CAL_FLAG  = 179;
-
-const uint16_t ADDR_CHECKSUM       = 180;
+const uint8_t  EEPROM_VERSION      = 2;       // Storage format version
+const uint8_t  EEPROM_VERSION_FIXED = 1;      // Pre-journal image at address 0
+
+/*
+ * Version history (EEPROMManager::_upgradeImage converts older images on
+ * load and writes them back, so field calibrations survive updates):
+ * 
+ *   1  Image fixed at address 0, padding byte left unwritten
+ *   2  Image stored in the journal below, padding byte is the
+ *      calibration profile (a version 1 image becomes profile 0)
+ * 
+ * Journal records are always written in the current version; only the
+ * image at address 0 can be older.
+ * 
+ * Sample EEPROM dumps of every version: tools/eeprom_corpus/
+ */
+
+/*
+ * The layout above as one packed struct. Load/save move it as a single
+ * block and the CRC16 is computed over it in RAM. Field order IS the
+ * on-EEPROM format: append new fields before checksum and bump
+ * EEPROM_VERSION, never reorder.
+ */
+struct CalEquationRecord {
+  float C;
+  float D;
+  float R2;
+  float RMSE;
+} __attribute__((packed));
+
+struct CalImage {
+  // === HEADER ===
+  uint16_t magic;                           // EEPROM_MAGIC
+  uint8_t  version;                         // EEPROM_VERSION
+  uint8_t  ecLowMode;                       // ECLowMode
+  uint8_t  ecHighMode;                      // ECHighMode
+  uint8_t  pHMode;                          // pHMode
+  uint8_t  tempMode;                        // TempMode
+  uint8_t  profile;                         // Calibration profile
+  
+  // === EQUATIONS ===
+  CalEquationRecord ecLowEq;
+  CalEquationRecord ecHighEq;
+  CalEquationRecord pHEq;
+  CalEquationRecord tempEq;
+  
+  // === CALIBRATION DATA ===
+  float ecLowVolts[EC_LOW_CAL_POINTS];
+  float ecHighVolts[EC_HIGH_CAL_POINTS];
+  float pHVolts[PH_CAL_POINTS];
+  float tempVolts[TEMP_CAL_POINTS];
+  
+  float ecLowRefs[EC_LOW_CAL_POINTS];
+  float ecHighRefs[EC_HIGH_CAL_POINTS];
+  float pHRefs[PH_CAL_POINTS];
+  float tempRefs[TEMP_CAL_POINTS];
+  
+  // === FLAGS (1 = calibrated) ===
+  uint8_t  ecLowCal;
+  uint8_t  ecHighCal;
+  uint8_t  pHCal;
+  uint8_t  tempCal;
+  
+  // === CHECKSUM ===
+  uint16_t checksum;                        // CRC16 over all bytes above
+} __attribute__((packed));
+
+const uint16_t CAL_IMAGE_SIZE      = sizeof(CalImage);               // 182 bytes
+const uint16_t CAL_IMAGE_CRC_SPAN  = offsetof(CalImage, checksum);   // 180 bytes
+
+static_assert(sizeof(CalImage) == 182, "CalImage must match the EEPROM layout");
+
+/*******************************************************************************
+ * CALIBRATION JOURNAL (wear leveling)
+ * 
+ * The image above is not kept at a fixed address. The start of the EEPROM
+ * is divided into JOURNAL_SLOTS records; each SAVE appends a new record in
+ * the slot after the newest one, so writes rotate over all slots instead
+ * of hammering the same 182 bytes.
+ * 
+ * Record layout:
+ * 
+ * Offset  Size  Content
+ * ------  ----  -------------------------------------------------------
+ *      0     2  Sequence number / generation (+1 per save, wraps)
+ *      2     2  Seal: CRC16 over sequence number + image CRC16
+ *      4   182  Calibration image (layout above)
+ * 
+ * A save never touches the newest intact record (of any profile, see
+ * below). The image is written to another slot, read back, and only then
+ * committed by writing the header, so a save interrupted by a power loss
+ * leaves the previous record as the newest valid one (A/B commit with N
+ * slots).
+ * Load scans only the headers to find the newest sealed record, then
+ * falls back to older records if its image fails validation.
+ * 
+ * Images written before the journal existed (version 1, fixed at
+ * address 0) are upgraded and moved into the journal on the first boot.
+ ******************************************************************************/
+
+const uint16_t EEPROM_SIZE         = 1024;    // ATmega328P
+
+struct JournalRecord {
+  uint16_t sequence;                        // Generation, +1 per save
+  uint16_t seal;                            // CRC16(sequence, image.checksum)
+  CalImage image;
+} __attribute__((packed));
+
+const uint16_t JOURNAL_RECORD_SIZE = sizeof(JournalRecord);          // 186 bytes
+const uint8_t  JOURNAL_SLOTS       = 4;                              // 744 bytes
+const uint8_t  JOURNAL_NO_SLOT     = 0xFF;
+
+/*******************************************************************************
+ * CALIBRATION PROFILES (probe sets)
+ * 
+ * Probes rotate between tanks, so the journal holds one complete
+ * calibration per probe set. Every record is tagged with its profile
+ * (CalImage.profile); load() picks the newest valid record of the active
+ * profile, and a save never overwrites the newest valid record of ANY
+ * profile. One slot must stay free to write into, so the journal holds
+ * at most JOURNAL_SLOTS - 1 profiles.
+ * 
+ * Endurance trade-off: the pinned records take slots out of the rotation.
+ * With one profile in use, saves rotate over all 4 slots; with three,
+ * only 2 slots take every save (plain A/B), so each of their cells wears
+ * twice as fast. At 100,000 write cycles per cell that still allows about
+ * 200,000 saves of the busy profile (about 50 years at 10 saves a day),
+ * but it is no longer wear leveling in the 4-slot sense. Fewer profiles
+ * or a larger EEPROM share would spread the wear again.
+ * 
+ * The profile table in the last bytes of the EEPROM names the profiles
+ * and remembers which one is active across power cycles:
+ * 
+ * Offset  Size  Content
+ * ------  ----  -------------------------------------------------------
+ *      0     1  Active profile
+ *      1    24  Probe ID of each profile (8 chars, NUL-padded)
+ *     25     2  CRC16 over bytes 0-24
+ * 
+ * An invalid table (first boot, older firmware) means profile 0 active
+ * and no probe IDs.
+ ******************************************************************************/
+
+const uint8_t  PROFILE_COUNT       = JOURNAL_SLOTS - 1;              // 3
+const uint8_t  PROFILE_ANY         = 0xFF;   // Journal scan: any profile
+const uint8_t  PROBE_ID_LEN        = 8;      // Characters, no terminator stored
+
+struct ProfileTable {
+  uint8_t  active;                          // Active profile
+  char     probeId[PROFILE_COUNT][PROBE_ID_LEN];
+  uint16_t crc;                             // CRC16 over all bytes above
+} __attribute__((packed));
+
+const uint16_t PROFILE_TABLE_START = EEPROM_SIZE - sizeof(ProfileTable);  // 997
+
+/*******************************************************************************
+ * CALIBRATION HISTORY (between the journal and the profile table)
+ * 
+ * Every successful fit appends one record to a circular log, so slope and
+ * offset drift across recalibrations can be read back with CALHIST. The
+ * record with the highest fit number is the newest; appending overwrites
+ * the oldest. The CRC16 is written last, so a torn append is ignored.
+ * 
+ * Record layout:
+ * 
+ * Offset  Size  Content
+ * ------  ----  -------------------------------------------------------
+ *      0     2  Fit number (+1 per record, wraps)
+ *      2     1  Bits 0-3: sensor (DIRTY_* bit: 1 EC low, 2 EC high,
+ *               4 pH, 8 temp); bits 4-7: calibration profile
+ *      3    16  C, D, R², RMSE (floats)
+ *     19     2  CRC16 over bytes 0-18
+ * 
+ * There is no clock on the board; the fit number orders the records.
+ ******************************************************************************/
+
+struct HistoryRecord {
+  uint16_t fit;                             // Fit number, +1 per record
+  uint8_t  sensor;                          // DIRTY_* bit | profile << 4
+  CalEquationRecord eq;
+  uint16_t crc;                             // CRC16 over all bytes above
+} __attribute__((packed));
+
+const uint16_t HISTORY_START       = JOURNAL_SLOTS * JOURNAL_RECORD_SIZE;  // 744
+const uint16_t HISTORY_RECORD_SIZE = sizeof(HistoryRecord);                // 21 bytes
+const uint8_t  HISTORY_SLOTS       = (PROFILE_TABLE_START - HISTORY_START) / HISTORY_RECORD_SIZE;  // 12
+const uint8_t  HISTORY_NO_RECORD   = 0xFF;
 
 /*******************************************************************************
  * SERIAL COMMUNICATION SETTINGS
@@ -346,6 +513,104 @@ const uint16_t ADDR_CHECKSUM       = 180;
 
 const uint32_t SERIAL_BAUD_RATE    = 115200;
 
+// Native-USB boards only (USBCON): wait this long for the host to open
+// the port. On the Uno the USB bridge buffers, so setup() never waits.
+const unsigned long SERIAL_WAIT_MS = 3000;
+
+// Bounded TX queue in front of the 64-byte HardwareSerial buffer.
+// Drained from loop() so long responses don't stall sampling. Together
+// with the serial buffer it holds a 192-byte response; longer ones
+// (CALDUMP, EEDUMP, DIAG) wait for the UART in between.
+const uint16_t OUTPUT_QUEUE_SIZE   = 128;
+
+// Command reception: longest accepted line (incl. "#<id> " prefix) and
+// how many complete commands may wait while the current one executes.
+// This is also the pipelining limit: a host may have at most this many
+// tagged commands unanswered; further lines get "ERROR: Busy" and ERR
+// (see CommandQueue.h). Each slot costs CMD_LINE_MAX + 4 bytes of RAM.
+const uint8_t  CMD_LINE_MAX        = 64;
+const uint8_t  CMD_QUEUE_DEPTH     = 2;
+
+// CALDUMP/CALLOAD: image bytes per "CALLOAD <offset> <hex>" line
+const uint8_t  CAL_CHUNK_BYTES     = 16;
+
+// EEDUMP/EELOAD: raw EEPROM bytes per "EELOAD <offset> <hex> <crc>" line
+// (a tagged line with the largest offset must fit in CMD_LINE_MAX)
+const uint8_t  EE_CHUNK_BYTES      = 16;
+
+// Window for repeating a destructive command (CLEAR) to confirm it
+const unsigned long CONFIRM_TIMEOUT_MS = 5000;
+
+/*******************************************************************************
+ * PERFORMANCE PROBES (see Perf.h)
+ * 
+ * 1 = time the hot paths (sensor reads, fits, command dispatch, EEPROM
+ * save/load, serial TX) and report them with PERF; costs 16 bytes of RAM
+ * per probe. 0 = the probes compile to nothing.
+ ******************************************************************************/
+
+#define PERF_PROBES 1
+
+/*******************************************************************************
+ * MEMORY MONITOR (see MemoryMonitor.h)
+ ******************************************************************************/
+
+// Fill byte painted between heap and stack at boot; any other value in
+// that gap means the stack reached it
+const uint8_t  STACK_CANARY        = 0xA5;
+
+// MEM/DIAG flag the headroom below this (String temporaries need room)
+const uint16_t MEM_LOW_HEADROOM    = 128;
+
+/*******************************************************************************
+ * LATENCY HISTOGRAMS (see LatencyHistogram.h)
+ * 
+ * Bucket 0 holds everything below LATENCY_FIRST_US; each further bucket
+ * doubles the bound, the last one is open-ended:
+ *   <32, <64, <128, ... <524288 us (0.5 s), >=0.5 s
+ ******************************************************************************/
+
+const uint8_t  LATENCY_BUCKETS     = 16;
+const uint8_t  LATENCY_FIRST_SHIFT = 5;      // LATENCY_FIRST_US = 1 << 5
+const uint32_t LATENCY_FIRST_US    = 1UL << LATENCY_FIRST_SHIFT;
+
+/*******************************************************************************
+ * LOW POWER (see LowPower.h)
+ * 
+ * LOW_POWER_IDLE: sleep in Idle mode whenever no task is due and serial
+ * is quiet (woken by the next timer tick or a received byte).
+ * ADC_NOISE_SLEEP: take background samples in ADC Noise Reduction sleep,
+ * which also keeps CPU switching noise out of the conversion.
+ ******************************************************************************/
+
+#define LOW_POWER_IDLE  1
+#define ADC_NOISE_SLEEP 1
+
+// One conversion: 13 ADC clocks at F_CPU / 128 (Arduino's prescaler).
+// Timer0 stops during ADC sleep; millis() is advanced by this much.
+const uint16_t ADC_CONVERSION_US   = 13UL * 128 * 1000000UL / F_CPU;
+
+// Typical ATmega328P supply current at 5 V / 16 MHz (datasheet), used
+// for the POWER estimate. MCU only: the Uno's USB bridge, regulator and
+// LED draw another ~30 mA.
+const uint16_t POWER_ACTIVE_UA     = 9200;
+const uint16_t POWER_IDLE_UA       = 3000;
+const uint16_t POWER_ADC_SLEEP_UA  = 1800;
+
+/*******************************************************************************
+ * WATCHDOG (see Watchdog.h)
+ * 
+ * The scheduler feeds the watchdog after every pass. Loops that can run
+ * longer than the timeout feed it themselves: a journal save takes about
+ * 0.63 s per 186-byte record attempt (four failed read-backs would be
+ * about 2.5 s), so EEPROMManager feeds it per record written and per
+ * record checked. That covers SAVE retries, the boot migration and the
+ * reload at the end of EELOAD. The timeout must cover one record.
+ ******************************************************************************/
+
+#define WATCHDOG_ENABLED 1
+#define WATCHDOG_TIMEOUT WDTO_2S   // avr/wdt.h constant
+
 /*******************************************************************************
  * COMMAND STRINGS - EC CALIBRATION
  ******************************************************************************/
@@ -7,10 +7,12 @@
  *   checking using CRC16 checksums.
  * 
  * Key Features:
- *   - Saves complete calibration state (182 bytes)
+ *   - Saves complete calibration state (182-byte packed CalImage)
+ *   - Wear-leveled journal: each save goes to the next of JOURNAL_SLOTS
  *   - CRC16 integrity checking
  *   - Magic number validation
- *   - Version compatibility
+ *   - Version migration: older images are upgraded on load
+ *   - Calibration profiles: one calibration per probe set in the journal
  *   - Graceful handling of corrupt/empty EEPROM
  * 
  * Author: System Rewrite v1.0 - Complete Edition
@@ -18,12 +20,23 @@
  ******************************************************************************/
 
 #include "EEPROMManager.h"
+#include "CRC16.h"
+#include "FastFormat.h"
+#include "OutputQueue.h"
+#include "Perf.h"
+#include "Watchdog.h"
 
 /*******************************************************************************
  * CONSTRUCTOR
  ******************************************************************************/
-EEPROMManager::EEPROMManager() {
-  // No initialization needed - EEPROM object is global
+EEPROMManager::EEPROMManager()
+  : _activeSlot(JOURNAL_NO_SLOT),
+    _sequence(0),
+    _profile(0),
+    _validity(VALIDITY_UNKNOWN),
+    _journalKnown(false)
+{
+  // EEPROM object is global; journal position is found by load()/save()
 }
 
 /*******************************************************************************
@@ -32,138 +45,67 @@ EEPROMManager::EEPROMManager() {
  * Saves complete calibration state for ALL sensors to EEPROM.
  * 
  * Process:
- *   1. Write magic number and version
- *   2. Write calibration modes
- *   3. Write all equations (EC low/high, pH, Temperature)
- *   4. Write all voltages and references
- *   5. Write calibration flags
- *   6. Calculate and write CRC16 checksum
+ *   1. Build the image in RAM (header, equations, data, flags)
+ *   2. Pick the journal slot after the newest sealed record, never a
+ *      slot holding the newest intact record of a profile
+ *   3. Write the image into that slot, skipping cells that already hold
+ *      the right value (each real write costs ~3.3 ms and one wear cycle);
+ *      the CRC16 is accumulated from the same bytes and written last
+ *   4. Read the slot back and compare with the RAM image; on a mismatch
+ *      (worn cell) move on to the next slot
+ *   5. Commit by writing sequence number (generation) + seal last
+ * 
+ * Skipped entirely when Calibration reports no dirty sections since the
+ * last load/save. A new record must be complete, so clean sections are
+ * copied forward too; they only cost writes where the target slot's older
+ * record differs.
+ * 
+ * Until step 5 completes the previous record is still the newest valid
+ * one, so a power loss at any point falls back to the previous
+ * calibration instead of leaving the EEPROM corrupt.
  * 
  * Returns: true if successful, false on error
  ******************************************************************************/
 bool EEPROMManager::save(Calibration& cal) {
-  Serial.println(F("Saving calibration to EEPROM..."));
+  PERF_SCOPE(PERF_EEPROM_SAVE);
   
-  uint16_t addr = 0;  // Current write address
+  // === NOTHING CHANGED? ===
+  // Only trusted if the current state came from (or went to) the journal
+  uint8_t dirty = cal.getDirtyMask();
+  if (dirty == 0 && _activeSlot != JOURNAL_NO_SLOT) {
+    SerialOut.println(F("EEPROM: No changes since last load/save"));
+    _printSlot();
+    return true;
+  }
   
-  // === HEADER ===
-  // Write magic number (validates this is our data)
-  _writeUint16(ADDR_MAGIC, EEPROM_MAGIC);
-  
-  // Write version (for future compatibility)
-  _writeUint8(ADDR_VERSION, EEPROM_VERSION);
-  
-  // Write calibration modes
-  _writeUint8(ADDR_EC_LOW_MODE, (uint8_t)cal.getECLowMode());
-  _writeUint8(ADDR_EC_HIGH_MODE, (uint8_t)cal.getECHighMode());
-  _writeUint8(ADDR_PH_MODE, (uint8_t)cal.getpHMode());
-  _writeUint8(ADDR_TEMP_MODE, (uint8_t)cal.getTempMode());
-  
-  // === EC LOW RANGE EQUATION ===
-  float C, D, R2, RMSE;
-  cal.getECLowEquation(C, D, R2, RMSE);
-  _writeFloat(ADDR_EC_LOW_EQ_C, C);
-  _writeFloat(ADDR_EC_LOW_EQ_D, D);
-  _writeFloat(ADDR_EC_LOW_EQ_R2, R2);
-  _writeFloat(ADDR_EC_LOW_EQ_RMSE, RMSE);
-  
-  // === EC HIGH RANGE EQUATION ===
-  cal.getECHighEquation(C, D, R2, RMSE);
-  _writeFloat(ADDR_EC_HIGH_EQ_C, C);
-  _writeFloat(ADDR_EC_HIGH_EQ_D, D);
-  _writeFloat(ADDR_EC_HIGH_EQ_R2, R2);
-  _writeFloat(ADDR_EC_HIGH_EQ_RMSE, RMSE);
-  
-  // === pH EQUATION ===
-  cal.getpHEquation(C, D, R2, RMSE);
-  _writeFloat(ADDR_PH_EQ_C, C);
-  _writeFloat(ADDR_PH_EQ_D, D);
-  _writeFloat(ADDR_PH_EQ_R2, R2);
-  _writeFloat(ADDR_PH_EQ_RMSE, RMSE);
-  
-  // === TEMPERATURE EQUATION ===
-  cal.getTempEquation(C, D, R2, RMSE);
-  _writeFloat(ADDR_TEMP_EQ_C, C);
-  _writeFloat(ADDR_TEMP_EQ_D, D);
-  _writeFloat(ADDR_TEMP_EQ_R2, R2);
-  _writeFloat(ADDR_TEMP_EQ_RMSE, RMSE);
+  SerialOut.println(F("Saving calibration to EEPROM..."));
+  _printDirty(dirty);
   
-  // === CALIBRATION DATA (voltages and references) ===
+  CalImage image;
+  _buildImage(cal, image);
   
-  // EC Low Range data
-  float volts[EC_LOW_CAL_POINTS];
-  float refs[EC_LOW_CAL_POINTS];
-  cal.getECLowData(volts, refs);
-  addr = ADDR_EC_LOW_VOLTS;
-  for (uint8_t i = 0; i < EC_LOW_CAL_POINTS; i++) {
-    _writeFloat(addr, volts[i]);
-    addr += sizeof(float);
-  }
-  addr = ADDR_EC_LOW_REFS;
-  for (uint8_t i = 0; i < EC_LOW_CAL_POINTS; i++) {
-    _writeFloat(addr, refs[i]);
-    addr += sizeof(float);
-  }
-  
-  // EC High Range data
-  float voltsHigh[EC_HIGH_CAL_POINTS];
-  float refsHigh[EC_HIGH_CAL_POINTS];
-  cal.getECHighData(voltsHigh, refsHigh);
-  addr = ADDR_EC_HIGH_VOLTS;
-  for (uint8_t i = 0; i < EC_HIGH_CAL_POINTS; i++) {
-    _writeFloat(addr, voltsHigh[i]);
-    addr += sizeof(float);
-  }
-  addr = ADDR_EC_HIGH_REFS;
-  for (uint8_t i = 0; i < EC_HIGH_CAL_POINTS; i++) {
-    _writeFloat(addr, refsHigh[i]);
-    addr += sizeof(float);
-  }
-  
-  // pH data
-  float voltspH[PH_CAL_POINTS];
-  float refspH[PH_CAL_POINTS];
-  cal.getpHData(voltspH, refspH);
-  addr = ADDR_PH_VOLTS;
-  for (uint8_t i = 0; i < PH_CAL_POINTS; i++) {
-    _writeFloat(addr, voltspH[i]);
-    addr += sizeof(float);
-  }
-  addr = ADDR_PH_REFS;
-  for (uint8_t i = 0; i < PH_CAL_POINTS; i++) {
-    _writeFloat(addr, refspH[i]);
-    addr += sizeof(float);
-  }
-  
-  // Temperature data
-  float voltsTemp[TEMP_CAL_POINTS];
-  float refsTemp[TEMP_CAL_POINTS];
-  cal.getTempData(voltsTemp, refsTemp);
-  addr = ADDR_TEMP_VOLTS;
-  for (uint8_t i = 0; i < TEMP_CAL_POINTS; i++) {
-    _writeFloat(addr, voltsTemp[i]);
-    addr += sizeof(float);
-  }
-  addr = ADDR_TEMP_REFS;
-  for (uint8_t i = 0; i < TEMP_CAL_POINTS; i++) {
-    _writeFloat(addr, refsTemp[i]);
-    addr += sizeof(float);
+  unsigned long startTime = halMillis();
+  uint16_t written = 0;
+  
+  if (!_commit(image, written)) {
+    SerialOut.println(F("ERROR: No slot accepted the image, previous record kept"));
+    _validity = VALIDITY_UNKNOWN;
+    return false;
   }
   
-  // === CALIBRATION FLAGS ===
-  _writeUint8(ADDR_EC_LOW_CAL_FLAG, cal.isECLowCalibrated() ? 1 : 0);
-  _writeUint8(ADDR_EC_HIGH_CAL_FLAG, cal.isECHighCalibrated() ? 1 : 0);
-  _writeUint8(ADDR_PH_CAL_FLAG, cal.ispHCalibrated() ? 1 : 0);
-  _writeUint8(ADDR_TEMP_CAL_FLAG, cal.isTempCalibrated() ? 1 : 0);
+  unsigned long elapsed = halMillis() - startTime;
   
-  // === CALCULATE AND WRITE CHECKSUM ===
-  // Calculate CRC16 over all data except checksum itself
-  uint16_t checksum = _calculateCRC16(ADDR_MAGIC, ADDR_CHECKSUM - 1);
-  _writeUint16(ADDR_CHECKSUM, checksum);
+  cal.markClean();
   
-  Serial.println(F("EEPROM: Save complete"));
-  Serial.print(F("Checksum: 0x"));
-  Serial.println(checksum, HEX);
+  SerialOut.println(F("EEPROM: Save complete"));
+  SerialOut.print(F("Checksum: 0x"));
+  SerialOut.println(image.checksum, HEX);
+  SerialOut.print(F("Wrote "));
+  SerialOut.print(written);
+  SerialOut.print(F(" bytes in "));
+  SerialOut.print(elapsed);
+  SerialOut.println(F(" ms"));
+  _printSlot();
   
   return true;
 }
@@ -174,246 +116,897 @@ bool EEPROMManager::save(Calibration& cal) {
  * Loads and validates calibration state for ALL sensors from EEPROM.
  * 
  * Process:
- *   1. Verify magic number
- *   2. Verify version
- *   3. Verify CRC16 checksum
- *   4. Load all data into Calibration object
+ *   1. Read the active profile from the profile table, then scan journal
+ *      headers for that profile's newest sealed record
+ *   2. Verify its magic number, version, CRC16 and modes
+ *   3. If rejected, retry with the next older record
+ *   4. No journal records at all: try a pre-journal (version 1) image at
+ *      address 0 (it belongs to profile 0)
+ *   5. Load all data into Calibration object
+ *   6. Pre-journal image: upgrade it and append it to the journal right
+ *      away, so the migration happens once, on this boot
+ * 
+ * The same scan fills the newest-slot cache of the other profiles, so
+ * later saves do not have to CRC the journal again.
  * 
  * Returns: true if successful, false if EEPROM is empty/corrupt
  ******************************************************************************/
 bool EEPROMManager::load(Calibration& cal) {
-  Serial.println(F("Loading calibration from EEPROM..."));
+  return _load(cal) == LOAD_OK;
+}
+
+/*
+ * load() with the reason for a failure; cal is untouched unless LOAD_OK
+ */
+EEPROMManager::LoadResult EEPROMManager::_load(Calibration& cal) {
+  PERF_SCOPE(PERF_EEPROM_LOAD);
+  
+  SerialOut.println(F("Loading calibration from EEPROM..."));
+  
+  _activeSlot = JOURNAL_NO_SLOT;
+  _sequence = 0;
+  _validity = VALIDITY_UNKNOWN;
+  
+  ProfileTable table;
+  _readTable(table);
+  _profile = table.active;
+  
+  CalImage image;
+  uint8_t rejected = 0;  // Bit per slot that failed validation
+  uint8_t slot;
+  uint16_t sequence;
+  
+  // === JOURNAL RECORDS, NEWEST FIRST ===
+  while (_findNewest(rejected, _profile, slot, sequence)) {
+    halNvGet(_slotAddress(slot) + offsetof(JournalRecord, image), image);
+    
+    if (_validateImage(image, EEPROM_VERSION, true)) {
+      uint16_t checksum = image.checksum;
+      _activeSlot = slot;
+      _sequence = sequence;
+      _validity = VALIDITY_VALID;
+      _scanJournal(_profile, slot);
+      _loadImage(image, cal);
+      
+      SerialOut.println(F("EEPROM: Load complete"));
+      SerialOut.print(F("Checksum verified: 0x"));
+      SerialOut.println(checksum, HEX);
+      _printSlot();
+      return LOAD_OK;
+    }
+    
+    rejected |= (1 << slot);
+    SerialOut.println(F("WARN: Record rejected, trying older record"));
+  }
+  
+  _scanJournal(_profile, JOURNAL_NO_SLOT);
+  
+  if (rejected != 0) {
+    SerialOut.print(F("ERROR: No intact record of profile "));
+    SerialOut.println(_profile);
+    return LOAD_CORRUPT;
+  }
+  
+  if (_profile != 0 || _findNewest(0, PROFILE_ANY, slot, sequence)) {
+    SerialOut.print(F("INFO: Profile "));
+    SerialOut.print(_profile);
+    SerialOut.println(F(" has no saved calibration"));
+    return LOAD_EMPTY;
+  }
+  
+  // === PRE-JOURNAL IMAGE AT ADDRESS 0 ===
+  halNvGet(0, image);
+  
+  if (image.magic != EEPROM_MAGIC) {
+    SerialOut.println(F("INFO: EEPROM empty (first boot)"));
+    return LOAD_EMPTY;
+  }
+  
+  if (!_validateImage(image, EEPROM_VERSION_FIXED, true)) {
+    return LOAD_CORRUPT;
+  }
+  
+  uint16_t checksum = image.checksum;
+  _validity = VALIDITY_VALID;
+  _loadImage(image, cal);
+  
+  SerialOut.println(F("EEPROM: Load complete (pre-journal image)"));
+  SerialOut.print(F("Checksum verified: 0x"));
+  SerialOut.println(checksum, HEX);
+  if (_activeSlot != JOURNAL_NO_SLOT) {
+    _printSlot();
+  }
+  return LOAD_OK;
+}
+
+/*******************************************************************************
+ * CALIBRATION IMAGE EXPORT / IMPORT
+ * 
+ * The image is byte-identical to what save() puts in EEPROM (CalImage in
+ * Config.h), including magic, version and CRC16. CALDUMP/CALLOAD move it
+ * over serial so a host can sync or clone a unit in one transfer.
+ ******************************************************************************/
+
+/*
+ * Build the complete image for the current calibration state.
+ * Returns the CRC16 stored in image.checksum.
+ */
+uint16_t EEPROMManager::exportImage(const Calibration& cal, CalImage& image) {
+  _buildImage(cal, image);
+  image.checksum = crc16Update(CRC16_INIT, (const uint8_t*)&image, CAL_IMAGE_CRC_SPAN);
+  return image.checksum;
+}
+
+/*
+ * Validate an image (magic, version, CRC, modes) and load it into cal.
+ * Returns false and leaves cal untouched if the image is rejected.
+ */
+bool EEPROMManager::importImage(const CalImage& image, Calibration& cal) {
+  if (!_validateImage(image, EEPROM_VERSION, true)) {
+    return false;
+  }
+  
+  _applyImage(image, cal);
+  return true;
+}
+
+/*******************************************************************************
+ * RAW EEPROM ACCESS
+ * 
+ * Used by EEDUMP/EELOAD to move the whole EEPROM (journal, history and
+ * free space) as one image. No layout knowledge here: load() validates
+ * whatever was written.
+ ******************************************************************************/
+
+void EEPROMManager::readRaw(uint16_t address, uint8_t data[], uint8_t length) {
+  for (uint8_t i = 0; i < length; i++) {
+    data[i] = halNvRead(address + i);
+  }
+}
+
+/*
+ * Returns: false if a cell does not read back as written
+ */
+bool EEPROMManager::writeRaw(uint16_t address, const uint8_t data[], uint8_t length) {
+  _activeSlot = JOURNAL_NO_SLOT;
+  _sequence = 0;
+  _validity = VALIDITY_UNKNOWN;
+  _journalKnown = false;
+  
+  _writeBytes(address, data, length, NULL);
+  
+  for (uint8_t i = 0; i < length; i++) {
+    if (halNvRead(address + i) != data[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*******************************************************************************
+ * VERIFY EEPROM INTEGRITY
+ * 
+ * Checks if EEPROM contains valid calibration data without loading it.
+ * Useful for diagnostics.
+ * 
+ * A successful load() or save() already proved the answer, so it is
+ * cached; the EEPROM is only scanned after a raw write or a failed
+ * load/save.
+ * 
+ * Returns: true if EEPROM has valid data
+ ******************************************************************************/
+bool EEPROMManager::verify() {
+  if (_validity != VALIDITY_UNKNOWN) {
+    return _validity == VALIDITY_VALID;
+  }
   
+  uint8_t slot;
+  uint16_t sequence;
+  bool valid = _findNewestValid(PROFILE_ANY, slot, sequence) ||
+               // Pre-journal image (only meaningful if no record was ever sealed)
+               (!_findNewest(0, PROFILE_ANY, slot, sequence) &&
+                _verifyAt(0, EEPROM_VERSION_FIXED));
+  
+  _validity = valid ? VALIDITY_VALID : VALIDITY_INVALID;
+  return valid;
+}
+
+/*******************************************************************************
+ * CALIBRATION PROFILES
+ * 
+ * Each profile is the newest valid journal record tagged with its number,
+ * so switching is just a load of another record: nothing is re-fitted and
+ * nothing is written except the active profile number in the table.
+ * Unsaved changes are discarded, as with LOAD.
+ ******************************************************************************/
+
+/*
+ * Returns: LOAD_OK, or why nothing was loaded (cal untouched)
+ */
+EEPROMManager::LoadResult EEPROMManager::selectProfile(uint8_t profile, Calibration& cal) {
+  // Records but none intact: stay on the current profile, whose
+  // calibration is still in RAM and must keep being saved under it
+  uint8_t slot;
+  uint16_t sequence;
+  if (_findNewest(0, profile, slot, sequence) &&
+      !_findNewestValid(profile, slot, sequence)) {
+    SerialOut.print(F("ERROR: No intact record of profile "));
+    SerialOut.println(profile);
+    return LOAD_CORRUPT;
+  }
+  
+  ProfileTable table;
+  _readTable(table);
+  
+  if (table.active != profile) {
+    table.active = profile;
+    _writeTable(table);
+  }
+  
+  return _load(cal);
+}
+
+/*
+ * Probe ID of profile as a C string ("" if none was set).
+ */
+void EEPROMManager::getProbeId(uint8_t profile, char id[]) {
+  ProfileTable table;
+  _readTable(table);
+  
+  memcpy(id, table.probeId[profile], PROBE_ID_LEN);
+  id[PROBE_ID_LEN] = '\0';
+}
+
+/*
+ * Tag the active profile with id (at most PROBE_ID_LEN characters).
+ * Returns: false if the table does not read back as written
+ */
+bool EEPROMManager::setProbeId(const char id[]) {
+  ProfileTable table;
+  _readTable(table);
+  table.active = _profile;
+  
+  memset(table.probeId[_profile], 0, PROBE_ID_LEN);
+  strncpy(table.probeId[_profile], id, PROBE_ID_LEN);
+  _writeTable(table);
+  
+  ProfileTable check;
+  return _readTable(check) && memcmp(&check, &table, sizeof(table)) == 0;
+}
+
+/*
+ * Format (quality of each profile's newest saved record; fields of
+ * uncalibrated sensors and empty profiles are left blank):
+ *   PROFILES <count>
+ *   PROFILE,ACTIVE,PROBE,SEQ,ECL_R2,ECL_RMSE,ECH_R2,ECH_RMSE,PH_R2,PH_RMSE,TEMP_R2,TEMP_RMSE
+ *   0,*,TANK-A,12,0.9990,1.234,1.0000,0.000,0.9961,0.071,0.9966,0.350
+ *   1,,SPARE,9,0.9985,2.010,,,0.9990,0.040,,
+ *   2,,,,,,,,,,,
+ *   PROFILES END
+ */
+void EEPROMManager::printProfiles() {
+  ProfileTable table;
+  _readTable(table);
+  
+  if (!_journalKnown) {
+    _scanJournal(PROFILE_ANY, JOURNAL_NO_SLOT);
+  }
+  
+  SerialOut.print(F("PROFILES "));
+  SerialOut.println(PROFILE_COUNT);
+  SerialOut.println(F("PROFILE,ACTIVE,PROBE,SEQ,ECL_R2,ECL_RMSE,ECH_R2,ECH_RMSE,"
+                      "PH_R2,PH_RMSE,TEMP_R2,TEMP_RMSE"));
+  
+  for (uint8_t profile = 0; profile < PROFILE_COUNT; profile++) {
+    _printProfileRow(profile, table);
+  }
+  
+  SerialOut.println(F("PROFILES END"));
+}
+
+/*******************************************************************************
+ * PRIVATE METHODS - IMAGE BUILD, VALIDATION AND APPLY
+ ******************************************************************************/
+
+/*
+ * Fill everything except the CRC16 (left 0) from the calibration state.
+ * Equations and data go through locals: the getters take float&/float[]
+ * and members of a packed struct cannot be bound to those.
+ */
+void EEPROMManager::_buildImage(const Calibration& cal, CalImage& image) {
+  memset(&image, 0, sizeof(image));
+  
+  // === HEADER ===
+  image.magic = EEPROM_MAGIC;
+  image.version = EEPROM_VERSION;
+  image.profile = _profile;
+  
+  image.ecLowMode = (uint8_t)cal.getECLowMode();
+  image.ecHighMode = (uint8_t)cal.getECHighMode();
+  image.pHMode = (uint8_t)cal.getpHMode();
+  image.tempMode = (uint8_t)cal.getTempMode();
+  
+  // === EQUATIONS ===
+  CalibrationEquation eq;
+  cal.getECLowEquation(eq.C, eq.D, eq.R2, eq.RMSE);
+  image.ecLowEq = _equationRecord(eq);
+  
+  cal.getECHighEquation(eq.C, eq.D, eq.R2, eq.RMSE);
+  image.ecHighEq = _equationRecord(eq);
+  
+  cal.getpHEquation(eq.C, eq.D, eq.R2, eq.RMSE);
+  image.pHEq = _equationRecord(eq);
+  
+  cal.getTempEquation(eq.C, eq.D, eq.R2, eq.RMSE);
+  image.tempEq = _equationRecord(eq);
+  
+  // === CALIBRATION DATA (voltages and references) ===
+  float volts[EC_LOW_CAL_POINTS];
+  float refs[EC_LOW_CAL_POINTS];
+  
+  cal.getECLowData(volts, refs);
+  memcpy(image.ecLowVolts, volts, sizeof(image.ecLowVolts));
+  memcpy(image.ecLowRefs, refs, sizeof(image.ecLowRefs));
+  
+  cal.getECHighData(volts, refs);
+  memcpy(image.ecHighVolts, volts, sizeof(image.ecHighVolts));
+  memcpy(image.ecHighRefs, refs, sizeof(image.ecHighRefs));
+  
+  cal.getpHData(volts, refs);
+  memcpy(image.pHVolts, volts, sizeof(image.pHVolts));
+  memcpy(image.pHRefs, refs, sizeof(image.pHRefs));
+  
+  cal.getTempData(volts, refs);
+  memcpy(image.tempVolts, volts, sizeof(image.tempVolts));
+  memcpy(image.tempRefs, refs, sizeof(image.tempRefs));
+  
+  // === CALIBRATION FLAGS ===
+  image.ecLowCal = cal.isECLowCalibrated() ? 1 : 0;
+  image.ecHighCal = cal.isECHighCalibrated() ? 1 : 0;
+  image.pHCal = cal.ispHCalibrated() ? 1 : 0;
+  image.tempCal = cal.isTempCalibrated() ? 1 : 0;
+}
+
+/*
+ * CalibrationEquation (aligned, bindable) -> packed storage record
+ */
+CalEquationRecord EEPROMManager::_equationRecord(const CalibrationEquation& eq) {
+  CalEquationRecord record;
+  record.C = eq.C;
+  record.D = eq.D;
+  record.R2 = eq.R2;
+  record.RMSE = eq.RMSE;
+  return record;
+}
+
+/*
+ * Check magic, version (must be version), CRC16, profile and calibration
+ * modes of an image. verbose prints the reason for a rejection.
+ */
+bool EEPROMManager::_validateImage(const CalImage& image, uint8_t version,
+                                   bool verbose) {
   // === VERIFY MAGIC NUMBER ===
-  uint16_t magic = _readUint16(ADDR_MAGIC);
-  if (magic != EEPROM_MAGIC) {
-    Serial.println(F("INFO: EEPROM empty (first boot)"));
+  if (image.magic != EEPROM_MAGIC) {
+    if (verbose) SerialOut.println(F("ERROR: Bad magic number"));
     return false;
   }
   
   // === VERIFY VERSION ===
-  uint8_t version = _readUint8(ADDR_VERSION);
-  if (version != EEPROM_VERSION) {
-    Serial.print(F("ERROR: EEPROM version mismatch (found "));
-    Serial.print(version);
-    Serial.print(F(", expected "));
-    Serial.print(EEPROM_VERSION);
-    Serial.println(F(")"));
+  if (image.version != version) {
+    if (verbose) {
+      SerialOut.print(F("ERROR: Unsupported version (found "));
+      SerialOut.print(image.version);
+      SerialOut.print(F(", expected "));
+      SerialOut.print(version);
+      SerialOut.println(F(")"));
+    }
     return false;
   }
   
   // === VERIFY CHECKSUM ===
-  uint16_t storedChecksum = _readUint16(ADDR_CHECKSUM);
-  uint16_t calculatedChecksum = _calculateCRC16(ADDR_MAGIC, ADDR_CHECKSUM - 1);
+  uint16_t storedChecksum = image.checksum;
+  uint16_t calculatedChecksum = crc16Update(CRC16_INIT, (const uint8_t*)&image,
+                                            CAL_IMAGE_CRC_SPAN);
   
   if (storedChecksum != calculatedChecksum) {
-    Serial.println(F("ERROR: EEPROM corrupt (bad checksum)"));
-    Serial.print(F("  Stored:     0x"));
-    Serial.println(storedChecksum, HEX);
-    Serial.print(F("  Calculated: 0x"));
-    Serial.println(calculatedChecksum, HEX);
+    if (verbose) {
+      SerialOut.println(F("ERROR: Image corrupt (bad checksum)"));
+      SerialOut.print(F("  Stored:     0x"));
+      SerialOut.println(storedChecksum, HEX);
+      SerialOut.print(F("  Calculated: 0x"));
+      SerialOut.println(calculatedChecksum, HEX);
+    }
     return false;
   }
   
-  // === LOAD CALIBRATION MODES ===
-  ECLowMode ecLowMode = (ECLowMode)_readUint8(ADDR_EC_LOW_MODE);
-  ECHighMode ecHighMode = (ECHighMode)_readUint8(ADDR_EC_HIGH_MODE);
-  pHMode pHCalMode = (pHMode)_readUint8(ADDR_PH_MODE);
-  TempMode tempCalMode = (TempMode)_readUint8(ADDR_TEMP_MODE);
+  // === VERIFY PROFILE ===
+  // Padding byte in version 1 (0xFF)
+  if (version == EEPROM_VERSION && image.profile >= PROFILE_COUNT) {
+    if (verbose) SerialOut.println(F("ERROR: Invalid profile"));
+    return false;
+  }
+  
+  // === VERIFY MODES ===
+  uint8_t ecLowMode = image.ecLowMode;
+  if ((ecLowMode != LOW_3PT && ecLowMode != LOW_4PT && ecLowMode != LOW_5PT) ||
+      image.ecHighMode != HIGH_2PT ||
+      image.pHMode != PH_3PT ||
+      image.tempMode != TEMP_3PT) {
+    if (verbose) SerialOut.println(F("ERROR: Invalid calibration mode"));
+    return false;
+  }
+  
+  return true;
+}
+
+/*******************************************************************************
+ * PRIVATE METHODS - SCHEMA MIGRATION
+ ******************************************************************************/
+
+/*
+ * Apply a validated image read from EEPROM. A current image just marks
+ * cal clean; a pre-journal one is upgraded and appended to the journal. If
+ * that write fails cal stays dirty, so a later SAVE (or the next boot)
+ * retries the migration and nothing is lost.
+ */
+void EEPROMManager::_loadImage(CalImage& image, Calibration& cal) {
+  uint8_t found = image.version;
+  
+  if (found == EEPROM_VERSION) {
+    _applyImage(image, cal);
+    cal.markClean();
+    return;
+  }
+  
+  _upgradeImage(image);
+  _applyImage(image, cal);
+  
+  SerialOut.print(F("EEPROM: Migrating v"));
+  SerialOut.print(found);
+  SerialOut.print(F(" image to v"));
+  SerialOut.println(EEPROM_VERSION);
+  
+  uint16_t written = 0;
+  if (!_commit(image, written)) {
+    SerialOut.println(F("WARN: Migration not written, old record kept"));
+    return;
+  }
   
+  cal.markClean();
+}
+
+/*
+ * Convert a validated image of an older version to EEPROM_VERSION in RAM
+ * and recompute its CRC16. Each case upgrades by one version and falls
+ * through to the next, so every older version takes the same path. A new
+ * version adds one case here and bumps EEPROM_VERSION.
+ */
+void EEPROMManager::_upgradeImage(CalImage& image) {
+  switch (image.version) {
+    case 1:
+      // v1 never wrote the padding byte (0xFF on a fresh chip); its
+      // single calibration becomes profile 0
+      image.profile = 0;
+      // fall through
+    default:
+      break;
+  }
+  
+  image.version = EEPROM_VERSION;
+  image.checksum = crc16Update(CRC16_INIT, (const uint8_t*)&image, CAL_IMAGE_CRC_SPAN);
+}
+
+/*
+ * Load a validated image into the Calibration object.
+ */
+void EEPROMManager::_applyImage(const CalImage& image, Calibration& cal) {
+  // === LOAD CALIBRATION MODES ===
   // Set modes (this will reset calibration data, but we'll restore it)
-  cal.setECLowMode(ecLowMode);
-  cal.setECHighMode(ecHighMode);
-  cal.setpHMode(pHCalMode);
-  cal.setTempMode(tempCalMode);
-  
-  // === LOAD EC LOW RANGE EQUATION ===
-  float C = _readFloat(ADDR_EC_LOW_EQ_C);
-  float D = _readFloat(ADDR_EC_LOW_EQ_D);
-  float R2 = _readFloat(ADDR_EC_LOW_EQ_R2);
-  float RMSE = _readFloat(ADDR_EC_LOW_EQ_RMSE);
-  cal.setECLowEquation(C, D, R2, RMSE);
-  
-  // === LOAD EC HIGH RANGE EQUATION ===
-  C = _readFloat(ADDR_EC_HIGH_EQ_C);
-  D = _readFloat(ADDR_EC_HIGH_EQ_D);
-  R2 = _readFloat(ADDR_EC_HIGH_EQ_R2);
-  RMSE = _readFloat(ADDR_EC_HIGH_EQ_RMSE);
-  cal.setECHighEquation(C, D, R2, RMSE);
-  
-  // === LOAD pH EQUATION ===
-  C = _readFloat(ADDR_PH_EQ_C);
-  D = _readFloat(ADDR_PH_EQ_D);
-  R2 = _readFloat(ADDR_PH_EQ_R2);
-  RMSE = _readFloat(ADDR_PH_EQ_RMSE);
-  cal.setpHEquation(C, D, R2, RMSE);
-  
-  // === LOAD TEMPERATURE EQUATION ===
-  C = _readFloat(ADDR_TEMP_EQ_C);
-  D = _readFloat(ADDR_TEMP_EQ_D);
-  R2 = _readFloat(ADDR_TEMP_EQ_R2);
-  RMSE = _readFloat(ADDR_TEMP_EQ_RMSE);
-  cal.setTempEquation(C, D, R2, RMSE);
+  cal.setECLowMode((ECLowMode)image.ecLowMode);
+  cal.setECHighMode((ECHighMode)image.ecHighMode);
+  cal.setpHMode((pHMode)image.pHMode);
+  cal.setTempMode((TempMode)image.tempMode);
   
-  // === LOAD CALIBRATION DATA ===
+  // === LOAD EQUATIONS ===
+  cal.setECLowEquation(image.ecLowEq.C, image.ecLowEq.D,
+                       image.ecLowEq.R2, image.ecLowEq.RMSE);
+  cal.setECHighEquation(image.ecHighEq.C, image.ecHighEq.D,
+                        image.ecHighEq.R2, image.ecHighEq.RMSE);
+  cal.setpHEquation(image.pHEq.C, image.pHEq.D,
+                    image.pHEq.R2, image.pHEq.RMSE);
+  cal.setTempEquation(image.tempEq.C, image.tempEq.D,
+                      image.tempEq.R2, image.tempEq.RMSE);
   
-  // EC Low Range data
+  // === LOAD CALIBRATION DATA ===
   float volts[EC_LOW_CAL_POINTS];
   float refs[EC_LOW_CAL_POINTS];
-  uint16_t addr = ADDR_EC_LOW_VOLTS;
-  for (uint8_t i = 0; i < EC_LOW_CAL_POINTS; i++) {
-    volts[i] = _readFloat(addr);
-    addr += sizeof(float);
-  }
-  addr = ADDR_EC_LOW_REFS;
-  for (uint8_t i = 0; i < EC_LOW_CAL_POINTS; i++) {
-    refs[i] = _readFloat(addr);
-    addr += sizeof(float);
-  }
+  
+  memcpy(volts, image.ecLowVolts, sizeof(image.ecLowVolts));
+  memcpy(refs, image.ecLowRefs, sizeof(image.ecLowRefs));
   cal.setECLowData(volts, refs);
   
-  // EC High Range data
-  float voltsHigh[EC_HIGH_CAL_POINTS];
-  float refsHigh[EC_HIGH_CAL_POINTS];
-  addr = ADDR_EC_HIGH_VOLTS;
-  for (uint8_t i = 0; i < EC_HIGH_CAL_POINTS; i++) {
-    voltsHigh[i] = _readFloat(addr);
-    addr += sizeof(float);
-  }
-  addr = ADDR_EC_HIGH_REFS;
-  for (uint8_t i = 0; i < EC_HIGH_CAL_POINTS; i++) {
-    refsHigh[i] = _readFloat(addr);
-    addr += sizeof(float);
-  }
-  cal.setECHighData(voltsHigh, refsHigh);
-  
-  // pH data
-  float voltspH[PH_CAL_POINTS];
-  float refspH[PH_CAL_POINTS];
-  addr = ADDR_PH_VOLTS;
-  for (uint8_t i = 0; i < PH_CAL_POINTS; i++) {
-    voltspH[i] = _readFloat(addr);
-    addr += sizeof(float);
-  }
-  addr = ADDR_PH_REFS;
-  for (uint8_t i = 0; i < PH_CAL_POINTS; i++) {
-    refspH[i] = _readFloat(addr);
-    addr += sizeof(float);
-  }
-  cal.setpHData(voltspH, refspH);
-  
-  // Temperature data
-  float voltsTemp[TEMP_CAL_POINTS];
-  float refsTemp[TEMP_CAL_POINTS];
-  addr = ADDR_TEMP_VOLTS;
-  for (uint8_t i = 0; i < TEMP_CAL_POINTS; i++) {
-    voltsTemp[i] = _readFloat(addr);
-    addr += sizeof(float);
-  }
-  addr = ADDR_TEMP_REFS;
-  for (uint8_t i = 0; i < TEMP_CAL_POINTS; i++) {
-    refsTemp[i] = _readFloat(addr);
-    addr += sizeof(float);
-  }
-  cal.setTempData(voltsTemp, refsTemp);
+  memcpy(volts, image.ecHighVolts, sizeof(image.ecHighVolts));
+  memcpy(refs, image.ecHighRefs, sizeof(image.ecHighRefs));
+  cal.setECHighData(volts, refs);
   
-  // === LOAD CALIBRATION FLAGS ===
-  bool ecLowCal = (_readUint8(ADDR_EC_LOW_CAL_FLAG) == 1);
-  bool ecHighCal = (_readUint8(ADDR_EC_HIGH_CAL_FLAG) == 1);
-  bool pHCal = (_readUint8(ADDR_PH_CAL_FLAG) == 1);
-  bool tempCal = (_readUint8(ADDR_TEMP_CAL_FLAG) == 1);
-  cal.setCalibrationFlags(ecLowCal, ecHighCal, pHCal, tempCal);
+  memcpy(volts, image.pHVolts, sizeof(image.pHVolts));
+  memcpy(refs, image.pHRefs, sizeof(image.pHRefs));
+  cal.setpHData(volts, refs);
   
-  Serial.println(F("EEPROM: Load complete"));
-  Serial.print(F("Checksum verified: 0x"));
-  Serial.println(storedChecksum, HEX);
+  memcpy(volts, image.tempVolts, sizeof(image.tempVolts));
+  memcpy(refs, image.tempRefs, sizeof(image.tempRefs));
+  cal.setTempData(volts, refs);
   
-  return true;
+  // === LOAD CALIBRATION FLAGS ===
+  cal.setCalibrationFlags(image.ecLowCal == 1,
+                          image.ecHighCal == 1,
+                          image.pHCal == 1,
+                          image.tempCal == 1);
 }
 
 /*******************************************************************************
- * VERIFY EEPROM INTEGRITY
+ * PRIVATE METHODS - JOURNAL
+ ******************************************************************************/
+
+/*
+ * Find the sealed record with the highest sequence number, ignoring slots
+ * whose bit is set in skip and, unless profile is PROFILE_ANY, records of
+ * other profiles. Only the header, CRC and profile bytes of each slot are
+ * read. Sequence numbers are compared with wrap-around arithmetic (they
+ * are shared by all profiles).
  * 
- * Checks if EEPROM contains valid calibration data without loading it.
- * Useful for diagnostics.
+ * Returns: false if no (remaining) slot holds a sealed record
+ */
+bool EEPROMManager::_findNewest(uint8_t skip, uint8_t profile, uint8_t& slot,
+                                uint16_t& sequence) {
+  bool found = false;
+  
+  for (uint8_t i = 0; i < JOURNAL_SLOTS; i++) {
+    if (skip & (1 << i)) {
+      continue;
+    }
+    
+    if (profile != PROFILE_ANY && _profileAt(_slotAddress(i)) != profile) {
+      continue;
+    }
+    
+    uint16_t seq;
+    if (!_isSealed(_slotAddress(i), seq)) {
+      continue;
+    }
+    
+    if (!found || (int16_t)(seq - sequence) > 0) {
+      slot = i;
+      sequence = seq;
+      found = true;
+    }
+  }
+  
+  return found;
+}
+
+/*
+ * Newest sealed record of profile (or PROFILE_ANY) whose image also
+ * passes magic/version/CRC checks.
+ */
+bool EEPROMManager::_findNewestValid(uint8_t profile, uint8_t& slot, uint16_t& sequence) {
+  uint8_t rejected = 0;
+  
+  while (_findNewest(rejected, profile, slot, sequence)) {
+    watchdogFeed();
+    if (_verifyAt(_slotAddress(slot) + offsetof(JournalRecord, image), EEPROM_VERSION)) {
+      return true;
+    }
+    rejected |= (1 << slot);
+  }
+  
+  return false;
+}
+
+/*
+ * Fill the newest-valid-slot cache. knownSlot is already known to be the
+ * answer for knownProfile (PROFILE_ANY: nothing known yet); each other
+ * slot is CRC-checked at most once.
+ */
+void EEPROMManager::_scanJournal(uint8_t knownProfile, uint8_t knownSlot) {
+  for (uint8_t profile = 0; profile < PROFILE_COUNT; profile++) {
+    uint8_t slot = knownSlot;
+    uint16_t sequence;
+    if (profile != knownProfile && !_findNewestValid(profile, slot, sequence)) {
+      slot = JOURNAL_NO_SLOT;
+    }
+    _newestSlot[profile] = slot;
+  }
+  _journalKnown = true;
+}
+
+/*
+ * Append image as a new journal record: pick the slot, write the image
+ * while accumulating its CRC16 (stored in image.checksum), read it back,
+ * then seal. Adds the number of cells written to written.
  * 
- * Returns: true if EEPROM has valid data
- ******************************************************************************/
-bool EEPROMManager::verify() {
-  // Check magic number
-  uint16_t magic = _readUint16(ADDR_MAGIC);
-  if (magic != EEPROM_MAGIC) {
+ * Returns: false if no slot accepted the image (previous record kept)
+ */
+bool EEPROMManager::_commit(CalImage& image, uint16_t& written) {
+  // === CHOOSE SLOT ===
+  // The newest intact record of each profile is never overwritten: for
+  // the other profiles it is their calibration, for this one it stays the
+  // fallback until the new record is written, read back and sealed.
+  // Known from load() (or the last commit), so only headers are read here.
+  if (!_journalKnown) {
+    _scanJournal(PROFILE_ANY, JOURNAL_NO_SLOT);
+  }
+  
+  uint8_t keep = 0;  // Bit per protected slot
+  for (uint8_t profile = 0; profile < PROFILE_COUNT; profile++) {
+    if (_newestSlot[profile] != JOURNAL_NO_SLOT) {
+      keep |= (1 << _newestSlot[profile]);
+    }
+  }
+  
+  uint8_t slot;
+  uint16_t sequence;
+  
+  if (_findNewest(0, PROFILE_ANY, slot, sequence)) {
+    slot = (slot + 1) % JOURNAL_SLOTS;
+    sequence++;
+  } else {
+    // Slot 0 overlaps a pre-journal image at address 0; keep that too
+    slot = _verifyAt(0, EEPROM_VERSION_FIXED) ? 1 : 0;
+    sequence = 1;
+  }
+  
+  // === WRITE IMAGE (CRC ACCUMULATED ON THE WAY), VERIFY, THEN SEAL ===
+  // Each attempt can take ~0.63 s, all of them together more than the
+  // watchdog timeout: feed it per record, not only per scheduler pass
+  for (uint8_t attempt = 0; attempt < JOURNAL_SLOTS; attempt++) {
+    watchdogFeed();
+    if (!(keep & (1 << slot))) {
+      uint16_t base = _slotAddress(slot);
+      
+      uint16_t imageBase = base + offsetof(JournalRecord, image);
+      const uint8_t* bytes = (const uint8_t*)&image;
+      
+      uint16_t checksum = CRC16_INIT;
+      written += _writeBytes(imageBase, bytes, CAL_IMAGE_CRC_SPAN, &checksum);
+      image.checksum = checksum;
+      written += _writeBytes(imageBase + CAL_IMAGE_CRC_SPAN, bytes + CAL_IMAGE_CRC_SPAN,
+                             sizeof(image.checksum), NULL);
+      
+      if (_matchesImage(imageBase, image)) {
+        // Commit: the seal makes this record the newest one
+        uint16_t seal = _sealFor(sequence, checksum);
+        written += _writeBytes(base + offsetof(JournalRecord, sequence),
+                               (const uint8_t*)&sequence, sizeof(sequence), NULL);
+        written += _writeBytes(base + offsetof(JournalRecord, seal),
+                               (const uint8_t*)&seal, sizeof(seal), NULL);
+        _activeSlot = slot;
+        _sequence = sequence;
+        _validity = VALIDITY_VALID;
+        _newestSlot[image.profile] = slot;
+        return true;
+      }
+      
+      SerialOut.print(F("WARN: Read-back failed in slot "));
+      SerialOut.println(slot);
+    }
+    slot = (slot + 1) % JOURNAL_SLOTS;
+  }
+  
+  return false;
+}
+
+/*
+ * Read the header of the record at base; true if its seal matches.
+ */
+bool EEPROMManager::_isSealed(uint16_t base, uint16_t& sequence) {
+  sequence = _readUint16(base + offsetof(JournalRecord, sequence));
+  uint16_t seal = _readUint16(base + offsetof(JournalRecord, seal));
+  uint16_t imageCRC = _readUint16(base + offsetof(JournalRecord, image) +
+                                  offsetof(CalImage, checksum));
+  
+  return seal == _sealFor(sequence, imageCRC);
+}
+
+uint16_t EEPROMManager::_slotAddress(uint8_t slot) {
+  return (uint16_t)slot * JOURNAL_RECORD_SIZE;
+}
+
+/*
+ * Profile of the record at base.
+ */
+uint8_t EEPROMManager::_profileAt(uint16_t base) {
+  return _readUint8(base + offsetof(JournalRecord, image) + offsetof(CalImage, profile));
+}
+
+/*
+ * Seal = CRC16 over sequence number and image CRC16 (little-endian).
+ * The image CRC covers the image, so the seal covers the whole record.
+ */
+uint16_t EEPROMManager::_sealFor(uint16_t sequence, uint16_t imageCRC) {
+  uint16_t crc = CRC16_INIT;
+  crc = crc16Update(crc, lowByte(sequence));
+  crc = crc16Update(crc, highByte(sequence));
+  crc = crc16Update(crc, lowByte(imageCRC));
+  crc = crc16Update(crc, highByte(imageCRC));
+  return crc;
+}
+
+/*
+ * Check magic, version (must be version) and CRC16 of an image stored at
+ * base, straight from EEPROM (no RAM copy needed).
+ */
+bool EEPROMManager::_verifyAt(uint16_t base, uint8_t version) {
+  if (_readUint16(base + offsetof(CalImage, magic)) != EEPROM_MAGIC) {
     return false;
   }
   
-  // Check version
-  uint8_t version = _readUint8(ADDR_VERSION);
-  if (version != EEPROM_VERSION) {
+  if (_readUint8(base + offsetof(CalImage, version)) != version) {
     return false;
   }
   
-  // Check checksum
-  uint16_t storedChecksum = _readUint16(ADDR_CHECKSUM);
-  uint16_t calculatedChecksum = _calculateCRC16(ADDR_MAGIC, ADDR_CHECKSUM - 1);
+  uint16_t storedChecksum = _readUint16(base + offsetof(CalImage, checksum));
+  uint16_t calculatedChecksum = _calculateCRC16(base, base + CAL_IMAGE_CRC_SPAN - 1);
   
   return (storedChecksum == calculatedChecksum);
 }
 
-/*******************************************************************************
- * PRIVATE METHODS - LOW-LEVEL EEPROM ACCESS
- ******************************************************************************/
+/*
+ * Read back a freshly written image and compare it with the RAM copy.
+ */
+bool EEPROMManager::_matchesImage(uint16_t base, const CalImage& image) {
+  const uint8_t* bytes = (const uint8_t*)&image;
+  
+  for (uint16_t i = 0; i < CAL_IMAGE_SIZE; i++) {
+    if (halNvRead(base + i) != bytes[i]) {
+      return false;
+    }
+  }
+  return true;
+}
 
 /*
- * Read a float from EEPROM (4 bytes)
+ * Write bytes that differ from what EEPROM already holds.
+ * If crc is not NULL, every byte is also fed into that running CRC16.
+ * Callers write at most one record (~0.63 s) per call, so feeding the
+ * watchdog once per call keeps long sequences of writes alive.
+ * Returns the number of cells actually written.
  */
-float EEPROMManager::_readFloat(uint16_t address) {
-  float value;
-  EEPROM.get(address, value);
-  return value;
+uint16_t EEPROMManager::_writeBytes(uint16_t address, const uint8_t data[],
+                                    uint16_t length, uint16_t* crc) {
+  uint16_t written = 0;
+  watchdogFeed();
+  
+  for (uint16_t i = 0; i < length; i++) {
+    if (crc != NULL) {
+      *crc = crc16Update(*crc, data[i]);
+    }
+    if (halNvRead(address + i) != data[i]) {
+      halNvWrite(address + i, data[i]);
+      written++;
+    }
+  }
+  
+  return written;
 }
 
 /*
- * Write a float to EEPROM (4 bytes)
+ * List the sensor sections that changed since the last load/save.
  */
-void EEPROMManager::_writeFloat(uint16_t address, float value) {
-  EEPROM.put(address, value);
+void EEPROMManager::_printDirty(uint8_t dirty) {
+  SerialOut.print(F("Changed:"));
+  if (dirty & DIRTY_EC_LOW)  SerialOut.print(F(" ECL"));
+  if (dirty & DIRTY_EC_HIGH) SerialOut.print(F(" ECH"));
+  if (dirty & DIRTY_PH)      SerialOut.print(F(" pH"));
+  if (dirty & DIRTY_TEMP)    SerialOut.print(F(" Temp"));
+  if (dirty == 0)            SerialOut.print(F(" (none)"));
+  SerialOut.println();
+}
+
+void EEPROMManager::_printSlot() {
+  SerialOut.print(F("Journal: slot "));
+  SerialOut.print(_activeSlot);
+  SerialOut.print(F(" of "));
+  SerialOut.print(JOURNAL_SLOTS);
+  SerialOut.print(F(", seq "));
+  SerialOut.print(_sequence);
+  SerialOut.print(F(", profile "));
+  SerialOut.println(_profile);
 }
 
+/*******************************************************************************
+ * PRIVATE METHODS - PROFILE TABLE
+ ******************************************************************************/
+
 /*
- * Read a uint16_t from EEPROM (2 bytes)
+ * Read the profile table. An invalid one (first boot, firmware before
+ * profiles) reads as profile 0 active and no probe IDs.
+ * Returns: false if the stored table was invalid
  */
-uint16_t EEPROMManager::_readUint16(uint16_t address) {
-  uint16_t value;
-  EEPROM.get(address, value);
-  return value;
+bool EEPROMManager::_readTable(ProfileTable& table) {
+  halNvGet(PROFILE_TABLE_START, table);
+  
+  uint16_t crc = crc16Update(CRC16_INIT, (const uint8_t*)&table,
+                             offsetof(ProfileTable, crc));
+  if (table.crc == crc && table.active < PROFILE_COUNT) {
+    return true;
+  }
+  
+  memset(&table, 0, sizeof(table));
+  return false;
 }
 
 /*
- * Write a uint16_t to EEPROM (2 bytes)
+ * Store the table with a fresh CRC16; only changed cells are written.
  */
-void EEPROMManager::_writeUint16(uint16_t address, uint16_t value) {
-  EEPROM.put(address, value);
+void EEPROMManager::_writeTable(ProfileTable& table) {
+  table.crc = crc16Update(CRC16_INIT, (const uint8_t*)&table,
+                          offsetof(ProfileTable, crc));
+  _writeBytes(PROFILE_TABLE_START, (const uint8_t*)&table, sizeof(table), NULL);
 }
 
 /*
- * Read a uint8_t from EEPROM (1 byte)
+ * One PROFILES line. Equations and calibrated flags are read straight
+ * from the record; both are stored in sensor order (EC low, EC high, pH,
+ * temp), so sensor i is at a fixed stride from the first one.
  */
-uint8_t EEPROMManager::_readUint8(uint16_t address) {
-  return EEPROM.read(address);
+void EEPROMManager::_printProfileRow(uint8_t profile, const ProfileTable& table) {
+  SerialOut.print(profile);
+  SerialOut.print(profile == _profile ? F(",*,") : F(",,"));
+  for (uint8_t i = 0; i < PROBE_ID_LEN && table.probeId[profile][i] != '\0'; i++) {
+    SerialOut.print(table.probeId[profile][i]);
+  }
+  
+  uint8_t slot = _newestSlot[profile];
+  if (slot == JOURNAL_NO_SLOT) {
+    SerialOut.println(F(",,,,,,,,,"));
+    return;
+  }
+  
+  SerialOut.print(',');
+  SerialOut.print(_readUint16(_slotAddress(slot) + offsetof(JournalRecord, sequence)));
+  
+  uint16_t imageBase = _slotAddress(slot) + offsetof(JournalRecord, image);
+  for (uint8_t i = 0; i < 4; i++) {
+    if (_readUint8(imageBase + offsetof(CalImage, ecLowCal) + i) != 1) {
+      SerialOut.print(F(",,"));
+      continue;
+    }
+    
+    CalEquationRecord eq;
+    halNvGet(imageBase + offsetof(CalImage, ecLowEq) + i * sizeof(eq), eq);
+    SerialOut.print(',');
+    printFixed(SerialOut, eq.R2, 4);
+    SerialOut.print(',');
+    printFixed(SerialOut, eq.RMSE, 3);
+  }
+  SerialOut.println();
+}
+
+/*******************************************************************************
+ * PRIVATE METHODS - LOW-LEVEL EEPROM ACCESS
+ ******************************************************************************/
+
+/*
+ * Read a uint16_t from EEPROM (2 bytes)
+ */
+uint16_t EEPROMManager::_readUint16(uint16_t address) {
+  uint16_t value;
+  halNvGet(address, value);
+  return value;
 }
 
 /*
- * Write a uint8_t to EEPROM (1 byte)
+ * Read a uint8_t from EEPROM (1 byte)
  */
-void EEPROMManager::_writeUint8(uint16_t address, uint8_t value) {
-  EEPROM.write(address, value);
+uint8_t EEPROMManager::_readUint8(uint16_t address) {
+  return halNvRead(address);
 }
 
 /*******************************************************************************
  * PRIVATE METHODS - CRC16 CHECKSUM CALCULATION
  * 
- * CRC-16-CCITT algorithm (polynomial 0x1021)
- * This is a standard, well-tested checksum algorithm.
+ * CRC-16-CCITT algorithm (polynomial 0x1021), table-driven (see CRC16.h)
  ******************************************************************************/
 
 /*
@@ -427,45 +1020,10 @@ void EEPROMManager::_writeUint8(uint16_t address, uint8_t value) {
  *   uint16_t - CRC16 checksum value
  */
 uint16_t EEPROMManager::_calculateCRC16(uint16_t startAddr, uint16_t endAddr) {
-  uint16_t crc = 0xFFFF;  // Initial value
+  uint16_t crc = CRC16_INIT;
   
-  // Process each byte in the range
   for (uint16_t addr = startAddr; addr <= endAddr; addr++) {
-    uint8_t data = EEPROM.read(addr);
-    crc = _updateCRC16(crc, data);
-  }
-  
-  return crc;
-}
-
-/*
- * Update CRC16 with one byte
- * 
- * This is the core CRC16 calculation using the CCITT polynomial (0x1021).
- * 
- * Parameters:
- *   crc  - Current CRC value
- *   data - Byte to add to CRC
- * 
- * Returns:
- *   uint16_t - Updated CRC value
- * 
- * Algorithm:
- *   The CRC is calculated by XORing the data byte into the high byte of the
- *   CRC, then processing each bit. If the MSB is 1, XOR with the polynomial.
- */
-uint16_t EEPROMManager::_updateCRC16(uint16_t crc, uint8_t data) {
-  crc ^= ((uint16_t)data << 8);  // XOR data into high byte of CRC
-  
-  // Process each bit (8 bits per byte)
-  for (uint8_t i = 0; i < 8; i++) {
-    if (crc & 0x8000) {
-      // MSB is 1: shift left and XOR with polynomial
-      crc = (crc << 1) ^ 0x1021;
-    } else {
-      // MSB is 0: just shift left
-      crc = crc << 1;
-    }
+    crc = crc16Update(crc, halNvRead(addr));
   }
   
   return crc;
@@ -10,15 +10,18 @@
  *   - Save complete calibration state for all sensors to EEPROM
  *   - Load calibration state from EEPROM
  *   - Verify data integrity (magic number, version, checksum)
- *   - Handle version migration if needed
+ *   - Upgrade the image of firmware before the journal (version 1 at
+ *     address 0) to the current version on load
+ *   - Keep one calibration per profile (probe set) and switch between them
  * 
- * EEPROM Structure (182 bytes total):
- *   See Config.h for detailed memory layout
+ * EEPROM Structure:
+ *   182-byte packed CalImage stored in a ring journal of sealed
+ *   JournalRecords (see Config.h for both layouts)
  * 
  * Safety Features:
  *   - Magic number (0xEC57) validates this is our data
- *   - Version number enables future compatibility
- *   - CRC16 checksum detects corruption
+ *   - Version number drives the schema migration
+ *   - CRC16 checksum detects corruption (table-driven, see CRC16.h)
  *   - Graceful handling of empty/corrupt EEPROM
  * 
  * Author: System Rewrite v1.0 - Complete Edition
@@ -29,7 +32,7 @@
 #define EEPROMMANAGER_H
 
 #include <Arduino.h>
-#include <EEPROM.h>
+#include "Hal.h"
 #include "Config.h"
 #include "Calibration.h"
 
@@ -50,7 +53,8 @@ public:
    * SAVE CALIBRATION TO EEPROM
    * 
    * Saves complete calibration state for ALL sensors to EEPROM with
-   * integrity checking.
+   * integrity checking. Does nothing if cal has no dirty sections;
+   * reports bytes actually written and time spent.
    ***************************************************************************/
   bool save(Calibration& cal);
   
@@ -58,6 +62,8 @@ public:
    * LOAD CALIBRATION FROM EEPROM
    * 
    * Loads calibration state for ALL sensors from EEPROM with validation.
+   * An image from older firmware is upgraded and written back to the
+   * journal in place (called from setup(), so this happens on boot).
    ***************************************************************************/
   bool load(Calibration& cal);
   
@@ -65,25 +71,129 @@ public:
    * VERIFY EEPROM INTEGRITY
    * 
    * Checks if EEPROM contains valid calibration data without loading it.
+   * The result of load()/save() is cached, so this only reads the EEPROM
+   * if nothing has been loaded or written since the last raw write.
    ***************************************************************************/
   bool verify();
+  
+  /***************************************************************************
+   * CALIBRATION IMAGE EXPORT / IMPORT
+   * 
+   * image is the packed CalImage, byte for byte the EEPROM layout (magic,
+   * version, data, CRC16). Used by CALDUMP/CALLOAD for host sync/cloning.
+   ***************************************************************************/
+  uint16_t exportImage(const Calibration& cal, CalImage& image);
+  bool importImage(const CalImage& image, Calibration& cal);
+  
+  /***************************************************************************
+   * RAW EEPROM ACCESS
+   * 
+   * Whole-EEPROM transfer (EEDUMP/EELOAD) for backup and fleet cloning.
+   * writeRaw() skips cells that already match and reads the block back.
+   * It forgets the journal position, so call load() once the complete
+   * image has been written.
+   ***************************************************************************/
+  void readRaw(uint16_t address, uint8_t data[], uint8_t length);
+  bool writeRaw(uint16_t address, const uint8_t data[], uint8_t length);
+  
+  /***************************************************************************
+   * JOURNAL POSITION
+   * 
+   * Slot and sequence number of the record last loaded or saved
+   * (JOURNAL_NO_SLOT if none yet).
+   ***************************************************************************/
+  uint8_t getActiveSlot() const { return _activeSlot; }
+  uint16_t getSequence() const { return _sequence; }
+  
+  /***************************************************************************
+   * CALIBRATION PROFILES
+   * 
+   * selectProfile() makes profile the active one (remembered across power
+   * cycles) and loads its newest record. LOAD_EMPTY: the profile has no
+   * record yet. LOAD_CORRUPT: it has records but none passes validation;
+   * nothing is written, the previous profile stays active and cal is
+   * left untouched.
+   * save() and load() always work on the active profile. Probe IDs are
+   * up to PROBE_ID_LEN characters; id must hold PROBE_ID_LEN + 1.
+   ***************************************************************************/
+  enum LoadResult { LOAD_OK, LOAD_EMPTY, LOAD_CORRUPT };
+  
+  uint8_t getProfile() const { return _profile; }
+  LoadResult selectProfile(uint8_t profile, Calibration& cal);
+  void getProbeId(uint8_t profile, char id[]);
+  bool setProbeId(const char id[]);
+  void printProfiles();
+
+  // tools/firmware_bench times _calculateCRC16
+  friend class FirmwareBench;
 
 private:
+  /***************************************************************************
+   * PRIVATE MEMBER VARIABLES
+   ***************************************************************************/
+  uint8_t  _activeSlot;   // Journal slot of the current record
+  uint16_t _sequence;     // Its sequence number
+  uint8_t  _profile;      // Active calibration profile
+  
+  // Cached verify() result, kept until the EEPROM is written again
+  enum Validity { VALIDITY_UNKNOWN, VALIDITY_VALID, VALIDITY_INVALID };
+  Validity _validity;
+  
+  // Newest valid slot of each profile (JOURNAL_NO_SLOT = none), found by
+  // load() and kept up to date by _commit(); a raw write invalidates it
+  uint8_t _newestSlot[PROFILE_COUNT];
+  bool _journalKnown;
+  
+  /***************************************************************************
+   * PRIVATE METHODS - Journal
+   ***************************************************************************/
+  bool _findNewest(uint8_t skip, uint8_t profile, uint8_t& slot, uint16_t& sequence);
+  bool _findNewestValid(uint8_t profile, uint8_t& slot, uint16_t& sequence);
+  void _scanJournal(uint8_t knownProfile, uint8_t knownSlot);
+  uint16_t _slotAddress(uint8_t slot);
+  uint8_t _profileAt(uint16_t base);
+  bool _isSealed(uint16_t base, uint16_t& sequence);
+  uint16_t _sealFor(uint16_t sequence, uint16_t imageCRC);
+  bool _verifyAt(uint16_t base, uint8_t version);
+  bool _matchesImage(uint16_t base, const CalImage& image);
+  bool _commit(CalImage& image, uint16_t& written);
+  uint16_t _writeBytes(uint16_t address, const uint8_t data[], uint16_t length,
+                       uint16_t* crc);
+  void _printSlot();
+  void _printDirty(uint8_t dirty);
+  
+  /***************************************************************************
+   * PRIVATE METHODS - Profile Table
+   ***************************************************************************/
+  bool _readTable(ProfileTable& table);
+  void _writeTable(ProfileTable& table);
+  void _printProfileRow(uint8_t profile, const ProfileTable& table);
+  
   /***************************************************************************
    * PRIVATE METHODS - Low-level EEPROM Access
    ***************************************************************************/
-  float _readFloat(uint16_t address);
-  void _writeFloat(uint16_t address, float value);
   uint16_t _readUint16(uint16_t address);
-  void _writeUint16(uint16_t address, uint16_t value);
   uint8_t _readUint8(uint16_t address);
-  void _writeUint8(uint16_t address, uint8_t value);
+  
+  /***************************************************************************
+   * PRIVATE METHODS - RAM Image Access
+   ***************************************************************************/
+  void _buildImage(const Calibration& cal, CalImage& image);
+  CalEquationRecord _equationRecord(const CalibrationEquation& eq);
+  bool _validateImage(const CalImage& image, uint8_t version, bool verbose);
+  void _applyImage(const CalImage& image, Calibration& cal);
+  
+  /***************************************************************************
+   * PRIVATE METHODS - Load and Schema Migration
+   ***************************************************************************/
+  LoadResult _load(Calibration& cal);
+  void _loadImage(CalImage& image, Calibration& cal);
+  void _upgradeImage(CalImage& image);
   
   /***************************************************************************
    * PRIVATE METHODS - Checksum Calculation
    ***************************************************************************/
   uint16_t _calculateCRC16(uint16_t startAddr, uint16_t endAddr);
-  uint16_t _updateCRC16(uint16_t crc, uint8_t data);
 };
 
 #endif // EEPROMMANAGER_H
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ * FASTFORMAT.CPP - Integer-Only Decimal Formatter Implementation
+ *
+ * Algorithm (mirrors AVR Print::printFloat step by step):
+ *   1. Handle nan / inf / ovf exactly like printFloat
+ *   2. Add the same rounding constant printFloat computes (0.5 / 10^digits)
+ *   3. Split into integer part and remainder (same float operations)
+ *   4. Decompose the remainder into mantissa m and shift s (rem = m / 2^s)
+ *   5. Per digit: m ×= 10, round m back to 24 significant bits (this is
+ *      exactly what the float multiply does), then take the integer part
+ *
+ * Only steps 2-3 touch soft-float; the digit loop is pure integer math.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "FastFormat.h"
+
+/*******************************************************************************
+ * ROUNDING TABLE
+ *
+ * printFloat builds its rounding term by repeated division (0.5 / 10 / 10 ...).
+ * The table is built the same way so the float sum is bit-identical.
+ ******************************************************************************/
+static const float ROUNDING[FORMAT_MAX_DIGITS + 1] PROGMEM = {
+  0.5f,
+  0.5f / 10.0f,
+  0.5f / 10.0f / 10.0f,
+  0.5f / 10.0f / 10.0f / 10.0f,
+  0.5f / 10.0f / 10.0f / 10.0f / 10.0f,
+  0.5f / 10.0f / 10.0f / 10.0f / 10.0f / 10.0f,
+  0.5f / 10.0f / 10.0f / 10.0f / 10.0f / 10.0f / 10.0f,
+  0.5f / 10.0f / 10.0f / 10.0f / 10.0f / 10.0f / 10.0f / 10.0f,
+  0.5f / 10.0f / 10.0f / 10.0f / 10.0f / 10.0f / 10.0f / 10.0f / 10.0f
+};
+
+static const uint32_t MANTISSA_LIMIT = 0x1000000UL;  // 2^24 (float precision)
+
+/*******************************************************************************
+ * FORMAT INTO BUFFER
+ ******************************************************************************/
+uint8_t formatFixed(char* buf, float value, uint8_t digits) {
+  uint8_t len = 0;
+
+  // Special values (same checks and order as printFloat)
+  if (isnan(value)) { strcpy(buf, "nan"); return 3; }
+  if (isinf(value)) { strcpy(buf, "inf"); return 3; }
+  if (value > 4294967040.0 || value < -4294967040.0) {
+    strcpy(buf, "ovf");
+    return 3;
+  }
+
+  if (digits > FORMAT_MAX_DIGITS) {
+    digits = FORMAT_MAX_DIGITS;
+  }
+
+  if (value < 0.0) {
+    buf[len++] = '-';
+    value = -value;
+  }
+
+  // Round and split (identical float operations to printFloat)
+  value += pgm_read_float(&ROUNDING[digits]);
+  uint32_t intPart = (uint32_t)value;
+  float remainder = value - (float)intPart;
+
+  // Integer part, rendered backwards then copied forward
+  char tmp[10];
+  uint8_t n = 0;
+  do {
+    tmp[n++] = '0' + (char)(intPart % 10);
+    intPart /= 10;
+  } while (intPart > 0);
+  while (n > 0) {
+    buf[len++] = tmp[--n];
+  }
+
+  if (digits == 0) {
+    buf[len] = '\0';
+    return len;
+  }
+  buf[len++] = '.';
+
+  // Decompose remainder (0 <= rem < 1) into rem = m / 2^shift
+  uint32_t bits;
+  memcpy(&bits, &remainder, sizeof(bits));
+  uint8_t exponent = (uint8_t)(bits >> 23);
+  uint32_t m = bits & 0x7FFFFFUL;
+  int16_t shift;
+  if (exponent == 0) {
+    shift = 149;              // Zero or denormal
+  } else {
+    m |= 0x800000UL;          // Implicit leading 1
+    shift = 150 - exponent;
+  }
+
+  // Fractional digits
+  while (digits-- > 0) {
+    m *= 10;
+
+    // Round back to 24 significant bits (round-half-even, like the FPU)
+    if (m >= MANTISSA_LIMIT) {
+      uint8_t drop = (m >= 0x8000000UL) ? 4 :
+                     (m >= 0x4000000UL) ? 3 :
+                     (m >= 0x2000000UL) ? 2 : 1;
+      uint32_t lost = m & ((1UL << drop) - 1);
+      uint32_t half = 1UL << (drop - 1);
+      m >>= drop;
+      shift -= drop;
+      if (lost > half || (lost == half && (m & 1))) {
+        m++;
+        if (m == MANTISSA_LIMIT) {
+          m >>= 1;
+          shift--;
+        }
+      }
+    }
+
+    uint8_t digit = 0;
+    if (shift < 32) {
+      digit = (uint8_t)(m >> shift);
+      m -= (uint32_t)digit << shift;
+    }
+    buf[len++] = '0' + digit;
+  }
+
+  buf[len] = '\0';
+  return len;
+}
+
+/*******************************************************************************
+ * PRINT HELPERS
+ ******************************************************************************/
+size_t printFixed(Print& out, float value, uint8_t digits) {
+  if (digits > FORMAT_MAX_DIGITS) {
+    return out.print(value, digits);
+  }
+
+  char buf[FORMAT_BUFFER_SIZE];
+  uint8_t len = formatFixed(buf, value, digits);
+  return out.write((const uint8_t*)buf, len);
+}
+
+size_t printlnFixed(Print& out, float value, uint8_t digits) {
+  size_t n = printFixed(out, value, digits);
+  return n + out.println();
+}
+
+size_t printHex8(Print& out, uint8_t value) {
+  static const char HEX_DIGITS[] PROGMEM = "0123456789ABCDEF";
+  uint8_t buf[2];
+  buf[0] = pgm_read_byte(&HEX_DIGITS[value >> 4]);
+  buf[1] = pgm_read_byte(&HEX_DIGITS[value & 0x0F]);
+  return out.write(buf, 2);
+}
+
+/*******************************************************************************
+ * END OF FASTFORMAT IMPLEMENTATION
+ ******************************************************************************/
@@ -0,0 +1,55 @@
+/*******************************************************************************
+ * FASTFORMAT.H - Integer-Only Decimal Formatter
+ *
+ * Purpose:
+ *   Drop-in replacement for Serial.print(float, digits). Renders the value
+ *   into a stack buffer and writes it with a single write() call.
+ *
+ * Why:
+ *   Print::printFloat runs one soft-float multiply, float-to-int conversion
+ *   and subtraction per fractional digit. On the ATmega328P that dominates
+ *   every output path (READ, STATUS_COMPACT, EQUATIONS, PLOT_DATA).
+ *
+ * Output Compatibility:
+ *   Output is byte-for-byte identical to the AVR Print::printFloat
+ *   ("nan", "inf", "ovf", rounding and truncated digits included).
+ *   The fraction is extracted from the float's mantissa with integer
+ *   arithmetic that reproduces the float rounding of each ×10 step.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef FASTFORMAT_H
+#define FASTFORMAT_H
+
+#include <Arduino.h>
+
+/*******************************************************************************
+ * FORMATTER LIMITS
+ *
+ * Buffer holds: sign + 10 integer digits + '.' + FORMAT_MAX_DIGITS + '\0'
+ * Requests for more digits fall back to Print::printFloat.
+ ******************************************************************************/
+const uint8_t FORMAT_MAX_DIGITS    = 8;
+const uint8_t FORMAT_BUFFER_SIZE   = 24;
+
+/*
+ * Format value into buf with the given number of decimal places.
+ * buf must hold FORMAT_BUFFER_SIZE bytes. Returns string length.
+ */
+uint8_t formatFixed(char* buf, float value, uint8_t digits);
+
+/*
+ * Print value to any Print target (Serial, output queue, ...).
+ * Same output as out.print(value, digits).
+ */
+size_t printFixed(Print& out, float value, uint8_t digits);
+size_t printlnFixed(Print& out, float value, uint8_t digits);
+
+/*
+ * Print one byte as exactly two upper-case hex digits ("0A", not "A").
+ */
+size_t printHex8(Print& out, uint8_t value);
+
+#endif // FASTFORMAT_H
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ * HAL.H - Hardware Abstraction Layer
+ *
+ * Purpose:
+ *   Everything the firmware needs from the hardware goes through these
+ *   functions:
+ *
+ *     analog input   halAnalogInit, halAnalogRead
+ *     time           halMillis, halMicros, halDelay
+ *     serial         halSerialBegin, halSerialAvailable, halSerialRead,
+ *                    halSerialAvailableForWrite, halSerialWrite,
+ *                    halSerialFlush
+ *     nonvolatile    halNvRead, halNvWrite, halNvUpdate, halNvGet
+ *
+ *   The rest of Arduino.h the firmware uses (String, Print, F(), PROGMEM)
+ *   is plain language support. Without the hardware dependency the
+ *   sensor, calibration and storage code also builds as a native program
+ *   (see native/README.md).
+ *
+ * Implementations:
+ *   ARDUINO defined:  inline wrappers around the Arduino core and
+ *                     EEPROM library below (no cost on the AVR)
+ *   otherwise:        native/HalLinux.cpp (simulated ADC, file-backed
+ *                     EEPROM, stdin/stdout or PTY serial)
+ *
+ *   AVR-only features (sleep, watchdog, stack painting) keep their own
+ *   __AVR__ sections and do nothing on other targets.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef HAL_H
+#define HAL_H
+
+#include <Arduino.h>
+
+#if defined(ARDUINO)
+
+#include <EEPROM.h>
+
+/*******************************************************************************
+ * ANALOG INPUT
+ ******************************************************************************/
+inline void halAnalogInit(uint8_t pin) { pinMode(pin, INPUT); }
+inline uint16_t halAnalogRead(uint8_t pin) { return analogRead(pin); }
+
+/*******************************************************************************
+ * TIME
+ ******************************************************************************/
+inline unsigned long halMillis() { return millis(); }
+inline unsigned long halMicros() { return micros(); }
+inline void halDelay(unsigned long ms) { delay(ms); }
+
+/*******************************************************************************
+ * SERIAL
+ *
+ * halSerialBegin() returns once the port can be used; on native-USB
+ * boards (USBCON) that is when the host opens it or after waitMs.
+ ******************************************************************************/
+inline void halSerialBegin(uint32_t baud, unsigned long waitMs) {
+  Serial.begin(baud);
+#if defined(USBCON)
+  while (!Serial && millis() < waitMs);
+#else
+  (void)waitMs;
+#endif
+}
+inline int halSerialAvailable() { return Serial.available(); }
+inline int halSerialRead() { return Serial.read(); }
+inline int halSerialAvailableForWrite() { return Serial.availableForWrite(); }
+inline size_t halSerialWrite(uint8_t c) { return Serial.write(c); }
+inline size_t halSerialWrite(const uint8_t* data, size_t length) { return Serial.write(data, length); }
+inline void halSerialFlush() { Serial.flush(); }
+
+/*******************************************************************************
+ * NONVOLATILE STORAGE (EEPROM_SIZE bytes)
+ *
+ * halNvWrite() always erases and writes the cell (3.3 ms on the AVR);
+ * halNvUpdate() skips cells that already hold the value.
+ ******************************************************************************/
+inline uint8_t halNvRead(uint16_t address) { return EEPROM.read(address); }
+inline void halNvWrite(uint16_t address, uint8_t value) { EEPROM.write(address, value); }
+
+#else
+
+void halAnalogInit(uint8_t pin);
+uint16_t halAnalogRead(uint8_t pin);
+
+unsigned long halMillis();
+unsigned long halMicros();
+void halDelay(unsigned long ms);
+
+void halSerialBegin(uint32_t baud, unsigned long waitMs);
+int halSerialAvailable();
+int halSerialRead();
+int halSerialAvailableForWrite();
+size_t halSerialWrite(uint8_t c);
+size_t halSerialWrite(const uint8_t* data, size_t length);
+void halSerialFlush();
+
+uint8_t halNvRead(uint16_t address);
+void halNvWrite(uint16_t address, uint8_t value);
+
+#endif // ARDUINO
+
+/*******************************************************************************
+ * NONVOLATILE STORAGE HELPERS (all targets)
+ ******************************************************************************/
+inline void halNvUpdate(uint16_t address, uint8_t value) {
+  if (halNvRead(address) != value) {
+    halNvWrite(address, value);
+  }
+}
+
+/*
+ * Read a whole object (struct, integer) starting at address.
+ */
+template <typename T>
+T& halNvGet(uint16_t address, T& value) {
+  uint8_t* bytes = (uint8_t*)&value;
+  for (uint16_t i = 0; i < sizeof(T); i++) {
+    bytes[i] = halNvRead(address + i);
+  }
+  return value;
+}
+
+#endif // HAL_H
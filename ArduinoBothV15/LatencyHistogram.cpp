@@ -0,0 +1,77 @@
+/*******************************************************************************
+ * LATENCYHISTOGRAM.CPP - Log-Bucketed Latency Histogram Implementation
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "LatencyHistogram.h"
+
+/*******************************************************************************
+ * CONSTRUCTOR
+ ******************************************************************************/
+LatencyHistogram::LatencyHistogram() {
+  reset();
+}
+
+/*******************************************************************************
+ * RECORDING
+ *
+ * Bucket = number of halvings until the value drops below LATENCY_FIRST_US
+ * (shifts only, no log() on the AVR).
+ ******************************************************************************/
+void LatencyHistogram::record(uint32_t elapsedUs) {
+  uint32_t scaled = elapsedUs >> LATENCY_FIRST_SHIFT;
+  uint8_t bucket = 0;
+
+  while (scaled > 0 && bucket < LATENCY_BUCKETS - 1) {
+    scaled >>= 1;
+    bucket++;
+  }
+
+  _buckets[bucket]++;
+  _count++;
+  if (elapsedUs > _maxUs) {
+    _maxUs = elapsedUs;
+  }
+}
+
+void LatencyHistogram::reset() {
+  for (uint8_t i = 0; i < LATENCY_BUCKETS; i++) {
+    _buckets[i] = 0;
+  }
+  _count = 0;
+  _maxUs = 0;
+}
+
+/*******************************************************************************
+ * RESULTS
+ ******************************************************************************/
+uint32_t LatencyHistogram::percentileUs(uint8_t percent) const {
+  if (_count == 0) {
+    return 0;
+  }
+
+  // Rank of the sample at this percentile (1-based, rounded up)
+  uint32_t rank = (uint32_t)(((uint64_t)_count * percent + 99) / 100);
+  uint32_t seen = 0;
+
+  for (uint8_t i = 0; i < LATENCY_BUCKETS - 1; i++) {
+    seen += _buckets[i];
+    if (seen >= rank) {
+      return min(bucketLimitUs(i), _maxUs);
+    }
+  }
+  return _maxUs;
+}
+
+uint32_t LatencyHistogram::bucketLimitUs(uint8_t i) {
+  if (i >= LATENCY_BUCKETS - 1) {
+    return 0;
+  }
+  return LATENCY_FIRST_US << i;
+}
+
+/*******************************************************************************
+ * END OF LATENCY HISTOGRAM IMPLEMENTATION
+ ******************************************************************************/
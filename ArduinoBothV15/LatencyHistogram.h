@@ -0,0 +1,67 @@
+/*******************************************************************************
+ * LATENCYHISTOGRAM.H - Log-Bucketed Latency Histogram
+ *
+ * Purpose:
+ *   Averages hide the slow tail that a host actually notices (a serial
+ *   stall, a long EEPROM save). The firmware keeps one histogram for
+ *   loop() iteration time and one for command latency (line received ->
+ *   response queued), and LATENCY prints both. This lets a change be
+ *   checked against its p99 and worst case, not only its typical time.
+ *
+ * Buckets:
+ *   Powers of two in microseconds (see LATENCY_BUCKETS in Config.h), so
+ *   16 counters span 32 us to over half a second. Percentiles are reported
+ *   as the upper bound of the bucket they fall in, i.e. at most 2x high;
+ *   the exact maximum is kept separately.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+/*******************************************************************************
+ * CLASS: LatencyHistogram
+ ******************************************************************************/
+class LatencyHistogram {
+public:
+  /***************************************************************************
+   * CONSTRUCTOR
+   ***************************************************************************/
+  LatencyHistogram();
+
+  /***************************************************************************
+   * RECORDING
+   ***************************************************************************/
+  void record(uint32_t elapsedUs);
+  void reset();
+
+  /***************************************************************************
+   * RESULTS
+   *
+   * percentileUs(): upper bound of the bucket holding that percentile
+   * (capped at the maximum), 0 if nothing was recorded.
+   * bucketLimitUs(): exclusive upper bound of bucket i; the last bucket
+   * has none and returns 0.
+   ***************************************************************************/
+  uint32_t getCount() const { return _count; }
+  uint32_t getMaxUs() const { return _maxUs; }
+  uint32_t getBucket(uint8_t i) const { return _buckets[i]; }
+  uint32_t percentileUs(uint8_t percent) const;
+
+  static uint32_t bucketLimitUs(uint8_t i);
+
+private:
+  /***************************************************************************
+   * PRIVATE MEMBER VARIABLES
+   ***************************************************************************/
+  uint32_t _buckets[LATENCY_BUCKETS];
+  uint32_t _count;
+  uint32_t _maxUs;
+};
+
+#endif // LATENCYHISTOGRAM_H
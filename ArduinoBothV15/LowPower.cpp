@@ -0,0 +1,193 @@
+/*******************************************************************************
+ * LOWPOWER.CPP - Idle Sleep and ADC Noise Reduction Sampling Implementation
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "LowPower.h"
+#include "Hal.h"
+#include "OutputQueue.h"
+#include "FastFormat.h"
+
+#if defined(__AVR__)
+#include <avr/sleep.h>
+
+// Arduino core (wiring.c): the millis() counter
+extern volatile unsigned long timer0_millis;
+
+// Wake-up only; the work happens after sleep_cpu() returns
+EMPTY_INTERRUPT(ADC_vect);
+EMPTY_INTERRUPT(PCINT2_vect);
+#endif
+
+LowPower Power;
+
+/*******************************************************************************
+ * CONSTRUCTOR
+ ******************************************************************************/
+LowPower::LowPower()
+  : _lostUs(0)
+{
+  resetStats();
+  _resetMs = 0;   // Runs before init(): count from boot
+}
+
+/*******************************************************************************
+ * IDLE SLEEP
+ ******************************************************************************/
+void LowPower::idle() {
+#if LOW_POWER_IDLE
+  unsigned long start = halMicros();
+
+#if defined(__AVR__)
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  noInterrupts();
+  sleep_enable();
+  interrupts();   // sei + sleep: no interrupt can slip in between
+  sleep_cpu();
+  sleep_disable();
+#else
+  halDelay(1);    // Native build: wait one timer tick instead
+#endif
+
+  uint32_t slept = _idleUs + (halMicros() - start);
+  _idleMs += slept / 1000;
+  _idleUs = slept % 1000;
+#endif
+}
+
+/*******************************************************************************
+ * ADC NOISE REDUCTION SAMPLING
+ *
+ * Entering ADC sleep starts the conversion; the ADC interrupt ends the
+ * sleep. Any other wake-up (RX start bit, ...) finishes the conversion
+ * awake. Same channel and reference (AVcc) as analogRead().
+ *
+ * Only while the transmitter is idle: the sleep would freeze a frame on
+ * the TX line for a whole conversion. Otherwise a plain analogRead().
+ ******************************************************************************/
+uint16_t LowPower::quietAnalogRead(uint8_t pin) {
+#if defined(__AVR__) && ADC_NOISE_SLEEP
+  if (!_txIdle()) {
+    _adcAwake++;
+    return halAnalogRead(pin);
+  }
+
+  if (pin >= A0) {
+    pin -= A0;
+  }
+  ADMUX = _BV(REFS0) | (pin & 0x07);
+
+  noInterrupts();
+  ADCSRA |= _BV(ADIE) | _BV(ADIF);   // Writing ADIF clears a stale flag
+  PCMSK2 |= _BV(PCINT16);            // RXD (PD0)
+  PCICR |= _BV(PCIE2);
+  set_sleep_mode(SLEEP_MODE_ADC);
+  sleep_enable();
+  interrupts();
+  sleep_cpu();
+  sleep_disable();
+
+  PCICR &= ~_BV(PCIE2);
+  PCMSK2 &= ~_BV(PCINT16);
+  ADCSRA &= ~_BV(ADIE);
+  while (ADCSRA & _BV(ADSC)) {
+  }
+  uint16_t value = ADC;
+
+  // === KEEP millis() ON SCHEDULE ===
+  _adcSleeps++;
+  _lostUs += ADC_CONVERSION_US;
+  if (_lostUs >= 1000) {
+    noInterrupts();
+    timer0_millis += _lostUs / 1000;
+    interrupts();
+    _lostUs %= 1000;
+  }
+
+  return value;
+#else
+  return halAnalogRead(pin);
+#endif
+}
+
+#if defined(__AVR__)
+/*
+ * Nothing queued, HardwareSerial's ring empty and the last frame shifted
+ * out (TXC0 is cleared by every Serial.write and set once the shift
+ * register is empty)
+ */
+bool LowPower::_txIdle() {
+  return SerialOut.pending() == 0 &&
+         halSerialAvailableForWrite() >= SERIAL_TX_BUFFER_SIZE - 1 &&
+         (UCSR0A & _BV(TXC0));
+}
+#endif
+
+/*******************************************************************************
+ * STATISTICS
+ *
+ * Format:
+ *   POWER <ms since reset>
+ *   Sleep: idle ON, ADC ON
+ *   Awake: 4.2%
+ *   Idle: 94.1%
+ *   ADC sleep: 1.7%
+ *   ADC awake (TX busy): 12
+ *   Current (est): 3.34 mA
+ ******************************************************************************/
+void LowPower::printStats() {
+  uint32_t totalMs = halMillis() - _resetMs;
+
+  SerialOut.print(F("POWER "));
+  SerialOut.println(totalMs);
+
+  SerialOut.print(F("Sleep: idle "));
+  SerialOut.print(LOW_POWER_IDLE ? F("ON") : F("OFF"));
+  SerialOut.print(F(", ADC "));
+#if defined(__AVR__)
+  SerialOut.println(ADC_NOISE_SLEEP ? F("ON") : F("OFF"));
+#else
+  SerialOut.println(F("OFF"));
+#endif
+
+  if (totalMs == 0) {
+    return;
+  }
+
+  float adcMs = (float)_adcSleeps * ADC_CONVERSION_US / 1000.0;
+  float idleMs = _idleMs;
+  float awakeMs = max((float)totalMs - idleMs - adcMs, 0.0f);
+
+  SerialOut.print(F("Awake: "));
+  printFixed(SerialOut, awakeMs * 100.0 / totalMs, 1);
+  SerialOut.println('%');
+  SerialOut.print(F("Idle: "));
+  printFixed(SerialOut, idleMs * 100.0 / totalMs, 1);
+  SerialOut.println('%');
+  SerialOut.print(F("ADC sleep: "));
+  printFixed(SerialOut, adcMs * 100.0 / totalMs, 1);
+  SerialOut.println('%');
+  SerialOut.print(F("ADC awake (TX busy): "));
+  SerialOut.println(_adcAwake);
+
+  float currentUa = (awakeMs * POWER_ACTIVE_UA
+                     + idleMs * POWER_IDLE_UA
+                     + adcMs * POWER_ADC_SLEEP_UA) / totalMs;
+  SerialOut.print(F("Current (est): "));
+  printFixed(SerialOut, currentUa / 1000.0, 2);
+  SerialOut.println(F(" mA"));
+}
+
+void LowPower::resetStats() {
+  _idleMs = 0;
+  _idleUs = 0;
+  _adcSleeps = 0;
+  _adcAwake = 0;
+  _resetMs = halMillis();
+}
+
+/*******************************************************************************
+ * END OF LOW POWER IMPLEMENTATION
+ ******************************************************************************/
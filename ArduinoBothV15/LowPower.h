@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * LOWPOWER.H - Idle Sleep and ADC Noise Reduction Sampling
+ *
+ * Purpose:
+ *   Without this the CPU spins through loop() at 100% waiting for the next
+ *   sample or serial byte. For battery-powered units it now sleeps instead:
+ *
+ *   - idle(): Idle mode between scheduler passes. Timer0 (millis) and the
+ *     UART keep running; the next timer tick (≤1 ms) or a received byte
+ *     wakes it, so no deadline moves by more than a millisecond
+ *   - quietAnalogRead(): one conversion in ADC Noise Reduction mode. The
+ *     CPU and I/O clocks stop while the ADC converts, which lowers the
+ *     current and the conversion noise
+ *
+ * UART during ADC sleep:
+ *   The USART is clocked by clkIO, which ADC sleep stops.
+ *   - TX: a frame being shifted out would stall on the line for the whole
+ *     conversion and arrive corrupted, so the ADC sleeps only when the
+ *     transmitter is idle (output queue and TX ring empty, TXC0 set).
+ *     While a response is going out, samples use a plain analogRead()
+ *   - RX: a pin-change interrupt on RXD wakes the CPU on the start bit,
+ *     early enough for the receiver to catch the byte; that conversion
+ *     then finishes awake
+ *
+ * Time during ADC sleep:
+ *   Timer0 is stopped too. millis() is advanced by ADC_CONVERSION_US per
+ *   sleep so the schedule keeps its cadence; micros() is not (slightly
+ *   more when a conversion was finished awake).
+ *
+ * Statistics (POWER, POWER RESET):
+ *   Time awake, in Idle and in ADC sleep, and a current estimate from the
+ *   datasheet figures in Config.h. On non-AVR builds nothing sleeps.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef LOWPOWER_H
+#define LOWPOWER_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+/*******************************************************************************
+ * CLASS: LowPower
+ ******************************************************************************/
+class LowPower {
+public:
+  /***************************************************************************
+   * CONSTRUCTOR
+   ***************************************************************************/
+  LowPower();
+
+  /***************************************************************************
+   * SLEEP
+   *
+   * idle(): sleep until the next interrupt (returns at once if
+   * LOW_POWER_IDLE is 0).
+   * quietAnalogRead(): same result as analogRead(pin); sleeps during the
+   * conversion if ADC_NOISE_SLEEP is 1.
+   ***************************************************************************/
+  void idle();
+  uint16_t quietAnalogRead(uint8_t pin);
+
+  /***************************************************************************
+   * STATISTICS (POWER, POWER RESET)
+   ***************************************************************************/
+  void printStats();
+  void resetStats();
+
+private:
+  /***************************************************************************
+   * PRIVATE MEMBER VARIABLES
+   ***************************************************************************/
+  uint32_t      _idleMs;        // Time in Idle sleep
+  uint16_t      _idleUs;        // Remainder below 1 ms
+  uint32_t      _adcSleeps;     // Conversions done in ADC sleep
+  uint32_t      _adcAwake;      // Done awake because TX was busy
+  uint16_t      _lostUs;        // ADC sleep time not yet added to millis()
+  unsigned long _resetMs;       // millis() of the last reset
+
+  /***************************************************************************
+   * PRIVATE HELPER METHODS
+   ***************************************************************************/
+#if defined(__AVR__)
+  bool _txIdle();
+#endif
+};
+
+extern LowPower Power;
+
+#endif // LOWPOWER_H
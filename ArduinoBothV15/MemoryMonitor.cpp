@@ -0,0 +1,102 @@
+/*******************************************************************************
+ * MEMORYMONITOR.CPP - SRAM Heap and Stack Usage Implementation
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "MemoryMonitor.h"
+
+#if defined(__AVR__)
+
+/*******************************************************************************
+ * AVR-LIBC ALLOCATOR STATE
+ *
+ * __heap_start: first byte after .bss/.noinit
+ * __brkval:     current heap top (0 until the first malloc)
+ * __flp:        free list, sz = usable bytes after the 2-byte size header
+ ******************************************************************************/
+struct __freelist {
+  size_t sz;
+  struct __freelist* nx;
+};
+
+extern uint8_t __heap_start;
+extern char* __brkval;
+extern struct __freelist* __flp;
+extern size_t __malloc_margin;
+
+/*******************************************************************************
+ * STACK PAINTING
+ *
+ * Runs from .init3: the stack pointer is set up and r1 cleared, but no
+ * constructor or setup() has used the stack yet. naked = no prologue,
+ * so nothing of ours sits in the area being painted.
+ ******************************************************************************/
+void _memoryPaint() __attribute__((naked, used, section(".init3")));
+
+void _memoryPaint() {
+  uint8_t* p = &__heap_start;
+  uint8_t* top = (uint8_t*)SP;
+
+  while (p < top) {
+    *p++ = STACK_CANARY;
+  }
+}
+
+/*******************************************************************************
+ * STATISTICS
+ ******************************************************************************/
+bool readMemoryStats(MemoryStats& stats) {
+  uint8_t* heapTop = __brkval ? (uint8_t*)__brkval : &__heap_start;
+  uint8_t* stackPointer = (uint8_t*)SP;
+
+  // === HEAP ===
+  uint16_t gap = stackPointer - heapTop;
+  uint16_t largest = (gap > __malloc_margin + sizeof(size_t))
+                     ? gap - __malloc_margin - sizeof(size_t) : 0;
+  uint16_t freeListBytes = 0;
+  uint8_t fragments = 0;
+
+  for (struct __freelist* block = __flp; block; block = block->nx) {
+    freeListBytes += block->sz + sizeof(size_t);
+    if (block->sz > largest) {
+      largest = block->sz;
+    }
+    if (fragments < 0xFF) {
+      fragments++;
+    }
+  }
+
+  stats.heapFree = gap + freeListBytes;
+  stats.largestBlock = largest;
+  stats.fragments = fragments;
+
+  // === STACK ===
+  // First byte above the heap that lost its paint = deepest stack use
+  uint8_t* p = heapTop;
+  while (p < stackPointer && *p == STACK_CANARY) {
+    p++;
+  }
+
+  stats.stackHeadroom = p - heapTop;
+  stats.stackPeak = (uint8_t*)RAMEND - p + 1;
+  return true;
+}
+
+#else
+
+bool readMemoryStats(MemoryStats& stats) {
+  stats.heapFree = 0;
+  stats.largestBlock = 0;
+  stats.fragments = 0;
+  stats.stackPeak = 0;
+  stats.stackHeadroom = 0;
+  return false;
+}
+
+#endif // __AVR__
+
+/*******************************************************************************
+ * END OF MEMORY MONITOR IMPLEMENTATION
+ ******************************************************************************/
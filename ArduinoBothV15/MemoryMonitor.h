@@ -0,0 +1,50 @@
+/*******************************************************************************
+ * MEMORYMONITOR.H - SRAM Heap and Stack Usage
+ *
+ * Purpose:
+ *   The commands build Arduino Strings on a 2 KB heap that shares its
+ *   space with the stack. Running out shows up only as random resets, so
+ *   MEM, DIAG and STATUS_COMPACT report how close the firmware gets.
+ *
+ * How it works:
+ *   - At boot, before any constructor runs, the whole gap between the end
+ *     of the static data and the stack is painted with STACK_CANARY
+ *   - The stack peak is the highest address above the heap where the
+ *     paint is gone. It never shrinks until the next reset
+ *   - Heap figures come from the avr-libc allocator: the gap between the
+ *     heap top and the current stack pointer, plus the free list (holes
+ *     left by freed Strings)
+ *
+ * Limits:
+ *   Heap that grew and was given back again counts as stack use, and a
+ *   stack byte that happens to equal STACK_CANARY reads as untouched.
+ *   On non-AVR builds there are no figures.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef MEMORYMONITOR_H
+#define MEMORYMONITOR_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+/*******************************************************************************
+ * MEMORY STATISTICS (all in bytes)
+ ******************************************************************************/
+struct MemoryStats {
+  uint16_t heapFree;        // Gap below the stack + free list
+  uint16_t largestBlock;    // Biggest single malloc() that would succeed
+  uint8_t  fragments;       // Free-list entries
+  uint16_t stackPeak;       // Deepest stack use since reset
+  uint16_t stackHeadroom;   // Never-touched bytes between heap and stack
+};
+
+/*
+ * Take a snapshot of the current figures. Returns false (all 0) on
+ * builds without the AVR allocator.
+ */
+bool readMemoryStats(MemoryStats& stats);
+
+#endif // MEMORYMONITOR_H
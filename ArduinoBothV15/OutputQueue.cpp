@@ -0,0 +1,177 @@
+/*******************************************************************************
+ * OUTPUTQUEUE.CPP - TX-Backpressure-Aware Serial Output Implementation
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "OutputQueue.h"
+#include "Hal.h"
+#include "Perf.h"
+
+OutputQueue SerialOut;
+
+/*******************************************************************************
+ * CONSTRUCTOR
+ ******************************************************************************/
+OutputQueue::OutputQueue()
+  : _head(0),
+    _tail(0),
+    _count(0),
+    _highWater(0),
+    _stalls(0),
+    _tag(NULL),
+    _lineStart(true),
+    _linePos(0),
+    _errorLine(false),
+    _errorSeen(false)
+{
+}
+
+/*******************************************************************************
+ * PRINT INTERFACE
+ ******************************************************************************/
+
+size_t OutputQueue::write(uint8_t c) {
+  if (_tag != NULL) {
+    _tagged(c);
+    return 1;
+  }
+  return _send(c);
+}
+
+size_t OutputQueue::write(const uint8_t* buffer, size_t size) {
+  size_t written = 0;
+
+  if (_tag != NULL) {
+    while (written < size) {
+      _tagged(buffer[written++]);
+    }
+    return size;
+  }
+
+  // Fast path: hand the UART as much as it can take without blocking
+  if (_count == 0) {
+    int room = halSerialAvailableForWrite();
+    if (room > 0) {
+      size_t direct = ((size_t)room < size) ? (size_t)room : size;
+      written = halSerialWrite(buffer, direct);
+    }
+  }
+
+  // Queue the rest
+  while (written < size) {
+    _push(buffer[written++]);
+  }
+
+  return size;
+}
+
+/*******************************************************************************
+ * TAGGED RESPONSES
+ ******************************************************************************/
+
+void OutputQueue::beginResponse(const char* tag) {
+  _tag = tag;
+  _lineStart = true;
+  _errorSeen = false;
+}
+
+bool OutputQueue::endResponse() {
+  _tag = NULL;
+  return _errorSeen;
+}
+
+/*******************************************************************************
+ * DRAINING
+ ******************************************************************************/
+
+void OutputQueue::drain() {
+  if (_count == 0) {
+    return;   // Idle passes would swamp the SERIAL_TX probe
+  }
+
+  PERF_SCOPE(PERF_SERIAL_TX);
+  int room = halSerialAvailableForWrite();
+
+  while (room > 0 && _count > 0) {
+    halSerialWrite(_buffer[_tail]);
+    _tail = (_tail + 1) % OUTPUT_QUEUE_SIZE;
+    _count--;
+    room--;
+  }
+}
+
+void OutputQueue::flush() {
+  while (_count > 0) {
+    drain();
+  }
+  halSerialFlush();
+}
+
+/*******************************************************************************
+ * PRIVATE HELPER METHODS
+ ******************************************************************************/
+
+size_t OutputQueue::_send(uint8_t c) {
+  // Fast path: nothing queued and the UART has room
+  if (_count == 0 && halSerialAvailableForWrite() > 0) {
+    return halSerialWrite(c);
+  }
+
+  _push(c);
+  return 1;
+}
+
+void OutputQueue::_tagged(uint8_t c) {
+  static const char ERROR_PREFIX[] = "ERR";
+
+  if (_lineStart) {
+    _send('#');
+    for (const char* p = _tag; *p; p++) {
+      _send(*p);
+    }
+    _send(' ');
+    _lineStart = false;
+    _linePos = 0;
+    _errorLine = true;
+  }
+
+  if (_linePos < sizeof(ERROR_PREFIX) - 1) {
+    if (c != ERROR_PREFIX[_linePos]) {
+      _errorLine = false;
+    }
+    _linePos++;
+    if (_linePos == sizeof(ERROR_PREFIX) - 1 && _errorLine) {
+      _errorSeen = true;
+    }
+  }
+
+  _send(c);
+
+  if (c == '\n') {
+    _lineStart = true;
+  }
+}
+
+void OutputQueue::_push(uint8_t c) {
+  if (_count == OUTPUT_QUEUE_SIZE) {
+    // Response larger than the queue: wait for the UART like Serial does
+    _stalls++;
+    while (_count == OUTPUT_QUEUE_SIZE) {
+      drain();
+    }
+  }
+
+  _buffer[_head] = c;
+  _head = (_head + 1) % OUTPUT_QUEUE_SIZE;
+  _count++;
+
+  if (_count > _highWater) {
+    _highWater = _count;
+  }
+}
+
+/*******************************************************************************
+ * END OF OUTPUTQUEUE IMPLEMENTATION
+ ******************************************************************************/
@@ -0,0 +1,109 @@
+/*******************************************************************************
+ * OUTPUTQUEUE.H - TX-Backpressure-Aware Serial Output
+ *
+ * Purpose:
+ *   Print target that never blocks on a full HardwareSerial TX buffer as
+ *   long as there is room in its own bounded queue. All firmware output
+ *   goes through the global SerialOut instead of Serial directly.
+ *
+ * How it works:
+ *   - write() sends straight to Serial while Serial.availableForWrite()
+ *     has room and nothing is queued (keeps byte order intact)
+ *   - Everything else goes into a ring buffer (OUTPUT_QUEUE_SIZE bytes)
+ *   - loop() calls drain(), which moves only as many bytes as the UART
+ *     can take right now, so sampling and command RX keep running
+ *   - If a single response outgrows the queue, write() falls back to
+ *     waiting for the UART (same as plain Serial.print) and counts a stall
+ *
+ * Tagged responses:
+ *   Between beginResponse(tag) and endResponse() every output line is
+ *   prefixed with "#<tag> ", and lines starting with "ERR" (ERR:/ERROR:)
+ *   are remembered so the caller can close with OK or ERR.
+ *
+ * Does NOT handle:
+ *   - Serial input (see CommandQueue)
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef OUTPUTQUEUE_H
+#define OUTPUTQUEUE_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+/*******************************************************************************
+ * CLASS: OutputQueue
+ ******************************************************************************/
+class OutputQueue : public Print {
+public:
+  /***************************************************************************
+   * CONSTRUCTOR
+   ***************************************************************************/
+  OutputQueue();
+
+  /***************************************************************************
+   * PRINT INTERFACE
+   ***************************************************************************/
+  virtual size_t write(uint8_t c);
+  virtual size_t write(const uint8_t* buffer, size_t size);
+  using Print::write;
+
+  /***************************************************************************
+   * DRAINING
+   *
+   * drain() - non-blocking, moves what the UART can take right now
+   * flush() - blocking, empties the queue completely
+   ***************************************************************************/
+  void drain();
+  void flush();
+
+  /***************************************************************************
+   * TAGGED RESPONSES
+   *
+   * tag must stay valid until endResponse().
+   * endResponse() returns true if an error line was printed.
+   ***************************************************************************/
+  void beginResponse(const char* tag);
+  bool endResponse();
+
+  /***************************************************************************
+   * STATUS
+   ***************************************************************************/
+  uint16_t pending() const { return _count; }
+  uint16_t getHighWater() const { return _highWater; }
+  uint16_t getStallCount() const { return _stalls; }
+
+private:
+  /***************************************************************************
+   * PRIVATE MEMBER VARIABLES
+   ***************************************************************************/
+  uint8_t  _buffer[OUTPUT_QUEUE_SIZE];
+  uint16_t _head;       // Next write position
+  uint16_t _tail;       // Next byte to send
+  uint16_t _count;      // Bytes queued
+  uint16_t _highWater;  // Maximum bytes queued since boot
+  uint16_t _stalls;     // Times the queue was full and write() had to wait
+
+  // Tagged response state
+  const char* _tag;     // NULL = untagged output
+  bool     _lineStart;  // Next byte starts a new line
+  uint8_t  _linePos;    // Bytes seen in current line (saturates)
+  bool     _errorLine;  // Current line matches "ERR" so far
+  bool     _errorSeen;  // An error line was printed in this response
+
+  /***************************************************************************
+   * PRIVATE HELPER METHODS
+   ***************************************************************************/
+  size_t _send(uint8_t c);
+  void _tagged(uint8_t c);
+  void _push(uint8_t c);
+};
+
+/*******************************************************************************
+ * GLOBAL INSTANCE
+ ******************************************************************************/
+extern OutputQueue SerialOut;
+
+#endif // OUTPUTQUEUE_H
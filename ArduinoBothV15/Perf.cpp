@@ -0,0 +1,116 @@
+/*******************************************************************************
+ * PERF.CPP - Lightweight Timing Probes Implementation
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "Perf.h"
+
+#if PERF_PROBES
+
+#include "OutputQueue.h"
+
+PerfCounters Perf;
+
+/*******************************************************************************
+ * PROBE NAMES (PerfProbe order)
+ ******************************************************************************/
+static const char PERF_NAME_READ[]      PROGMEM = "READ_VOLTAGE";
+static const char PERF_NAME_FIT_ECL[]   PROGMEM = "FIT_EC_LOW";
+static const char PERF_NAME_FIT_ECH[]   PROGMEM = "FIT_EC_HIGH";
+static const char PERF_NAME_FIT_PH[]    PROGMEM = "FIT_PH";
+static const char PERF_NAME_FIT_TEMP[]  PROGMEM = "FIT_TEMP";
+static const char PERF_NAME_COMMAND[]   PROGMEM = "COMMAND";
+static const char PERF_NAME_SAVE[]      PROGMEM = "EEPROM_SAVE";
+static const char PERF_NAME_LOAD[]      PROGMEM = "EEPROM_LOAD";
+static const char PERF_NAME_TX[]        PROGMEM = "SERIAL_TX";
+
+static const char* const PERF_NAMES[PERF_PROBE_COUNT] PROGMEM = {
+  PERF_NAME_READ,
+  PERF_NAME_FIT_ECL,
+  PERF_NAME_FIT_ECH,
+  PERF_NAME_FIT_PH,
+  PERF_NAME_FIT_TEMP,
+  PERF_NAME_COMMAND,
+  PERF_NAME_SAVE,
+  PERF_NAME_LOAD,
+  PERF_NAME_TX
+};
+
+/*******************************************************************************
+ * CONSTRUCTOR
+ ******************************************************************************/
+PerfCounters::PerfCounters() {
+  reset();
+  _resetMs = 0;   // Runs before init(): count from boot
+}
+
+/*******************************************************************************
+ * RECORDING
+ ******************************************************************************/
+void PerfCounters::record(uint8_t probe, uint32_t elapsedUs) {
+  Counter& counter = _counters[probe];
+
+  counter.count++;
+  counter.totalUs += elapsedUs;
+  if (elapsedUs < counter.minUs) {
+    counter.minUs = elapsedUs;
+  }
+  if (elapsedUs > counter.maxUs) {
+    counter.maxUs = elapsedUs;
+  }
+}
+
+/*******************************************************************************
+ * OUTPUT
+ *
+ * Format (probes that never ran print 0 everywhere):
+ *   PERF <probes> <ms since reset>
+ *   PROBE,COUNT,MIN_US,AVG_US,MAX_US,TOTAL_US
+ *   EEPROM_SAVE,2,61844,346120,630396,692240
+ *   ...
+ *   PERF END
+ ******************************************************************************/
+void PerfCounters::print() {
+  SerialOut.print(F("PERF "));
+  SerialOut.print(PERF_PROBE_COUNT);
+  SerialOut.print(' ');
+  SerialOut.println(halMillis() - _resetMs);
+  SerialOut.println(F("PROBE,COUNT,MIN_US,AVG_US,MAX_US,TOTAL_US"));
+
+  for (uint8_t i = 0; i < PERF_PROBE_COUNT; i++) {
+    const Counter& counter = _counters[i];
+    bool ran = counter.count > 0;
+
+    SerialOut.print((const __FlashStringHelper*)pgm_read_ptr(&PERF_NAMES[i]));
+    SerialOut.print(',');
+    SerialOut.print(counter.count);
+    SerialOut.print(',');
+    SerialOut.print(ran ? counter.minUs : 0);
+    SerialOut.print(',');
+    SerialOut.print(ran ? counter.totalUs / counter.count : 0);
+    SerialOut.print(',');
+    SerialOut.print(counter.maxUs);
+    SerialOut.print(',');
+    SerialOut.println(counter.totalUs);
+  }
+
+  SerialOut.println(F("PERF END"));
+}
+
+void PerfCounters::reset() {
+  for (uint8_t i = 0; i < PERF_PROBE_COUNT; i++) {
+    _counters[i].count = 0;
+    _counters[i].minUs = 0xFFFFFFFF;
+    _counters[i].maxUs = 0;
+    _counters[i].totalUs = 0;
+  }
+  _resetMs = halMillis();
+}
+
+#endif // PERF_PROBES
+
+/*******************************************************************************
+ * END OF PERF IMPLEMENTATION
+ ******************************************************************************/
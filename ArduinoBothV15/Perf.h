@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * PERF.H - Lightweight Timing Probes for the Firmware Hot Paths
+ *
+ * Purpose:
+ *   Shows where firmware time goes. A probe is one line at the top of a
+ *   function or block:
+ *
+ *     PERF_SCOPE(PERF_EEPROM_SAVE);
+ *
+ *   It times the rest of the enclosing scope with micros() and adds the
+ *   result to that probe's count, min, max and total. PERF prints all
+ *   probes, PERF RESET clears them.
+ *
+ * Cost:
+ *   Two micros() calls per probe hit (about 10 µs, resolution 4 µs at
+ *   16 MHz) and PERF_PROBE_COUNT × 16 bytes of RAM. With PERF_PROBES 0 in
+ *   Config.h PERF_SCOPE expands to nothing and no counters exist.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef PERF_H
+#define PERF_H
+
+#include <Arduino.h>
+#include "Config.h"
+#include "Hal.h"
+
+/*******************************************************************************
+ * PROBE IDS (order = PERF output order)
+ ******************************************************************************/
+enum PerfProbe {
+  PERF_READ_VOLTAGE,      // SensorReader::readVoltage_*()
+  PERF_FIT_EC_LOW,        // Calibration::_calculate*Equation()
+  PERF_FIT_EC_HIGH,
+  PERF_FIT_PH,
+  PERF_FIT_TEMP,
+  PERF_COMMAND,           // Command dispatch, incl. the handler
+  PERF_EEPROM_SAVE,       // EEPROMManager::save()
+  PERF_EEPROM_LOAD,       // EEPROMManager::load()
+  PERF_SERIAL_TX,         // OutputQueue::drain()
+  PERF_PROBE_COUNT
+};
+
+#if PERF_PROBES
+
+/*******************************************************************************
+ * CLASS: PerfCounters
+ ******************************************************************************/
+class PerfCounters {
+public:
+  /***************************************************************************
+   * CONSTRUCTOR
+   ***************************************************************************/
+  PerfCounters();
+
+  /***************************************************************************
+   * RECORDING (called by PerfScope)
+   ***************************************************************************/
+  void record(uint8_t probe, uint32_t elapsedUs);
+
+  /***************************************************************************
+   * OUTPUT (PERF, PERF RESET)
+   ***************************************************************************/
+  void print();
+  void reset();
+
+private:
+  /***************************************************************************
+   * PRIVATE MEMBER VARIABLES
+   ***************************************************************************/
+  struct Counter {
+    uint32_t count;
+    uint32_t minUs;
+    uint32_t maxUs;
+    uint32_t totalUs;   // Wraps after ~71 minutes inside one probe
+  };
+  Counter _counters[PERF_PROBE_COUNT];
+  unsigned long _resetMs;   // millis() of the last reset
+};
+
+extern PerfCounters Perf;
+
+/*
+ * Times its own lifetime: constructed by PERF_SCOPE, recorded when the
+ * enclosing scope is left (on every return path).
+ */
+class PerfScope {
+public:
+  PerfScope(uint8_t probe) : _probe(probe), _start(halMicros()) {}
+  ~PerfScope() { Perf.record(_probe, halMicros() - _start); }
+
+private:
+  uint8_t  _probe;
+  uint32_t _start;
+};
+
+#define PERF_SCOPE(probe) PerfScope _perfScope(probe)
+
+#else
+
+#define PERF_SCOPE(probe) do { } while (0)
+
+#endif // PERF_PROBES
+
+#endif // PERF_H
@@ -0,0 +1,170 @@
+/*******************************************************************************
+ * SCHEDULER.CPP - Cooperative millis()-Based Task Scheduler Implementation
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "Scheduler.h"
+#include "Hal.h"
+#include "OutputQueue.h"
+#include "FastFormat.h"
+#include "Watchdog.h"
+
+/*******************************************************************************
+ * CONSTRUCTOR
+ ******************************************************************************/
+Scheduler::Scheduler(const SchedulerTask tasks[], uint8_t count)
+  : _tasks(tasks),
+    _count(min(count, SCHEDULER_MAX_TASKS)),
+    _statsStart(0)
+{
+}
+
+/*******************************************************************************
+ * INITIALIZATION
+ ******************************************************************************/
+void Scheduler::begin() {
+  unsigned long now = halMillis();
+  for (uint8_t i = 0; i < _count; i++) {
+    _state[i].release = now;
+  }
+  resetStats();
+}
+
+/*******************************************************************************
+ * EXECUTION
+ *
+ * Times are compared with wrap-around arithmetic, so the schedule keeps
+ * working when millis() rolls over (every 49.7 days).
+ ******************************************************************************/
+void Scheduler::run() {
+  for (uint8_t i = 0; i < _count; i++) {
+    TaskState& state = _state[i];
+
+    if ((long)(halMillis() - state.release) < 0) {
+      continue;
+    }
+
+    SchedulerTask task;
+    memcpy_P(&task, &_tasks[i], sizeof(task));
+
+    watchdogSetTask(i);
+    unsigned long start = halMicros();
+    task.run();
+    unsigned long elapsed = halMicros() - start;
+    watchdogSetTask(WATCHDOG_NO_TASK);
+    unsigned long finish = halMillis();
+
+    state.runs++;
+    if (elapsed > state.maxRunUs) {
+      state.maxRunUs = elapsed;
+    }
+    if (finish - state.release > task.deadlineMs && state.overruns != 0xFFFF) {
+      state.overruns++;
+    }
+
+    // === NEXT RELEASE ===
+    if (task.periodMs == 0) {
+      state.release = finish;
+      continue;
+    }
+
+    state.release += task.periodMs;
+    if ((long)(finish - state.release) >= 0) {
+      // A whole period late: drop the missed releases instead of
+      // bunching them up, the next one is in the future again
+      uint16_t lost = (finish - state.release) / task.periodMs + 1;
+      state.release += (unsigned long)lost * task.periodMs;
+      state.skipped = (state.skipped > 0xFFFF - lost) ? 0xFFFF : state.skipped + lost;
+    }
+  }
+
+  watchdogFeed();
+}
+
+unsigned long Scheduler::msUntilNextRelease() const {
+  unsigned long now = halMillis();
+  unsigned long next = 0xFFFFFFFF;
+
+  for (uint8_t i = 0; i < _count; i++) {
+    if (pgm_read_word(&_tasks[i].periodMs) == 0) {
+      continue;
+    }
+    long wait = (long)(_state[i].release - now);
+    if (wait <= 0) {
+      return 0;
+    }
+    if ((unsigned long)wait < next) {
+      next = wait;
+    }
+  }
+  return next;
+}
+
+/*******************************************************************************
+ * STATISTICS
+ *
+ * Format (one line per task, table order):
+ *   TASKS <count> <ms since reset>
+ *   TASK,PERIOD_MS,DEADLINE_MS,RUNS,AVG_PERIOD_MS,OVERRUNS,SKIPPED,MAX_US
+ *   PH,20,20,1502,20.0,0,0,148
+ *
+ * AVG_PERIOD_MS is the achieved cadence (time since reset / runs).
+ *   ...
+ *   TASKS END
+ ******************************************************************************/
+void Scheduler::printStats() {
+  unsigned long elapsed = halMillis() - _statsStart;
+
+  SerialOut.print(F("TASKS "));
+  SerialOut.print(_count);
+  SerialOut.print(' ');
+  SerialOut.println(elapsed);
+  SerialOut.println(F("TASK,PERIOD_MS,DEADLINE_MS,RUNS,AVG_PERIOD_MS,OVERRUNS,SKIPPED,MAX_US"));
+
+  for (uint8_t i = 0; i < _count; i++) {
+    SchedulerTask task;
+    memcpy_P(&task, &_tasks[i], sizeof(task));
+    const TaskState& state = _state[i];
+
+    SerialOut.print((const __FlashStringHelper*)task.name);
+    SerialOut.print(',');
+    SerialOut.print(task.periodMs);
+    SerialOut.print(',');
+    SerialOut.print(task.deadlineMs);
+    SerialOut.print(',');
+    SerialOut.print(state.runs);
+    SerialOut.print(',');
+    printFixed(SerialOut, state.runs ? (float)elapsed / state.runs : 0.0, 1);
+    SerialOut.print(',');
+    SerialOut.print(state.overruns);
+    SerialOut.print(',');
+    SerialOut.print(state.skipped);
+    SerialOut.print(',');
+    SerialOut.println(state.maxRunUs);
+  }
+
+  SerialOut.println(F("TASKS END"));
+}
+
+const __FlashStringHelper* Scheduler::getTaskName(uint8_t task) const {
+  if (task >= _count) {
+    return NULL;
+  }
+  return (const __FlashStringHelper*)pgm_read_ptr(&_tasks[task].name);
+}
+
+void Scheduler::resetStats() {
+  for (uint8_t i = 0; i < _count; i++) {
+    _state[i].runs = 0;
+    _state[i].overruns = 0;
+    _state[i].skipped = 0;
+    _state[i].maxRunUs = 0;
+  }
+  _statsStart = halMillis();
+}
+
+/*******************************************************************************
+ * END OF SCHEDULER IMPLEMENTATION
+ ******************************************************************************/
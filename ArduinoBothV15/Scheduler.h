@@ -0,0 +1,112 @@
+/*******************************************************************************
+ * SCHEDULER.H - Cooperative millis()-Based Task Scheduler
+ *
+ * Purpose:
+ *   Runs the main loop as a static table of tasks (sampling per channel,
+ *   filtering, command RX/execution, TX drain, housekeeping), each with
+ *   its own period and deadline, instead of doing all the work inside
+ *   command handlers. Sampling then happens at a fixed cadence whatever
+ *   the host is sending.
+ *
+ * How it works:
+ *   - run() is called from loop() and walks the table in order (= priority)
+ *   - A task is due once millis() reaches its release time; it runs to
+ *     completion (cooperative, no preemption)
+ *   - The next release is one period after the previous one, so the
+ *     cadence does not drift with the task's own run time. Releases a
+ *     whole period late are dropped instead of run back to back
+ *   - Period 0 = run on every pass; such a task is released again as soon
+ *     as it finishes
+ *
+ * Watchdog:
+ *   Each task's index is recorded (watchdogSetTask) while it runs, and
+ *   the watchdog is fed after every pass, so a task that hangs resets the
+ *   board and is named on the next boot.
+ *
+ * Statistics (per task, since begin() or resetStats()):
+ *   runs, achieved average period, overruns (finished later than
+ *   release + deadline), skipped releases and the longest single run in
+ *   microseconds
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+typedef void (*TaskFunction)();
+
+/*******************************************************************************
+ * TASK TABLE ENTRY
+ *
+ * The sketch keeps the table in PROGMEM; the scheduler keeps the run
+ * state and statistics of each entry in RAM (at most SCHEDULER_MAX_TASKS).
+ ******************************************************************************/
+struct SchedulerTask {
+  const char*   name;       // PROGMEM string, for TASKS
+  TaskFunction  run;
+  uint16_t      periodMs;   // 0 = every pass
+  uint16_t      deadlineMs; // Must finish this long after its release
+};
+
+/*******************************************************************************
+ * CLASS: Scheduler
+ ******************************************************************************/
+class Scheduler {
+public:
+  /***************************************************************************
+   * CONSTRUCTOR & INITIALIZATION
+   *
+   * begin() releases every task now and clears the statistics.
+   ***************************************************************************/
+  Scheduler(const SchedulerTask tasks[], uint8_t count);
+  void begin();
+
+  /***************************************************************************
+   * EXECUTION
+   *
+   * One pass over the table: runs every task that is due.
+   ***************************************************************************/
+  void run();
+
+  /*
+   * Milliseconds until the next timed (period > 0) task is due; 0 if one
+   * is due now. Lets loop() sleep between releases.
+   */
+  unsigned long msUntilNextRelease() const;
+
+  /***************************************************************************
+   * STATISTICS (TASKS, TASKS RESET)
+   ***************************************************************************/
+  void printStats();
+  void resetStats();
+
+  /*
+   * Table access for reports (PROGMEM name; NULL if out of range).
+   */
+  uint8_t getTaskCount() const { return _count; }
+  const __FlashStringHelper* getTaskName(uint8_t task) const;
+
+private:
+  /***************************************************************************
+   * PRIVATE MEMBER VARIABLES
+   ***************************************************************************/
+  const SchedulerTask* _tasks;   // PROGMEM
+  uint8_t              _count;
+  unsigned long        _statsStart;   // millis() of the last reset
+
+  struct TaskState {
+    unsigned long release;    // millis() of the next release
+    uint32_t      runs;
+    uint16_t      overruns;   // Finished after release + deadline
+    uint16_t      skipped;    // Releases dropped (loop a period behind)
+    uint32_t      maxRunUs;   // Longest single run
+  };
+  TaskState _state[SCHEDULER_MAX_TASKS];
+};
+
+#endif // SCHEDULER_H
@@ -18,6 +18,9 @@
  ******************************************************************************/
 
 #include "SensorReader.h"
+#include "Hal.h"
+#include "Perf.h"
+#include "LowPower.h"
 
 /*******************************************************************************
  * CONSTRUCTOR
@@ -28,27 +31,33 @@ SensorReader::SensorReader(uint8_t ecPin, uint8_t tempPin, uint8_t pHPin)
     _pHPin(pHPin),
     _lastEC(0.0),
     _lastTemp(0.0),
-    _lastpH(0.0)
+    _lastpH(0.0),
+    _tempVoltage(0.0),
+    _filterAlpha(FILTER_ALPHA),
+    _settleStart(0),
+    _seeded(false),
+    _firstReadingMs(0)
 {
+  _ecWindow.sum = 0;
+  _ecWindow.count = 0;
+  _tempWindow = _ecWindow;
+  _pHWindow = _ecWindow;
 }
 
 /*******************************************************************************
  * INITIALIZATION
+ * 
+ * Does not block: the settling time runs in parallel with the rest of
+ * setup() (EEPROM load, banner). Background sampling starts once the
+ * sensors have settled and its first windows seed the filters.
  ******************************************************************************/
 void SensorReader::begin() {
-  pinMode(_ecPin, INPUT);
-  pinMode(_tempPin, INPUT);
-  pinMode(_pHPin, INPUT);
-  
-  // Seed filters with initial readings
-  _lastEC = _adcToMillivolts(analogRead(_ecPin));
-  
-  float tempVoltage = _adcToMillivolts(analogRead(_tempPin));
-  _lastTemp = (tempVoltage / 1000.0 - TEMP_OFFSET_V) * TEMP_SCALE;
-  
-  _lastpH = _adcToMillivolts(analogRead(_pHPin));
+  halAnalogInit(_ecPin);
+  halAnalogInit(_tempPin);
+  halAnalogInit(_pHPin);
   
-  delay(100);
+  _settleStart = halMillis();
+  _seeded = false;
 }
 
 /*******************************************************************************
@@ -56,69 +65,93 @@ void SensorReader::begin() {
  ******************************************************************************/
 
 uint16_t SensorReader::readRawADC_EC() {
-  return analogRead(_ecPin);
+  return halAnalogRead(_ecPin);
 }
 
 uint16_t SensorReader::readRawADC_Temp() {
-  return analogRead(_tempPin);
+  return halAnalogRead(_tempPin);
 }
 
 uint16_t SensorReader::readRawADC_pH() {
-  return analogRead(_pHPin);
+  return halAnalogRead(_pHPin);
 }
 
 /*******************************************************************************
- * VOLTAGE READING METHODS
+ * BACKGROUND SAMPLING
+ * 
+ * The scheduler calls sample*() every EC/TEMP/PH_SAMPLE_PERIOD_MS and
+ * updateFilters() every FILTER_PERIOD_MS, so each window holds about
+ * EC/TEMP/PH_SAMPLE_COUNT samples spread evenly over the period (the
+ * same averaging the blocking reads used to do with delay() in between).
  ******************************************************************************/
 
-float SensorReader::readVoltage_EC() {
-  float sum = 0.0;
+void SensorReader::sampleEC() {
+  _addSample(_ecWindow, _ecPin);
+}
+
+void SensorReader::sampleTemp() {
+  _addSample(_tempWindow, _tempPin);
+}
+
+void SensorReader::samplepH() {
+  _addSample(_pHWindow, _pHPin);
+}
+
+/*
+ * Close the windows: average, filter, start new ones. The first complete
+ * set of windows seeds the filters (unless a read already did).
+ */
+void SensorReader::updateFilters() {
+  float ec = 0, temp = 0, pH = 0;
+  bool haveEC = _takeAverage(_ecWindow, ec);
+  bool haveTemp = _takeAverage(_tempWindow, temp);
+  bool havepH = _takeAverage(_pHWindow, pH);
   
-  for (uint8_t i = 0; i < EC_SAMPLE_COUNT; i++) {
-    uint16_t adcValue = analogRead(_ecPin);
-    sum += _adcToMillivolts(adcValue);
-    if (i < EC_SAMPLE_COUNT - 1) {
-      delay(1);
+  if (!_seeded) {
+    if (!haveEC || !haveTemp || !havepH) {
+      return;
     }
+    _lastEC = ec;
+    _tempVoltage = temp;
+    _lastTemp = _millivoltsToCelsius(temp);
+    _lastpH = pH;
+    _seeded = true;
+    _markReading();
+    return;
   }
   
-  float voltage = sum / EC_SAMPLE_COUNT;
-  voltage = _applyFilter(voltage, _lastEC);
-  _lastEC = voltage;
-  
-  return voltage;
+  if (haveEC) {
+    _lastEC = _applyFilter(ec, _lastEC);
+  }
+  if (haveTemp) {
+    _tempVoltage = temp;
+    _lastTemp = _applyFilter(_millivoltsToCelsius(temp), _lastTemp);
+  }
+  if (havepH) {
+    _lastpH = _applyFilter(pH, _lastpH);
+  }
+}
+
+/*******************************************************************************
+ * VOLTAGE READING METHODS
+ ******************************************************************************/
+
+float SensorReader::readVoltage_EC() {
+  PERF_SCOPE(PERF_READ_VOLTAGE);
+  _seedFilters();
+  return _lastEC;
 }
 
 float SensorReader::readVoltage_Temp() {
-  float sum = 0.0;
-  
-  for (uint8_t i = 0; i < TEMP_SAMPLE_COUNT; i++) {
-    uint16_t adcValue = analogRead(_tempPin);
-    sum += _adcToMillivolts(adcValue);
-    if (i < TEMP_SAMPLE_COUNT - 1) {
-      delay(1);
-    }
-  }
-  
-  return sum / TEMP_SAMPLE_COUNT;
+  PERF_SCOPE(PERF_READ_VOLTAGE);
+  _seedFilters();
+  return _tempVoltage;
 }
 
 float SensorReader::readVoltage_pH() {
-  float sum = 0.0;
-  
-  for (uint8_t i = 0; i < PH_SAMPLE_COUNT; i++) {
-    uint16_t adcValue = analogRead(_pHPin);
-    sum += _adcToMillivolts(adcValue);
-    if (i < PH_SAMPLE_COUNT - 1) {
-      delay(PH_SAMPLE_DELAY_MS);
-    }
-  }
-  
-  float voltage = sum / PH_SAMPLE_COUNT;
-  voltage = _applyFilter(voltage, _lastpH);
-  _lastpH = voltage;
-  
-  return voltage;
+  PERF_SCOPE(PERF_READ_VOLTAGE);
+  _seedFilters();
+  return _lastpH;
 }
 
 /*******************************************************************************
@@ -126,14 +159,8 @@ float SensorReader::readVoltage_pH() {
  ******************************************************************************/
 
 float SensorReader::readTemperature() {
-  float voltageMillivolts = readVoltage_Temp();
-  float voltageVolts = voltageMillivolts / 1000.0;
-  float temperature = (voltageVolts - TEMP_OFFSET_V) * TEMP_SCALE;
-  
-  temperature = _applyFilter(temperature, _lastTemp);
-  _lastTemp = temperature;
-  
-  return temperature;
+  _seedFilters();
+  return _lastTemp;
 }
 
 /*******************************************************************************
@@ -185,7 +212,75 @@ float SensorReader::_adcToMillivolts(uint16_t adcValue) {
 }
 
 float SensorReader::_applyFilter(float newValue, float oldValue) {
-  return FILTER_ALPHA * newValue + (1.0 - FILTER_ALPHA) * oldValue;
+  return _filterAlpha * newValue + (1.0 - _filterAlpha) * oldValue;
+}
+
+/*
+ * Uncalibrated conversion: T = (V - TEMP_OFFSET_V) × TEMP_SCALE
+ */
+float SensorReader::_millivoltsToCelsius(float millivolts) {
+  return (millivolts / 1000.0 - TEMP_OFFSET_V) * TEMP_SCALE;
+}
+
+/*
+ * Add one ADC sample to a window. Nothing is sampled before the sensors
+ * have settled; a window that is not collected for a long time (a long
+ * blocking command) stops growing at 64 samples, which still fits the
+ * uint16_t sum.
+ */
+void SensorReader::_addSample(SampleWindow& window, uint8_t pin) {
+  if (halMillis() - _settleStart < SENSOR_SETTLE_MS || window.count >= 64) {
+    return;
+  }
+  window.sum += Power.quietAnalogRead(pin);
+  window.count++;
+}
+
+/*
+ * Average of a window in millivolts, then empty it.
+ * Returns false (millivolts untouched) if the window is empty.
+ */
+bool SensorReader::_takeAverage(SampleWindow& window, float& millivolts) {
+  if (window.count == 0) {
+    return false;
+  }
+  millivolts = _adcToMillivolts(window.sum) / window.count;
+  window.sum = 0;
+  window.count = 0;
+  return true;
+}
+
+/*
+ * Seed the filters with one reading per sensor, once, if a value is
+ * needed before background sampling has completed its first windows
+ * (a command right after boot). Waits only for the part of the settling
+ * time that has not passed yet.
+ */
+void SensorReader::_seedFilters() {
+  if (_seeded) {
+    return;
+  }
+
+  unsigned long elapsed = halMillis() - _settleStart;
+  if (elapsed < SENSOR_SETTLE_MS) {
+    halDelay(SENSOR_SETTLE_MS - elapsed);
+  }
+
+  _lastEC = _adcToMillivolts(halAnalogRead(_ecPin));
+
+  _tempVoltage = _adcToMillivolts(halAnalogRead(_tempPin));
+  _lastTemp = _millivoltsToCelsius(_tempVoltage);
+
+  _lastpH = _adcToMillivolts(halAnalogRead(_pHPin));
+
+  _seeded = true;
+  _markReading();
+}
+
+void SensorReader::_markReading() {
+  if (_firstReadingMs == 0) {
+    _firstReadingMs = halMillis();
+  }
 }
 
 /*******************************************************************************
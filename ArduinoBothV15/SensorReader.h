@@ -8,7 +8,8 @@
  * Responsibilities:
  *   - Read raw ADC values from sensor pins
  *   - Convert ADC counts to millivolts
- *   - Apply averaging to reduce noise
+ *   - Sample each channel in the background at a fixed period
+ *   - Apply averaging to reduce noise (one window per filter period)
  *   - Apply optional exponential filtering
  *   - Convert temperature voltage to Celsius
  *   - Convert pH voltage to pH units (uncalibrated)
@@ -55,10 +56,24 @@ public:
   uint16_t readRawADC_Temp();
   uint16_t readRawADC_pH();
   
+  /***************************************************************************
+   * BACKGROUND SAMPLING (scheduler tasks)
+   * 
+   * sample*() take one ADC sample into the channel's window (ignored
+   * until the sensors have settled); updateFilters() averages each window
+   * and feeds it through the exponential filter, once per FILTER_PERIOD_MS.
+   ***************************************************************************/
+  void sampleEC();
+  void sampleTemp();
+  void samplepH();
+  void updateFilters();
+  
   /***************************************************************************
    * VOLTAGE READING METHODS
    * 
-   * Returns sensor voltage in millivolts (0-5000 mV) with averaging.
+   * Returns sensor voltage in millivolts (0-5000 mV): the latest averaged
+   * window, filtered for EC and pH. Does not sample, so it never waits,
+   * except once at boot if called before the first window is complete.
    ***************************************************************************/
   float readVoltage_EC();
   float readVoltage_Temp();
@@ -89,6 +104,25 @@ public:
    * Calibration will provide accurate pH readings.
    */
   float readpH();
+  
+  /***************************************************************************
+   * FILTER COEFFICIENT
+   * 
+   * Exponential filter alpha (default FILTER_ALPHA). Only host tools
+   * change it, to compare candidate filters on recorded data.
+   ***************************************************************************/
+  void setFilterAlpha(float alpha) { _filterAlpha = alpha; }
+  float getFilterAlpha() const { return _filterAlpha; }
+  
+  /***************************************************************************
+   * BOOT METRICS
+   * 
+   * millis() when the first voltage reading completed (0 = none yet)
+   ***************************************************************************/
+  unsigned long getFirstReadingMs() const { return _firstReadingMs; }
+
+  // tools/firmware_bench times the filter kernels
+  friend class FirmwareBench;
 
 private:
   /***************************************************************************
@@ -102,12 +136,33 @@ private:
   float _lastEC;
   float _lastTemp;
   float _lastpH;
+  float _tempVoltage;     // Latest temperature window (not filtered)
+  float _filterAlpha;
+  
+  // Sample windows: ADC counts summed since the last updateFilters()
+  struct SampleWindow {
+    uint16_t sum;
+    uint8_t  count;
+  };
+  SampleWindow _ecWindow;
+  SampleWindow _tempWindow;
+  SampleWindow _pHWindow;
+  
+  // Settling: filters are seeded by the first reading, not in begin()
+  unsigned long _settleStart;
+  bool _seeded;
+  unsigned long _firstReadingMs;
   
   /***************************************************************************
    * PRIVATE HELPER METHODS
    ***************************************************************************/
   float _adcToMillivolts(uint16_t adcValue);
   float _applyFilter(float newValue, float oldValue);
+  float _millivoltsToCelsius(float millivolts);
+  void _addSample(SampleWindow& window, uint8_t pin);
+  bool _takeAverage(SampleWindow& window, float& millivolts);
+  void _seedFilters();
+  void _markReading();
 };
 
 #endif // SENSORREADER_H
@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * WATCHDOG.CPP - Watchdog Supervision and Reset-Cause Reporting
+ *                Implementation
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "Watchdog.h"
+
+#if defined(__AVR__)
+#include <avr/wdt.h>
+#endif
+
+/*******************************************************************************
+ * STATE KEPT ACROSS RESETS (.noinit, not cleared by the startup code)
+ *
+ * Random after power-on; noinitMagic tells whether the rest is valid.
+ ******************************************************************************/
+const uint16_t WATCHDOG_MAGIC = 0x5744;   // "WD"
+
+static uint16_t         noinitMagic    __attribute__((section(".noinit")));
+static uint16_t         noinitResets   __attribute__((section(".noinit")));
+static volatile uint8_t noinitTask     __attribute__((section(".noinit")));
+static uint8_t          noinitFlags    __attribute__((section(".noinit")));
+
+static uint8_t resetTask = WATCHDOG_NO_TASK;
+
+#if defined(__AVR__)
+
+/*******************************************************************************
+ * BOOT CAPTURE
+ *
+ * Runs from .init3, before .bss is cleared and before any constructor.
+ * After a watchdog reset the watchdog stays armed (WDRF forces WDE) at
+ * its shortest timeout, so it is switched off here before it fires again.
+ ******************************************************************************/
+void _watchdogBoot() __attribute__((naked, used, section(".init3")));
+
+void _watchdogBoot() {
+  uint8_t flags = MCUSR;
+  if (flags == 0) {
+    // Optiboot 6+: flags handed over in r2
+    __asm__ __volatile__ ("mov %0, r2" : "=r" (flags));
+  }
+  noinitFlags = flags & (RESET_POWER_ON | RESET_EXTERNAL | RESET_BROWN_OUT | RESET_WATCHDOG);
+
+  MCUSR = 0;
+  wdt_disable();
+}
+
+#endif // __AVR__
+
+/*******************************************************************************
+ * INITIALIZATION
+ ******************************************************************************/
+void watchdogBegin() {
+#if defined(__AVR__)
+  bool valid = noinitMagic == WATCHDOG_MAGIC &&
+               !(noinitFlags & (RESET_POWER_ON | RESET_BROWN_OUT));
+
+  if (!valid) {
+    noinitMagic = WATCHDOG_MAGIC;
+    noinitResets = 0;
+  } else if (noinitFlags & RESET_WATCHDOG) {
+    resetTask = noinitTask;
+    if (noinitResets < 0xFFFF) {
+      noinitResets++;
+    }
+  }
+  noinitTask = WATCHDOG_NO_TASK;
+
+#if WATCHDOG_ENABLED
+  wdt_enable(WATCHDOG_TIMEOUT);
+#endif
+#else
+  // No reset flags on host builds
+  noinitMagic = WATCHDOG_MAGIC;
+  noinitFlags = 0;
+  noinitResets = 0;
+#endif
+}
+
+/*******************************************************************************
+ * SUPERVISION
+ ******************************************************************************/
+void watchdogFeed() {
+#if defined(__AVR__) && WATCHDOG_ENABLED
+  wdt_reset();
+#endif
+}
+
+void watchdogSetTask(uint8_t task) {
+  noinitTask = task;
+}
+
+/*******************************************************************************
+ * RESET CAUSE
+ ******************************************************************************/
+uint8_t getResetFlags() {
+  return noinitFlags;
+}
+
+uint8_t getResetTask() {
+  return resetTask;
+}
+
+uint16_t getWatchdogResets() {
+  return noinitResets;
+}
+
+void printResetFlags(Print& out, uint8_t flags) {
+  // Bit order of the RESET_* flags
+  const __FlashStringHelper* names[] = {
+    F("POWER-ON"), F("EXTERNAL"), F("BROWN-OUT"), F("WATCHDOG")
+  };
+
+  if (flags == 0) {
+    out.print(F("UNKNOWN"));
+    return;
+  }
+
+  bool first = true;
+  for (uint8_t bit = 0; bit < 4; bit++) {
+    if (flags & (1 << bit)) {
+      if (!first) {
+        out.print('+');
+      }
+      out.print(names[bit]);
+      first = false;
+    }
+  }
+}
+
+/*******************************************************************************
+ * END OF WATCHDOG IMPLEMENTATION
+ ******************************************************************************/
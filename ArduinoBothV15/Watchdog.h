@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * WATCHDOG.H - Watchdog Supervision and Reset-Cause Reporting
+ *
+ * Purpose:
+ *   A hang in a blocking path (serial TX, a sensor or EEPROM loop) used to
+ *   leave the unit wedged until someone power-cycled it. Now the AVR
+ *   watchdog resets it, and the next boot says why and where:
+ *
+ *   - The reset flags (MCUSR) are captured before anything else runs
+ *   - The scheduler stores the index of the running task in .noinit RAM,
+ *     which a watchdog reset does not clear, and feeds the watchdog after
+ *     every pass
+ *   - Long EEPROM work (save retries, boot migration) feeds it per record
+ *   - Watchdog resets are counted until the next power-on
+ *
+ * Bootloader:
+ *   Optiboot clears MCUSR before starting the sketch and (from version 6)
+ *   passes the flags in r2; both places are checked.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+#include <Arduino.h>
+#include "Config.h"
+
+const uint8_t WATCHDOG_NO_TASK     = 0xFF;
+
+// Reset flag bits (same positions as in MCUSR)
+const uint8_t RESET_POWER_ON       = 0x01;
+const uint8_t RESET_EXTERNAL       = 0x02;
+const uint8_t RESET_BROWN_OUT      = 0x04;
+const uint8_t RESET_WATCHDOG       = 0x08;
+
+/*
+ * Evaluate the reset cause, then start the watchdog (WATCHDOG_TIMEOUT;
+ * not started if WATCHDOG_ENABLED is 0). Call once, early in setup().
+ */
+void watchdogBegin();
+
+/*
+ * Restart the timeout. Called by the scheduler after every pass and by
+ * EEPROMManager per record.
+ */
+void watchdogFeed();
+
+/*
+ * Record the task about to run (WATCHDOG_NO_TASK between tasks).
+ */
+void watchdogSetTask(uint8_t task);
+
+/*
+ * Reset cause of this boot: RESET_* bits (0 = unknown), the task that
+ * was running when the watchdog fired (WATCHDOG_NO_TASK if none or not a
+ * watchdog reset) and the number of watchdog resets since power-on.
+ */
+uint8_t getResetFlags();
+uint8_t getResetTask();
+uint16_t getWatchdogResets();
+
+/*
+ * Print the reset flags as words ("WATCHDOG", "EXTERNAL+BROWN-OUT", ...).
+ */
+void printResetFlags(Print& out, uint8_t flags);
+
+#endif // WATCHDOG_H
@@ -967,7 +967,8 @@ class CalibrationWindow(QMainWindow):
     def parse_status_compact(self, data):
         """
         Parse STATUS_COMPACT response
-        Format: STATUS_COMPACT:ECL:1,4,0.9987|ECH:0,0,0.0000|PH:1,3,0.9995|T:1,3,0.9998
+        Format: STATUS_COMPACT:ECL:1,4,0.9987|ECH:0,0,0.0000|PH:1,3,0.9995|T:1,3,0.9998|MEM:812,684,402,355
+        (the MEM segment is memory, not a sensor, and is skipped here)
         """
         try:
             status_str = data.split(':', 1)[1]
@@ -975,7 +976,7 @@ class CalibrationWindow(QMainWindow):
             
             for sensor_data in sensors:
                 parts = sensor_data.split(':')
-                if len(parts) >= 2:
+                if len(parts) >= 2 and parts[0] != "MEM":
                     sensor = parts[0]
                     values = parts[1].split(',')
                     if len(values) >= 3:
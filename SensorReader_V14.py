@@ -563,6 +563,7 @@ class HealthMonitorWidget(QGroupBox):
     
     def __init__(self):
         super().__init__("System Health")
+        self.mem_headroom = deque(maxlen=100)   # Stack headroom trend (bytes)
         self.initUI()
         
     def initUI(self):
@@ -583,8 +584,9 @@ class HealthMonitorWidget(QGroupBox):
         self.cal_age = QLabel("Cal Age: ---")
         self.drift_status = QLabel("Drift: ---")
         self.temp_coeff = QLabel("Temp Coeff: ---")
+        self.mem_status = QLabel("Memory: ---")
         
-        for label in [self.cal_age, self.drift_status, self.temp_coeff]:
+        for label in [self.cal_age, self.drift_status, self.temp_coeff, self.mem_status]:
             label.setStyleSheet("padding: 3px; font-family: monospace; font-size: 10px;")
             layout.addWidget(label)
             
@@ -626,6 +628,23 @@ class HealthMonitorWidget(QGroupBox):
                 self.drift_status.setText("Drift: Warning ⚠")
                 self.drift_status.setStyleSheet("color: red; font-weight: bold; font-family: monospace;")
                 
+        if data.startswith("Mem:"):
+            # Mem: heap 812 free (largest 684), stack peak 402, headroom 355
+            heap_match = re.search(r'heap\s+(\d+)', data)
+            headroom_match = re.search(r'headroom\s+(\d+)', data)
+            if heap_match and headroom_match:
+                headroom = int(headroom_match.group(1))
+                self.mem_headroom.append(headroom)
+                self.mem_status.setText(
+                    f"Memory: heap {heap_match.group(1)}B, headroom {headroom}B "
+                    f"(min {min(self.mem_headroom)}B)")
+                if min(self.mem_headroom) < 128:
+                    self.mem_status.setStyleSheet("color: red; font-weight: bold; font-family: monospace;")
+                elif min(self.mem_headroom) < 256:
+                    self.mem_status.setStyleSheet("color: orange; font-family: monospace;")
+                else:
+                    self.mem_status.setStyleSheet("color: green; font-family: monospace;")
+                
         if "System healthy" in data:
             self.health_indicator.setStyleSheet("font-size: 48px; color: green;")
             self.health_status.setText("Status: Healthy ✓")
@@ -1284,7 +1303,7 @@ class SensorReaderSegment1(QMainWindow):
             return
 
         # Parse health data (DIAG command)
-        if "DIAG" in data or "ADC:" in data or "mV:" in data:
+        if "DIAG" in data or "ADC:" in data or "mV:" in data or data.startswith("Mem:"):
             self.health_widget.update_health(data)
     
     def parse_sensor_readings(self, buf):
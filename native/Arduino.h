@@ -0,0 +1,135 @@
+/*******************************************************************************
+ * ARDUINO.H - Host Stand-In for the Arduino Core (Language Support Only)
+ *
+ * Purpose:
+ *   Lets the firmware sources compile unchanged as a native Linux program.
+ *   Provides only what is plain language support on the Arduino: integer
+ *   types, PROGMEM / F() / pgm_read_*, String, Print and a few helpers.
+ *
+ *   Hardware (analog input, time, serial, EEPROM) is NOT here: firmware
+ *   code reaches it through ArduinoBothV15/Hal.h, implemented for Linux
+ *   in HalLinux.cpp. A firmware change that calls e.g. analogRead()
+ *   directly therefore fails to build natively instead of silently
+ *   bypassing the HAL.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <cmath>
+#include <cstdlib>
+#include <type_traits>
+
+/*******************************************************************************
+ * TARGET CONSTANTS (ATmega328P / Uno values)
+ ******************************************************************************/
+#ifndef F_CPU
+#define F_CPU 16000000L
+#endif
+
+const uint8_t A0 = 14;
+const uint8_t A1 = 15;
+const uint8_t A2 = 16;
+const uint8_t A3 = 17;
+const uint8_t A4 = 18;
+const uint8_t A5 = 19;
+const uint8_t A6 = 20;
+const uint8_t A7 = 21;
+
+#define INPUT  0x0
+#define OUTPUT 0x1
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+typedef uint8_t byte;
+typedef bool    boolean;
+
+/*******************************************************************************
+ * PROGRAM MEMORY
+ *
+ * One address space on the host: PROGMEM data is ordinary const data and
+ * the pgm_read_* helpers are plain (unaligned-safe) loads.
+ ******************************************************************************/
+#define PROGMEM
+#define PSTR(s) (s)
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper*>(PSTR(s)))
+
+inline uint8_t pgm_read_byte(const void* address) {
+  return *(const uint8_t*)address;
+}
+
+inline uint16_t pgm_read_word(const void* address) {
+  uint16_t value;
+  memcpy(&value, address, sizeof(value));
+  return value;
+}
+
+inline uint32_t pgm_read_dword(const void* address) {
+  uint32_t value;
+  memcpy(&value, address, sizeof(value));
+  return value;
+}
+
+inline float pgm_read_float(const void* address) {
+  float value;
+  memcpy(&value, address, sizeof(value));
+  return value;
+}
+
+inline const void* pgm_read_ptr(const void* address) {
+  const void* value;
+  memcpy(&value, address, sizeof(value));
+  return value;
+}
+
+#define memcpy_P  memcpy
+#define strlen_P  strlen
+#define strcmp_P  strcmp
+#define strncmp_P strncmp
+
+/*******************************************************************************
+ * HELPERS
+ *
+ * min/max accept mixed argument types like the Arduino macros do.
+ ******************************************************************************/
+template <typename T, typename U>
+inline typename std::common_type<T, U>::type min(T a, U b) { return a < b ? a : b; }
+
+template <typename T, typename U>
+inline typename std::common_type<T, U>::type max(T a, U b) { return a > b ? a : b; }
+
+using std::abs;
+
+#define constrain(x, low, high) ((x) < (low) ? (low) : ((x) > (high) ? (high) : (x)))
+#define lowByte(w)  ((uint8_t)((w) & 0xFF))
+#define highByte(w) ((uint8_t)((w) >> 8))
+
+inline bool isDigit(int c)        { return isdigit(c) != 0; }
+inline bool isAlpha(int c)        { return isalpha(c) != 0; }
+inline bool isAlphaNumeric(int c) { return isalnum(c) != 0; }
+inline bool isSpace(int c)        { return isspace(c) != 0; }
+
+#include "WString.h"
+#include "Print.h"
+
+/*******************************************************************************
+ * SKETCH ENTRY POINTS (called by main.cpp)
+ ******************************************************************************/
+void setup();
+void loop();
+
+#endif // ARDUINO_H
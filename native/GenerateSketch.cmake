@@ -0,0 +1,57 @@
+#*******************************************************************************
+# GENERATESKETCH.CMAKE - Turn the .ino into a C++ Translation Unit
+#
+# Purpose:
+#   Does what the Arduino builder does to a sketch before compiling it:
+#   adds "#include <Arduino.h>" and a prototype for every function defined
+#   in the sketch, inserted in front of the first definition (after the
+#   sketch's own includes and types). #line directives keep compiler
+#   messages pointing into the .ino.
+#
+#   Function definitions are found as lines that start at column 0 and
+#   end in ") {", which is how every function in the sketch is written.
+#
+# Usage (script mode, run by the build when the .ino changes):
+#   cmake -DINO=<sketch.ino> -DOUT=<sketch.cpp> -P GenerateSketch.cmake
+#
+# Author: System Rewrite v1.0 - Complete Edition
+# Date: 2026-02-16
+#*******************************************************************************
+
+if(NOT INO OR NOT OUT)
+  message(FATAL_ERROR "Usage: cmake -DINO=<sketch.ino> -DOUT=<sketch.cpp> -P GenerateSketch.cmake")
+endif()
+
+file(READ "${INO}" source)
+
+string(REGEX MATCHALL "\n[A-Za-z_][^\n;{}]*\\)[ \t]*\\{" definitions "${source}")
+if(NOT definitions)
+  message(FATAL_ERROR "${INO}: no function definitions found")
+endif()
+
+# === SPLIT AT THE FIRST DEFINITION ===
+list(GET definitions 0 first)
+string(FIND "${source}" "${first}" offset)
+math(EXPR offset "${offset} + 1")
+string(SUBSTRING "${source}" 0 ${offset} head)
+string(SUBSTRING "${source}" ${offset} -1 body)
+
+string(REGEX MATCHALL "\n" newlines "${head}")
+list(LENGTH newlines headLines)
+math(EXPR bodyLine "${headLines} + 1")
+
+# === PROTOTYPES ===
+set(prototypes "")
+foreach(definition IN LISTS definitions)
+  string(REGEX REPLACE "^\n(.*\\))[ \t]*\\{$" "\\1" signature "${definition}")
+  string(APPEND prototypes "${signature};\n")
+endforeach()
+
+file(WRITE "${OUT}"
+  "// Generated from ${INO} by GenerateSketch.cmake - do not edit\n"
+  "#include <Arduino.h>\n"
+  "#line 1 \"${INO}\"\n"
+  "${head}"
+  "${prototypes}"
+  "#line ${bodyLine} \"${INO}\"\n"
+  "${body}")
@@ -0,0 +1,349 @@
+/*******************************************************************************
+ * HALLINUX.CPP - Linux Implementation of the Hardware Abstraction Layer
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "HalLinux.h"
+#include "Hal.h"
+#include "Config.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <vector>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * STATE
+ *
+ * Firmware constructors (Perf, LowPower, ...) may call into the HAL before
+ * this file's globals are constructed: the clock origin and the EEPROM
+ * image are created on first use instead.
+ ******************************************************************************/
+const uint8_t ANALOG_PINS = 8;       // A0..A7
+const int SERIAL_TX_RING = 64;       // HardwareSerial TX buffer on the Uno
+const int PTY_STALL_MS = 200;        // PTY output wait before dropping
+
+static uint16_t analogValues[ANALOG_PINS];
+static HalLinuxAnalogSource analogSource = NULL;
+
+static std::chrono::steady_clock::time_point startTime() {
+  static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  return start;
+}
+
+static bool virtualClock = false;
+static uint64_t virtualMicros = 0;
+
+static int serialInFd = STDIN_FILENO;
+static int serialOutFd = -1;   // -1: stdout through stdio
+static bool serialDiscard = false;
+static int ptySlaveFd = -1;    // Kept open so the master never sees a hangup
+static bool inputClosed = false;
+static bool ptyStalled = false;   // Output timed out: nobody reading the PTY
+static std::deque<uint8_t> rxBuffer;
+
+static int nvFd = -1;
+
+static std::vector<uint8_t>& nvImage() {
+  static std::vector<uint8_t> image(EEPROM_SIZE, 0xFF);
+  return image;
+}
+
+/*******************************************************************************
+ * SETUP (called by main.cpp)
+ ******************************************************************************/
+bool halLinuxOpenNv(const char* path) {
+  int fd = open(path, O_RDWR | O_CREAT, 0644);
+  if (fd < 0) {
+    perror(path);
+    return false;
+  }
+
+  std::vector<uint8_t>& image = nvImage();
+  ssize_t got = pread(fd, image.data(), image.size(), 0);
+  if (got < 0) {
+    perror(path);
+    close(fd);
+    return false;
+  }
+
+  // New or short file: pad with erased cells so it is always a full image
+  if ((size_t)got < image.size()) {
+    std::fill(image.begin() + got, image.end(), 0xFF);
+    if (pwrite(fd, image.data() + got, image.size() - got, got) < 0) {
+      perror(path);
+      close(fd);
+      return false;
+    }
+  }
+
+  nvFd = fd;
+  return true;
+}
+
+bool halLinuxLoadNv(const char* path) {
+  FILE* file = fopen(path, "rb");
+  if (!file) {
+    perror(path);
+    return false;
+  }
+
+  std::vector<uint8_t>& image = nvImage();
+  size_t got = fread(image.data(), 1, image.size(), file);
+  std::fill(image.begin() + got, image.end(), 0xFF);
+  fclose(file);
+  return true;
+}
+
+bool halLinuxOpenPty(const char* linkPath) {
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+    perror("posix_openpt");
+    return false;
+  }
+
+  const char* slaveName = ptsname(master);
+  int slave = slaveName ? open(slaveName, O_RDWR | O_NOCTTY) : -1;
+  if (slave < 0) {
+    perror("ptsname");
+    close(master);
+    return false;
+  }
+
+  // Raw bytes both ways, like a USB serial port
+  struct termios tio;
+  tcgetattr(slave, &tio);
+  cfmakeraw(&tio);
+  tcsetattr(slave, TCSANOW, &tio);
+
+  fcntl(master, F_SETFL, fcntl(master, F_GETFL) | O_NONBLOCK);
+
+  if (linkPath) {
+    unlink(linkPath);
+    if (symlink(slaveName, linkPath) != 0) {
+      perror(linkPath);
+    }
+  }
+
+  fprintf(stderr, "Serial port: %s\n", linkPath ? linkPath : slaveName);
+
+  serialInFd = master;
+  serialOutFd = master;
+  ptySlaveFd = slave;
+  return true;
+}
+
+void halLinuxSetAnalog(uint8_t pin, uint16_t value) {
+  if (pin >= A0) {
+    pin -= A0;
+  }
+  if (pin < ANALOG_PINS) {
+    analogValues[pin] = value > 1023 ? 1023 : value;
+  }
+}
+
+void halLinuxSetAnalogSource(HalLinuxAnalogSource source) {
+  analogSource = source;
+}
+
+bool halLinuxInputClosed() {
+  return inputClosed;
+}
+
+void halLinuxDiscardSerial() {
+  serialDiscard = true;
+  inputClosed = true;
+}
+
+void halLinuxUseVirtualClock() {
+  virtualClock = true;
+  virtualMicros = 0;
+}
+
+void halLinuxAdvanceClock(uint32_t micros) {
+  virtualMicros += micros;
+}
+
+/*******************************************************************************
+ * ANALOG INPUT
+ ******************************************************************************/
+void halAnalogInit(uint8_t pin) {
+  (void)pin;
+}
+
+uint16_t halAnalogRead(uint8_t pin) {
+  uint16_t raw;
+  if (analogSource && analogSource(pin, raw)) {
+    return raw;
+  }
+  if (pin >= A0) {
+    pin -= A0;
+  }
+  return pin < ANALOG_PINS ? analogValues[pin] : 0;
+}
+
+/*******************************************************************************
+ * TIME
+ *
+ * 32-bit like the AVR core, so counters wrap the same way.
+ * Virtual clock: 64-bit count underneath, same 32-bit view.
+ ******************************************************************************/
+unsigned long halMillis() {
+  if (virtualClock) {
+    return (uint32_t)(virtualMicros / 1000);
+  }
+  return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+           std::chrono::steady_clock::now() - startTime()).count();
+}
+
+unsigned long halMicros() {
+  if (virtualClock) {
+    return (uint32_t)virtualMicros;
+  }
+  return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+           std::chrono::steady_clock::now() - startTime()).count();
+}
+
+void halDelay(unsigned long ms) {
+  if (virtualClock) {
+    virtualMicros += (uint64_t)ms * 1000;
+    return;
+  }
+
+  struct timespec request;
+  request.tv_sec = ms / 1000;
+  request.tv_nsec = (long)(ms % 1000) * 1000000L;
+  while (nanosleep(&request, &request) != 0 && errno == EINTR) {
+  }
+}
+
+/*******************************************************************************
+ * SERIAL
+ ******************************************************************************/
+static void pollInput() {
+  if (inputClosed) {
+    return;
+  }
+
+  struct pollfd pfd;
+  pfd.fd = serialInFd;
+  pfd.events = POLLIN;
+  if (poll(&pfd, 1, 0) <= 0 || !(pfd.revents & (POLLIN | POLLHUP))) {
+    return;
+  }
+
+  uint8_t buffer[256];
+  ssize_t got = read(serialInFd, buffer, sizeof(buffer));
+  if (got > 0) {
+    rxBuffer.insert(rxBuffer.end(), buffer, buffer + got);
+  } else if (got == 0 && ptySlaveFd < 0) {
+    inputClosed = true;
+  }
+}
+
+void halSerialBegin(uint32_t baud, unsigned long waitMs) {
+  (void)baud;
+  (void)waitMs;
+}
+
+int halSerialAvailable() {
+  pollInput();
+  return (int)rxBuffer.size();
+}
+
+int halSerialRead() {
+  if (rxBuffer.empty()) {
+    pollInput();
+  }
+  if (rxBuffer.empty()) {
+    return -1;
+  }
+  uint8_t c = rxBuffer.front();
+  rxBuffer.pop_front();
+  return c;
+}
+
+// Same as an empty HardwareSerial TX ring: output never has to queue
+int halSerialAvailableForWrite() {
+  return SERIAL_TX_RING - 1;
+}
+
+size_t halSerialWrite(const uint8_t* data, size_t length) {
+  if (serialDiscard) {
+    return length;
+  }
+  if (serialOutFd < 0) {
+    fwrite(data, 1, length, stdout);
+    if (memchr(data, '\n', length)) {
+      fflush(stdout);
+    }
+    return length;
+  }
+
+  // A slow reader holds the firmware up like a full TX buffer would;
+  // nobody reading at all: drop, like a board with no host attached
+  size_t sent = 0;
+  while (sent < length) {
+    ssize_t written = write(serialOutFd, data + sent, length - sent);
+    if (written > 0) {
+      sent += written;
+      ptyStalled = false;
+      continue;
+    }
+    if (written < 0 && errno != EAGAIN) {
+      break;
+    }
+
+    struct pollfd pfd;
+    pfd.fd = serialOutFd;
+    pfd.events = POLLOUT;
+    if (ptyStalled || poll(&pfd, 1, PTY_STALL_MS) <= 0) {
+      ptyStalled = true;
+      break;
+    }
+  }
+  return length;
+}
+
+size_t halSerialWrite(uint8_t c) {
+  return halSerialWrite(&c, 1);
+}
+
+void halSerialFlush() {
+  if (!serialDiscard && serialOutFd < 0) {
+    fflush(stdout);
+  }
+}
+
+/*******************************************************************************
+ * NONVOLATILE STORAGE
+ ******************************************************************************/
+uint8_t halNvRead(uint16_t address) {
+  return address < EEPROM_SIZE ? nvImage()[address] : 0xFF;
+}
+
+void halNvWrite(uint16_t address, uint8_t value) {
+  if (address >= EEPROM_SIZE) {
+    return;
+  }
+  nvImage()[address] = value;
+  if (nvFd >= 0 && pwrite(nvFd, &value, 1, address) != 1) {
+    perror("EEPROM write");
+  }
+}
+
+/*******************************************************************************
+ * END OF LINUX HAL IMPLEMENTATION
+ ******************************************************************************/
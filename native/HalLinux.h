@@ -0,0 +1,74 @@
+/*******************************************************************************
+ * HALLINUX.H - Linux Implementation of the Hardware Abstraction Layer
+ *
+ * Purpose:
+ *   Backs the hal* functions of ArduinoBothV15/Hal.h with host resources
+ *   and lets main.cpp set them up:
+ *
+ *     analog input   simulated: fixed raw ADC value per pin (0..1023)
+ *                    or a waveform source
+ *     time           monotonic clock since program start, or a virtual
+ *                    clock advanced by the caller
+ *     serial         stdin/stdout, or a pseudo-terminal that host tools
+ *                    (Calibrator, eeprom_tool -n) open like a board port
+ *     nonvolatile    EEPROM_SIZE-byte binary file, written through on
+ *                    every cell write (erased cells read 0xFF)
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef HALLINUX_H
+#define HALLINUX_H
+
+#include <Arduino.h>
+
+/*
+ * Keep the EEPROM in path (created blank if missing). Without this call
+ * the EEPROM lives in memory and starts blank on every run.
+ */
+bool halLinuxOpenNv(const char* path);
+
+/*
+ * Start from a copy of the image in path; writes stay in memory.
+ */
+bool halLinuxLoadNv(const char* path);
+
+/*
+ * Serial over a new pseudo-terminal instead of stdin/stdout. Prints the
+ * device name to stderr; linkPath (optional) becomes a symlink to it.
+ */
+bool halLinuxOpenPty(const char* linkPath);
+
+/*
+ * Raw ADC reading returned by halAnalogRead(pin) (default 0).
+ */
+void halLinuxSetAnalog(uint8_t pin, uint16_t value);
+
+/*
+ * Optional signal source asked first on every halAnalogRead(); returning
+ * false falls back to the halLinuxSetAnalog() value (see Waveform.h).
+ */
+typedef bool (*HalLinuxAnalogSource)(uint8_t pin, uint16_t& raw);
+void halLinuxSetAnalogSource(HalLinuxAnalogSource source);
+
+/*
+ * True once the stdin serial input reached end of file (never for a PTY).
+ */
+bool halLinuxInputClosed();
+
+/*
+ * No serial at all: output is dropped, input is closed. For tools that
+ * drive firmware modules directly and own stdout.
+ */
+void halLinuxDiscardSerial();
+
+/*
+ * Virtual time: halMillis()/halMicros() only move when the caller
+ * advances them, and halDelay() returns at once after advancing. Lets
+ * tools run the firmware faster than real time, reproducibly.
+ */
+void halLinuxUseVirtualClock();
+void halLinuxAdvanceClock(uint32_t micros);
+
+#endif // HALLINUX_H
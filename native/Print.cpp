@@ -0,0 +1,164 @@
+/*******************************************************************************
+ * PRINT.CPP - Host Version of the Arduino Print Class Implementation
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "Print.h"
+
+#include <math.h>
+
+/*******************************************************************************
+ * RAW OUTPUT
+ ******************************************************************************/
+size_t Print::write(const uint8_t* buffer, size_t size) {
+  size_t n = 0;
+  while (size--) {
+    if (write(*buffer++)) {
+      n++;
+    } else {
+      break;
+    }
+  }
+  return n;
+}
+
+/*******************************************************************************
+ * PRINT
+ ******************************************************************************/
+size_t Print::print(const __FlashStringHelper* text) {
+  return write(reinterpret_cast<const char*>(text));
+}
+
+size_t Print::print(const String& text) {
+  return write(text.c_str(), text.length());
+}
+
+size_t Print::print(const char text[]) {
+  return write(text);
+}
+
+size_t Print::print(char c) {
+  return write((uint8_t)c);
+}
+
+size_t Print::print(unsigned char value, int base) {
+  return print((unsigned long)value, base);
+}
+
+size_t Print::print(int value, int base) {
+  return print((long)value, base);
+}
+
+size_t Print::print(unsigned int value, int base) {
+  return print((unsigned long)value, base);
+}
+
+// AVR long is 32 bits: wrap like the board would
+size_t Print::print(long value, int base) {
+  int32_t v = (int32_t)value;
+  if (base == 0) {
+    return write((uint8_t)v);
+  }
+  if (base == 10 && v < 0) {
+    size_t n = print('-');
+    return n + printNumber((uint32_t)(-(int64_t)v), 10);
+  }
+  return printNumber((uint32_t)v, base);
+}
+
+size_t Print::print(unsigned long value, int base) {
+  uint32_t v = (uint32_t)value;
+  if (base == 0) {
+    return write((uint8_t)v);
+  }
+  return printNumber(v, base);
+}
+
+size_t Print::print(double value, int digits) {
+  return printFloat(value, digits);
+}
+
+/*******************************************************************************
+ * PRINTLN
+ ******************************************************************************/
+size_t Print::println() {
+  return write("\r\n");
+}
+
+size_t Print::println(const __FlashStringHelper* text) { size_t n = print(text); return n + println(); }
+size_t Print::println(const String& text) { size_t n = print(text); return n + println(); }
+size_t Print::println(const char text[]) { size_t n = print(text); return n + println(); }
+size_t Print::println(char c) { size_t n = print(c); return n + println(); }
+size_t Print::println(unsigned char value, int base) { size_t n = print(value, base); return n + println(); }
+size_t Print::println(int value, int base) { size_t n = print(value, base); return n + println(); }
+size_t Print::println(unsigned int value, int base) { size_t n = print(value, base); return n + println(); }
+size_t Print::println(long value, int base) { size_t n = print(value, base); return n + println(); }
+size_t Print::println(unsigned long value, int base) { size_t n = print(value, base); return n + println(); }
+size_t Print::println(double value, int digits) { size_t n = print(value, digits); return n + println(); }
+
+/*******************************************************************************
+ * NUMBER FORMATTING (algorithms of the AVR core's Print.cpp)
+ ******************************************************************************/
+size_t Print::printNumber(unsigned long value, uint8_t base) {
+  char buffer[8 * sizeof(long) + 1];
+  char* str = &buffer[sizeof(buffer) - 1];
+  *str = '\0';
+
+  if (base < 2) {
+    base = 10;
+  }
+
+  do {
+    char c = value % base;
+    value /= base;
+    *--str = c < 10 ? c + '0' : c + 'A' - 10;
+  } while (value);
+
+  return write(str);
+}
+
+size_t Print::printFloat(double value, uint8_t digits) {
+  size_t n = 0;
+
+  if (isnan(value)) return print("nan");
+  if (isinf(value)) return print("inf");
+  if (value > 4294967040.0) return print("ovf");
+  if (value < -4294967040.0) return print("ovf");
+
+  // AVR double is a 32-bit float
+  float number = (float)value;
+
+  if (number < 0.0f) {
+    n += print('-');
+    number = -number;
+  }
+
+  float rounding = 0.5f;
+  for (uint8_t i = 0; i < digits; ++i) {
+    rounding /= 10.0f;
+  }
+  number += rounding;
+
+  unsigned long intPart = (unsigned long)number;
+  float remainder = number - (float)intPart;
+  n += print(intPart);
+
+  if (digits > 0) {
+    n += print('.');
+  }
+
+  while (digits-- > 0) {
+    remainder *= 10.0f;
+    unsigned int toPrint = (unsigned int)remainder;
+    n += print(toPrint);
+    remainder -= toPrint;
+  }
+
+  return n;
+}
+
+/*******************************************************************************
+ * END OF PRINT IMPLEMENTATION
+ ******************************************************************************/
@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * PRINT.H - Host Version of the Arduino Print Class
+ *
+ * Purpose:
+ *   Same interface and output as the AVR core: println() ends lines with
+ *   "\r\n", floats are printed by the core's own rounding algorithm so
+ *   native output matches the board byte for byte.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef PRINT_H
+#define PRINT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "WString.h"
+
+class __FlashStringHelper;
+
+class Print {
+public:
+  virtual ~Print() {}
+
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size);
+  size_t write(const char* text) {
+    return text ? write((const uint8_t*)text, strlen(text)) : 0;
+  }
+  size_t write(const char* buffer, size_t size) {
+    return write((const uint8_t*)buffer, size);
+  }
+
+  virtual int availableForWrite() { return 0; }
+  virtual void flush() {}
+
+  size_t print(const __FlashStringHelper* text);
+  size_t print(const String& text);
+  size_t print(const char text[]);
+  size_t print(char c);
+  size_t print(unsigned char value, int base = 10);
+  size_t print(int value, int base = 10);
+  size_t print(unsigned int value, int base = 10);
+  size_t print(long value, int base = 10);
+  size_t print(unsigned long value, int base = 10);
+  size_t print(double value, int digits = 2);
+
+  size_t println(const __FlashStringHelper* text);
+  size_t println(const String& text);
+  size_t println(const char text[]);
+  size_t println(char c);
+  size_t println(unsigned char value, int base = 10);
+  size_t println(int value, int base = 10);
+  size_t println(unsigned int value, int base = 10);
+  size_t println(long value, int base = 10);
+  size_t println(unsigned long value, int base = 10);
+  size_t println(double value, int digits = 2);
+  size_t println();
+
+private:
+  size_t printNumber(unsigned long value, uint8_t base);
+  size_t printFloat(double value, uint8_t digits);
+};
+
+#endif // PRINT_H
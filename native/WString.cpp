@@ -0,0 +1,259 @@
+/*******************************************************************************
+ * WSTRING.CPP - Host Version of the Arduino String Class Implementation
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "WString.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*******************************************************************************
+ * CONSTRUCTORS
+ ******************************************************************************/
+static std::string formatInteger(unsigned long value, unsigned char base, bool negative) {
+  if (base < 2 || base > 36) {
+    base = 10;
+  }
+
+  std::string digits;
+  do {
+    unsigned char digit = value % base;
+    digits.insert(digits.begin(), (char)(digit < 10 ? '0' + digit : 'a' + digit - 10));
+    value /= base;
+  } while (value > 0);
+
+  if (negative) {
+    digits.insert(digits.begin(), '-');
+  }
+  return digits;
+}
+
+static std::string formatFloat(double value, unsigned char decimalPlaces) {
+  char buffer[64];
+  snprintf(buffer, sizeof(buffer), "%.*f", (int)decimalPlaces, value);
+  return buffer;
+}
+
+String::String(const char* text) : _text(text ? text : "") {}
+String::String(const std::string& text) : _text(text) {}
+String::String(const __FlashStringHelper* text)
+  : _text(text ? reinterpret_cast<const char*>(text) : "") {}
+String::String(char c) : _text(1, c) {}
+
+String::String(unsigned char value, unsigned char base)
+  : _text(formatInteger(value, base, false)) {}
+String::String(unsigned int value, unsigned char base)
+  : _text(formatInteger(value, base, false)) {}
+String::String(unsigned long value, unsigned char base)
+  : _text(formatInteger(value, base, false)) {}
+
+// Negative numbers only get a sign in base 10, like the Arduino core
+String::String(int value, unsigned char base)
+  : _text(base == 10 && value < 0
+            ? formatInteger(-(unsigned long)(long)value, 10, true)
+            : formatInteger((unsigned int)value, base, false)) {}
+String::String(long value, unsigned char base)
+  : _text(base == 10 && value < 0
+            ? formatInteger(-(unsigned long)value, 10, true)
+            : formatInteger((unsigned long)value, base, false)) {}
+
+String::String(float value, unsigned char decimalPlaces)
+  : _text(formatFloat(value, decimalPlaces)) {}
+String::String(double value, unsigned char decimalPlaces)
+  : _text(formatFloat(value, decimalPlaces)) {}
+
+/*******************************************************************************
+ * CHARACTER ACCESS
+ ******************************************************************************/
+char String::charAt(unsigned int index) const {
+  return index < _text.size() ? _text[index] : 0;
+}
+
+void String::setCharAt(unsigned int index, char c) {
+  if (index < _text.size()) {
+    _text[index] = c;
+  }
+}
+
+/*******************************************************************************
+ * SEARCH
+ ******************************************************************************/
+int String::indexOf(char c, unsigned int from) const {
+  if (from >= _text.size()) {
+    return -1;
+  }
+  size_t found = _text.find(c, from);
+  return found == std::string::npos ? -1 : (int)found;
+}
+
+int String::indexOf(const String& text, unsigned int from) const {
+  if (from >= _text.size()) {
+    return -1;
+  }
+  size_t found = _text.find(text._text, from);
+  return found == std::string::npos ? -1 : (int)found;
+}
+
+int String::lastIndexOf(char c) const {
+  size_t found = _text.rfind(c);
+  return found == std::string::npos ? -1 : (int)found;
+}
+
+int String::lastIndexOf(const String& text) const {
+  if (text._text.size() > _text.size()) {
+    return -1;
+  }
+  size_t found = _text.rfind(text._text);
+  return found == std::string::npos ? -1 : (int)found;
+}
+
+/*******************************************************************************
+ * COMPARISON
+ ******************************************************************************/
+bool String::startsWith(const String& prefix) const {
+  return startsWith(prefix, 0);
+}
+
+bool String::startsWith(const String& prefix, unsigned int offset) const {
+  if (offset + prefix._text.size() > _text.size()) {
+    return false;
+  }
+  return _text.compare(offset, prefix._text.size(), prefix._text) == 0;
+}
+
+bool String::endsWith(const String& suffix) const {
+  if (suffix._text.size() > _text.size()) {
+    return false;
+  }
+  return _text.compare(_text.size() - suffix._text.size(), suffix._text.size(), suffix._text) == 0;
+}
+
+bool String::equalsIgnoreCase(const String& other) const {
+  if (_text.size() != other._text.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < _text.size(); i++) {
+    if (tolower((unsigned char)_text[i]) != tolower((unsigned char)other._text[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/*******************************************************************************
+ * EXTRACTION
+ ******************************************************************************/
+String String::substring(unsigned int from) const {
+  return substring(from, length());
+}
+
+String String::substring(unsigned int from, unsigned int to) const {
+  if (from > to) {
+    unsigned int swap = from;
+    from = to;
+    to = swap;
+  }
+  if (from >= _text.size()) {
+    return String();
+  }
+  if (to > _text.size()) {
+    to = (unsigned int)_text.size();
+  }
+  return String(_text.substr(from, to - from));
+}
+
+void String::toCharArray(char* buffer, unsigned int size, unsigned int index) const {
+  if (size == 0 || buffer == NULL) {
+    return;
+  }
+  if (index >= _text.size()) {
+    buffer[0] = 0;
+    return;
+  }
+  size_t count = _text.size() - index;
+  if (count > size - 1) {
+    count = size - 1;
+  }
+  _text.copy(buffer, count, index);
+  buffer[count] = 0;
+}
+
+/*******************************************************************************
+ * CONVERSION
+ ******************************************************************************/
+long String::toInt() const {
+  return atol(_text.c_str());
+}
+
+float String::toFloat() const {
+  return (float)atof(_text.c_str());
+}
+
+double String::toDouble() const {
+  return atof(_text.c_str());
+}
+
+/*******************************************************************************
+ * MODIFICATION
+ ******************************************************************************/
+void String::remove(unsigned int index) {
+  remove(index, (unsigned int)-1);
+}
+
+void String::remove(unsigned int index, unsigned int count) {
+  if (index >= _text.size()) {
+    return;
+  }
+  _text.erase(index, count);
+}
+
+void String::replace(char find, char with) {
+  for (size_t i = 0; i < _text.size(); i++) {
+    if (_text[i] == find) {
+      _text[i] = with;
+    }
+  }
+}
+
+void String::replace(const String& find, const String& with) {
+  if (find._text.empty()) {
+    return;
+  }
+  size_t position = 0;
+  while ((position = _text.find(find._text, position)) != std::string::npos) {
+    _text.replace(position, find._text.size(), with._text);
+    position += with._text.size();
+  }
+}
+
+void String::toUpperCase() {
+  for (size_t i = 0; i < _text.size(); i++) {
+    _text[i] = (char)toupper((unsigned char)_text[i]);
+  }
+}
+
+void String::toLowerCase() {
+  for (size_t i = 0; i < _text.size(); i++) {
+    _text[i] = (char)tolower((unsigned char)_text[i]);
+  }
+}
+
+void String::trim() {
+  size_t begin = 0;
+  while (begin < _text.size() && isspace((unsigned char)_text[begin])) {
+    begin++;
+  }
+  size_t end = _text.size();
+  while (end > begin && isspace((unsigned char)_text[end - 1])) {
+    end--;
+  }
+  _text = _text.substr(begin, end - begin);
+}
+
+/*******************************************************************************
+ * END OF STRING IMPLEMENTATION
+ ******************************************************************************/
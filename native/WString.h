@@ -0,0 +1,105 @@
+/*******************************************************************************
+ * WSTRING.H - Host Version of the Arduino String Class
+ *
+ * Purpose:
+ *   The subset of Arduino String the firmware uses, with the same
+ *   semantics (indexOf returns -1, substring clamps, toFloat/toInt parse
+ *   a leading number and return 0 otherwise). Storage is std::string.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef WSTRING_H
+#define WSTRING_H
+
+#include <stdint.h>
+#include <string>
+
+class __FlashStringHelper;
+
+class String {
+public:
+  String(const char* text = "");
+  String(const std::string& text);
+  String(const __FlashStringHelper* text);
+  explicit String(char c);
+  explicit String(unsigned char value, unsigned char base = 10);
+  explicit String(int value, unsigned char base = 10);
+  explicit String(unsigned int value, unsigned char base = 10);
+  explicit String(long value, unsigned char base = 10);
+  explicit String(unsigned long value, unsigned char base = 10);
+  explicit String(float value, unsigned char decimalPlaces = 2);
+  explicit String(double value, unsigned char decimalPlaces = 2);
+
+  unsigned int length() const { return (unsigned int)_text.size(); }
+  const char* c_str() const { return _text.c_str(); }
+  bool reserve(unsigned int size) { _text.reserve(size); return true; }
+
+  char charAt(unsigned int index) const;
+  void setCharAt(unsigned int index, char c);
+  char operator[](unsigned int index) const { return charAt(index); }
+
+  int indexOf(char c, unsigned int from = 0) const;
+  int indexOf(const String& text, unsigned int from = 0) const;
+  int lastIndexOf(char c) const;
+  int lastIndexOf(const String& text) const;
+
+  bool startsWith(const String& prefix) const;
+  bool startsWith(const String& prefix, unsigned int offset) const;
+  bool endsWith(const String& suffix) const;
+  bool equals(const String& other) const { return _text == other._text; }
+  bool equalsIgnoreCase(const String& other) const;
+
+  String substring(unsigned int from) const;
+  String substring(unsigned int from, unsigned int to) const;
+  void toCharArray(char* buffer, unsigned int size, unsigned int index = 0) const;
+
+  long toInt() const;
+  float toFloat() const;
+  double toDouble() const;
+
+  void remove(unsigned int index);
+  void remove(unsigned int index, unsigned int count);
+  void replace(char find, char with);
+  void replace(const String& find, const String& with);
+  void toUpperCase();
+  void toLowerCase();
+  void trim();
+
+  bool concat(const String& text) { _text += text._text; return true; }
+  bool concat(const char* text) { _text += text; return true; }
+  bool concat(char c) { _text += c; return true; }
+
+  String& operator+=(const String& text) { concat(text); return *this; }
+  String& operator+=(const char* text) { concat(text); return *this; }
+  String& operator+=(char c) { concat(c); return *this; }
+  String& operator+=(int value) { return *this += String(value); }
+  String& operator+=(unsigned int value) { return *this += String(value); }
+  String& operator+=(long value) { return *this += String(value); }
+  String& operator+=(unsigned long value) { return *this += String(value); }
+  String& operator+=(float value) { return *this += String(value); }
+  String& operator+=(double value) { return *this += String(value); }
+
+  bool operator==(const String& other) const { return _text == other._text; }
+  bool operator==(const char* other) const { return _text == other; }
+  bool operator!=(const String& other) const { return _text != other._text; }
+  bool operator!=(const char* other) const { return _text != other; }
+  bool operator<(const String& other) const { return _text < other._text; }
+
+private:
+  std::string _text;
+};
+
+inline String operator+(const String& a, const String& b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, const char* b) { String r(a); r += b; return r; }
+inline String operator+(const char* a, const String& b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, char b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, int b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, unsigned int b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, long b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, unsigned long b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, float b) { String r(a); r += b; return r; }
+inline String operator+(const String& a, double b) { String r(a); r += b; return r; }
+
+#endif // WSTRING_H
@@ -0,0 +1,260 @@
+/*******************************************************************************
+ * WAVEFORM.CPP - Scriptable Analog Inputs for the Native Build
+ *                Implementation
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "Waveform.h"
+#include "Config.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <strings.h>
+
+/*******************************************************************************
+ * HELPERS
+ ******************************************************************************/
+static bool parseFloat(const std::string& token, float& value) {
+  char* end;
+  value = strtof(token.c_str(), &end);
+  return !token.empty() && *end == '\0';
+}
+
+static bool parseMs(const std::string& token, uint32_t& value) {
+  char* end;
+  unsigned long parsed = strtoul(token.c_str(), &end, 10);
+  value = (uint32_t)parsed;
+  return !token.empty() && *end == '\0' && token[0] != '-';
+}
+
+/*******************************************************************************
+ * CONSTRUCTOR
+ ******************************************************************************/
+WaveformGenerator::WaveformGenerator()
+  : _random(1)
+{
+}
+
+/*******************************************************************************
+ * PARSING
+ ******************************************************************************/
+bool WaveformGenerator::_parseChannel(const std::string& token, uint8_t& channel, uint32_t& startMs) {
+  std::string name = token;
+  startMs = 0;
+
+  size_t at = token.find('@');
+  if (at != std::string::npos) {
+    name = token.substr(0, at);
+    if (!parseMs(token.substr(at + 1), startMs)) {
+      return false;
+    }
+  }
+
+  uint8_t pin;
+  if (strcasecmp(name.c_str(), "EC") == 0) {
+    pin = PIN_EC_SENSOR;
+  } else if (strcasecmp(name.c_str(), "TEMP") == 0) {
+    pin = PIN_TEMP_SENSOR;
+  } else if (strcasecmp(name.c_str(), "PH") == 0) {
+    pin = PIN_PH_SENSOR;
+  } else if (name.size() == 2 && (name[0] == 'A' || name[0] == 'a') &&
+             name[1] >= '0' && name[1] < '0' + WAVEFORM_CHANNELS) {
+    pin = A0 + (name[1] - '0');
+  } else {
+    return false;
+  }
+
+  channel = pin - A0;
+  return true;
+}
+
+bool WaveformGenerator::add(const std::string& line, std::string& error) {
+  std::istringstream stream(line);
+  std::vector<std::string> tokens;
+  std::string token;
+  while (stream >> token) {
+    tokens.push_back(token);
+  }
+
+  if (tokens.size() < 2) {
+    error = "expected <channel> <waveform>";
+    return false;
+  }
+
+  Segment segment;
+  segment.stepMs = 0;
+  segment.ramp = false;
+  segment.rampToMv = 0;
+  segment.rampMs = 0;
+  segment.noiseMv = 0;
+  segment.spikeMv = 0;
+  segment.spikeEveryMs = 0;
+  segment.lastSpike = 0;
+
+  uint8_t channel;
+  if (!_parseChannel(tokens[0], channel, segment.startMs)) {
+    error = "bad channel '" + tokens[0] + "' (A0..A7, EC, TEMP or PH, optional @ms)";
+    return false;
+  }
+
+  // === BASE ===
+  size_t i = 1;
+  float level;
+  if (tokens[i] == "ramp") {
+    if (tokens.size() < i + 4 ||
+        !parseFloat(tokens[i + 1], level) || !parseFloat(tokens[i + 2], segment.rampToMv) ||
+        !parseMs(tokens[i + 3], segment.rampMs)) {
+      error = "ramp needs <from> <to> <ms>";
+      return false;
+    }
+    segment.levels.push_back(level);
+    segment.ramp = true;
+    i += 4;
+  } else if (tokens[i] == "steps") {
+    i++;
+    while (i < tokens.size() && tokens[i] != "every") {
+      if (!parseFloat(tokens[i], level)) {
+        error = "bad step level '" + tokens[i] + "'";
+        return false;
+      }
+      segment.levels.push_back(level);
+      i++;
+    }
+    if (segment.levels.empty() || i + 1 >= tokens.size() ||
+        !parseMs(tokens[i + 1], segment.stepMs) || segment.stepMs == 0) {
+      error = "steps needs <mv> ... every <ms>";
+      return false;
+    }
+    i += 2;
+  } else if (parseFloat(tokens[i], level)) {
+    segment.levels.push_back(level);
+    i++;
+  } else {
+    error = "bad waveform '" + tokens[i] + "' (<mv>, ramp or steps)";
+    return false;
+  }
+
+  // === MODIFIERS ===
+  while (i < tokens.size()) {
+    if (tokens[i] == "noise" && i + 1 < tokens.size() &&
+        parseFloat(tokens[i + 1], segment.noiseMv) && segment.noiseMv >= 0) {
+      i += 2;
+    } else if (tokens[i] == "spike" && i + 2 < tokens.size() &&
+               parseFloat(tokens[i + 1], segment.spikeMv) &&
+               parseMs(tokens[i + 2], segment.spikeEveryMs) && segment.spikeEveryMs > 0) {
+      i += 3;
+    } else {
+      error = "bad modifier '" + tokens[i] + "' (noise <sd> or spike <mv> <every ms>)";
+      return false;
+    }
+  }
+
+  // Keep each channel ordered by start time; equal times: last one wins
+  std::vector<Segment>& segments = _channels[channel];
+  std::vector<Segment>::iterator position = segments.begin();
+  while (position != segments.end() && position->startMs <= segment.startMs) {
+    ++position;
+  }
+  segments.insert(position, segment);
+  return true;
+}
+
+bool WaveformGenerator::loadScript(const char* path) {
+  std::ifstream file(path);
+  if (!file) {
+    perror(path);
+    return false;
+  }
+
+  std::string line;
+  unsigned lineNumber = 0;
+  bool ok = true;
+  while (std::getline(file, line)) {
+    lineNumber++;
+    size_t comment = line.find('#');
+    if (comment != std::string::npos) {
+      line.erase(comment);
+    }
+    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+      continue;
+    }
+
+    std::string error;
+    if (!add(line, error)) {
+      fprintf(stderr, "%s:%u: %s\n", path, lineNumber, error.c_str());
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+/*******************************************************************************
+ * EVALUATION
+ ******************************************************************************/
+float WaveformGenerator::_baseMv(const Segment& segment, uint32_t elapsedMs) const {
+  if (segment.ramp) {
+    if (elapsedMs >= segment.rampMs) {
+      return segment.rampToMv;
+    }
+    float fraction = (float)elapsedMs / segment.rampMs;
+    return segment.levels[0] + (segment.rampToMv - segment.levels[0]) * fraction;
+  }
+
+  if (segment.stepMs > 0) {
+    size_t step = std::min<size_t>(elapsedMs / segment.stepMs, segment.levels.size() - 1);
+    return segment.levels[step];
+  }
+
+  return segment.levels[0];
+}
+
+bool WaveformGenerator::read(uint8_t pin, uint32_t nowMs, uint16_t& raw) {
+  if (pin >= A0) {
+    pin -= A0;
+  }
+  if (pin >= WAVEFORM_CHANNELS) {
+    return false;
+  }
+
+  // Latest segment that has started
+  std::vector<Segment>& segments = _channels[pin];
+  Segment* segment = NULL;
+  for (size_t i = 0; i < segments.size() && segments[i].startMs <= nowMs; i++) {
+    segment = &segments[i];
+  }
+  if (!segment) {
+    return false;
+  }
+
+  uint32_t elapsedMs = nowMs - segment->startMs;
+  float mv = _baseMv(*segment, elapsedMs);
+
+  if (segment->noiseMv > 0) {
+    std::normal_distribution<float> noise(0.0f, segment->noiseMv);
+    mv += noise(_random);
+  }
+
+  // First reading in each new period carries the spike
+  if (segment->spikeEveryMs > 0) {
+    uint32_t period = elapsedMs / segment->spikeEveryMs;
+    if (period > segment->lastSpike) {
+      segment->lastSpike = period;
+      mv += segment->spikeMv;
+    }
+  }
+
+  // Same scale the firmware converts back with (ADC_TO_MV_FACTOR)
+  float counts = mv / ADC_TO_MV_FACTOR + 0.5f;
+  raw = counts <= 0 ? 0 : counts >= ADC_MAX ? ADC_MAX : (uint16_t)counts;
+  return true;
+}
+
+/*******************************************************************************
+ * END OF WAVEFORM IMPLEMENTATION
+ ******************************************************************************/
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * WAVEFORM.H - Scriptable Analog Inputs for the Native Build
+ *
+ * Purpose:
+ *   Drives the simulated ADC of the Linux HAL with a per-channel signal
+ *   instead of a fixed reading, so host tools can be exercised against
+ *   realistic sensor behaviour: drift, noise, glitches and the level
+ *   changes of a calibration session (probe moved between buffers).
+ *
+ * Waveform lines:
+ *   <channel>[@<ms>] <base> [<modifier> ...]
+ *
+ *   channel:    A0..A7, or EC / TEMP / PH (pins from Config.h)
+ *   @ms:        Time since start at which the line takes over the
+ *               channel (default 0). Later lines replace earlier ones,
+ *               which gives step changes at fixed times.
+ *
+ *   base (all voltages in mV at the pin):
+ *     <mv>                          constant
+ *     ramp <from> <to> <ms>         linear over ms, then holds <to>
+ *     steps <mv> <mv> ... every <ms>
+ *                                   each level for ms, then holds the last
+ *
+ *   modifiers:
+ *     noise <sd>                    Gaussian noise, sd in mV
+ *     spike <mv> <every ms>         adds mv to one reading per period
+ *
+ *   Example (pH probe through the 7 / 4 / 10 buffers, 30 s each):
+ *     PH steps 2500 2677 2323 every 30000 noise 1.5
+ *
+ *   Script files hold one line each; '#' starts a comment.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef WAVEFORM_H
+#define WAVEFORM_H
+
+#include <stdint.h>
+#include <random>
+#include <string>
+#include <vector>
+
+const uint8_t WAVEFORM_CHANNELS = 8;   // A0..A7
+
+class WaveformGenerator {
+public:
+  WaveformGenerator();
+
+  /*
+   * Parse and add one waveform line. False with a message in error if
+   * the line is invalid.
+   */
+  bool add(const std::string& line, std::string& error);
+
+  /*
+   * Add every line of a script file. Errors go to stderr as file:line.
+   */
+  bool loadScript(const char* path);
+
+  /*
+   * Seed for noise (default fixed, so runs repeat exactly).
+   */
+  void setSeed(uint32_t seed) { _random.seed(seed); }
+
+  /*
+   * Raw ADC reading (0..1023) of pin at nowMs. False if no line covers
+   * the pin yet.
+   */
+  bool read(uint8_t pin, uint32_t nowMs, uint16_t& raw);
+
+private:
+  struct Segment {
+    uint32_t startMs;
+    std::vector<float> levels;   // Constant: one level; steps: one per step
+    uint32_t stepMs;             // Steps: time per level
+    bool ramp;
+    float rampToMv;
+    uint32_t rampMs;
+    float noiseMv;
+    float spikeMv;
+    uint32_t spikeEveryMs;
+    uint32_t lastSpike;          // Index of the last period that got its spike
+  };
+
+  std::vector<Segment> _channels[WAVEFORM_CHANNELS];
+  std::mt19937 _random;
+
+  float _baseMv(const Segment& segment, uint32_t elapsedMs) const;
+  static bool _parseChannel(const std::string& token, uint8_t& channel, uint32_t& startMs);
+};
+
+#endif // WAVEFORM_H
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ * MAIN.CPP - Native Linux Entry Point for the Firmware
+ *
+ * Purpose:
+ *   Runs the unmodified sketch (setup() once, then loop() forever) on the
+ *   Linux HAL, so sensor, calibration and storage logic can be exercised
+ *   without a board.
+ *
+ * Usage:
+ *   firmware_native [options]
+ *
+ *   Options:
+ *     --eeprom <file>     Keep the EEPROM in file (created blank if
+ *                         missing); default: in memory, blank every run
+ *     --pty               Serial on a new pseudo-terminal instead of
+ *                         stdin/stdout (device name printed to stderr)
+ *     --link <path>       With --pty: symlink path to the device
+ *     --adc <pin>=<raw>   Raw ADC value for A0..A7 (0..1023), e.g. A1=310
+ *     --wave "<line>"     Waveform for a channel, e.g. "PH 2500 noise 2"
+ *                         (syntax in Waveform.h); repeatable
+ *     --script <file>     Waveform lines from a file
+ *     --seed <n>          Noise seed (default 1: runs repeat exactly)
+ *
+ *   With stdin/stdout the program exits once stdin is closed and every
+ *   command has been answered:
+ *     printf 'READ\nDIAG\n' | firmware_native --eeprom unit.bin
+ *
+ *   As a device simulator for SensorReader / Calibrator:
+ *     firmware_native --pty --link /tmp/sensorbox --eeprom unit.bin \
+ *                     --script native/examples/calibration_session.wave
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include <Arduino.h>
+#include "HalLinux.h"
+#include "Waveform.h"
+#include "Hal.h"
+#include "Config.h"
+#include "CommandQueue.h"
+#include "OutputQueue.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+extern CommandQueue commandQueue;   // ArduinoBothV15.ino
+
+static WaveformGenerator waveforms;
+
+static bool readWaveform(uint8_t pin, uint16_t& raw) {
+  return waveforms.read(pin, halMillis(), raw);
+}
+
+static void usage(const char* program) {
+  fprintf(stderr,
+          "Usage: %s [--eeprom file] [--pty [--link path]] [--adc pin=raw ...]\n"
+          "          [--wave line ...] [--script file] [--seed n]\n"
+          "  --eeprom: EEPROM image file (raw %u bytes, created blank)\n"
+          "  --pty:    serial on a pseudo-terminal instead of stdin/stdout\n"
+          "  --link:   symlink to the pseudo-terminal device\n"
+          "  --adc:    raw ADC reading for A0..A7, e.g. --adc A1=310\n"
+          "  --wave:   channel waveform, e.g. --wave \"PH 2500 noise 2\"\n"
+          "  --script: file of waveform lines\n"
+          "  --seed:   noise seed\n",
+          program, (unsigned)EEPROM_SIZE);
+}
+
+/*
+ * "A1=310" or "1=310"
+ */
+static bool parseAdc(const char* arg) {
+  const char* p = arg;
+  if (*p == 'A' || *p == 'a') {
+    p++;
+  }
+  char* end;
+  long pin = strtol(p, &end, 10);
+  if (end == p || *end != '=' || pin < 0 || pin > 7) {
+    return false;
+  }
+  p = end + 1;
+  long raw = strtol(p, &end, 10);
+  if (end == p || *end != '\0' || raw < 0 || raw > 1023) {
+    return false;
+  }
+  halLinuxSetAnalog(A0 + pin, raw);
+  return true;
+}
+
+int main(int argc, char** argv) {
+  const char* eepromPath = NULL;
+  const char* linkPath = NULL;
+  bool usePty = false;
+  bool useWaveforms = false;
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    bool hasValue = i + 1 < argc;
+
+    if (strcmp(arg, "--eeprom") == 0 && hasValue) {
+      eepromPath = argv[++i];
+    } else if (strcmp(arg, "--pty") == 0) {
+      usePty = true;
+    } else if (strcmp(arg, "--link") == 0 && hasValue) {
+      linkPath = argv[++i];
+    } else if (strcmp(arg, "--adc") == 0 && hasValue) {
+      if (!parseAdc(argv[++i])) {
+        fprintf(stderr, "Bad --adc value: %s\n", argv[i]);
+        return 2;
+      }
+    } else if (strcmp(arg, "--wave") == 0 && hasValue) {
+      std::string error;
+      if (!waveforms.add(argv[++i], error)) {
+        fprintf(stderr, "Bad --wave \"%s\": %s\n", argv[i], error.c_str());
+        return 2;
+      }
+      useWaveforms = true;
+    } else if (strcmp(arg, "--script") == 0 && hasValue) {
+      if (!waveforms.loadScript(argv[++i])) {
+        return 2;
+      }
+      useWaveforms = true;
+    } else if (strcmp(arg, "--seed") == 0 && hasValue) {
+      waveforms.setSeed(strtoul(argv[++i], NULL, 10));
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  if (eepromPath && !halLinuxOpenNv(eepromPath)) {
+    return 1;
+  }
+  if (usePty && !halLinuxOpenPty(linkPath)) {
+    return 1;
+  }
+  if (useWaveforms) {
+    halLinuxSetAnalogSource(readWaveform);
+  }
+
+  setup();
+  for (;;) {
+    loop();
+
+    if (halLinuxInputClosed() && halSerialAvailable() == 0 &&
+        commandQueue.count() == 0 && SerialOut.pending() == 0) {
+      break;
+    }
+  }
+
+  halSerialFlush();
+  return 0;
+}
+
+/*******************************************************************************
+ * END OF NATIVE ENTRY POINT
+ ******************************************************************************/
@@ -0,0 +1,128 @@
+#*******************************************************************************
+# EEPROM_CORPUS.CMAKE - Boot Every Corpus Image and Check the README
+#
+# Purpose:
+#   tools/eeprom_corpus/README.md is the specification of the corpus. For
+#   each row of its table this converts the image to a raw EEPROM file
+#   (eeprom_tool convert), boots firmware_native on it and checks:
+#     - every `quoted` string of the "Expected on boot" column appears
+#     - images marked calibrated print the indented CALIBRATION STATUS
+#       block of the README
+#     - a second boot loads the image and leaves the EEPROM unchanged
+#
+# Usage (script mode, run by ctest):
+#   cmake -DFIRMWARE=<firmware_native> -DEEPROM_TOOL=<eeprom_tool>
+#         -DCORPUS=<tools/eeprom_corpus> -DWORK=<scratch dir>
+#         -P eeprom_corpus.cmake
+#
+# Author: System Rewrite v1.0 - Complete Edition
+# Date: 2026-02-16
+#*******************************************************************************
+
+if(NOT FIRMWARE OR NOT EEPROM_TOOL OR NOT CORPUS OR NOT WORK)
+  message(FATAL_ERROR "Usage: cmake -DFIRMWARE=<path> -DEEPROM_TOOL=<path> "
+                      "-DCORPUS=<dir> -DWORK=<dir> -P eeprom_corpus.cmake")
+endif()
+
+file(MAKE_DIRECTORY "${WORK}")
+file(STRINGS "${CORPUS}/README.md" readme)
+
+#*******************************************************************************
+# EXPECTED STATUS (the indented block starting with CALIBRATION STATUS)
+#*******************************************************************************
+set(status_lines)
+set(in_status FALSE)
+foreach(line IN LISTS readme)
+  if(line STREQUAL "    CALIBRATION STATUS")
+    set(in_status TRUE)
+  endif()
+  if(in_status)
+    if(NOT line MATCHES "^    ")
+      break()
+    endif()
+    string(SUBSTRING "${line}" 4 -1 text)
+    list(APPEND status_lines "${text}")
+  endif()
+endforeach()
+if(NOT status_lines)
+  message(FATAL_ERROR "README.md: no CALIBRATION STATUS block")
+endif()
+
+#*******************************************************************************
+# BOOT
+#*******************************************************************************
+function(boot image output)
+  execute_process(
+    COMMAND "${FIRMWARE}" --eeprom "${image}"
+    INPUT_FILE /dev/null
+    OUTPUT_VARIABLE text
+    ERROR_VARIABLE text
+    RESULT_VARIABLE result
+    TIMEOUT 60
+  )
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "firmware_native --eeprom ${image} failed (${result}):\n${text}")
+  endif()
+  set(${output} "${text}" PARENT_SCOPE)
+endfunction()
+
+function(expect name text wanted)
+  string(FIND "${text}" "${wanted}" at)
+  if(at EQUAL -1)
+    message(SEND_ERROR "${name}: \"${wanted}\" missing from boot output:\n${text}")
+  endif()
+endfunction()
+
+#*******************************************************************************
+# TABLE ROWS: | `file` | written by | calibrated | expected on boot |
+#*******************************************************************************
+set(count 0)
+foreach(line IN LISTS readme)
+  if(NOT line MATCHES "^\\| `([^`]+\\.hex)` \\|[^|]*\\| *(yes|no) *\\|([^|]*)\\|$")
+    continue()
+  endif()
+  set(name "${CMAKE_MATCH_1}")
+  set(calibrated "${CMAKE_MATCH_2}")
+  string(REGEX MATCHALL "`[^`]+`" wanted "${CMAKE_MATCH_3}")
+  math(EXPR count "${count} + 1")
+
+  set(image "${WORK}/${name}.bin")
+  file(REMOVE "${image}")
+  execute_process(
+    COMMAND "${EEPROM_TOOL}" convert "${CORPUS}/${name}" "${image}"
+    RESULT_VARIABLE result
+  )
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${name}: eeprom_tool convert failed")
+  endif()
+
+  # === FIRST BOOT ===
+  boot("${image}" first)
+  foreach(quoted IN LISTS wanted)
+    string(REGEX REPLACE "^`(.*)`$" "\\1" quoted "${quoted}")
+    expect("${name}" "${first}" "${quoted}")
+  endforeach()
+  if(calibrated STREQUAL "yes")
+    foreach(status IN LISTS status_lines)
+      expect("${name}" "${first}" "${status}")
+    endforeach()
+  endif()
+
+  # === SECOND BOOT: nothing left to migrate or write ===
+  file(SHA256 "${image}" before)
+  boot("${image}" second)
+  file(SHA256 "${image}" after)
+  if(NOT before STREQUAL after)
+    message(SEND_ERROR "${name}: second boot wrote to the EEPROM:\n${second}")
+  endif()
+  string(FIND "${second}" "Migrating" at)
+  if(NOT at EQUAL -1)
+    message(SEND_ERROR "${name}: second boot migrated again:\n${second}")
+  endif()
+
+  message(STATUS "${name}: OK")
+endforeach()
+
+if(count EQUAL 0)
+  message(FATAL_ERROR "README.md: no corpus images in the table")
+endif()
@@ -0,0 +1,158 @@
+/*******************************************************************************
+ * FORMAT_EQUIVALENCE.CPP - FastFormat Against Print::print(float, digits)
+ *
+ * Purpose:
+ *   FastFormat.h promises byte-for-byte the output of the AVR
+ *   Print::printFloat. This checks formatFixed() and printFixed() against
+ *   Print::print(value, digits) (native/Print.cpp, the AVR algorithm in
+ *   32-bit float) for 0..FORMAT_MAX_DIGITS decimal places:
+ *     - fixed edge cases: +-0, rounding carries (9.995, 0.5, 99.9999999),
+ *       values around the ovf limit, nan, +-inf
+ *     - random floats: uniform over every bit pattern (all exponents) and
+ *       uniform over the sensor ranges (EC, temperature, pH, millivolts)
+ *
+ * Usage:
+ *   format_equivalence [random count per digit setting]   (via ctest)
+ *
+ *   Prints the first mismatches and exits 1 if there are any.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include <Arduino.h>
+#include "FastFormat.h"
+
+#include <limits>
+#include <random>
+#include <string>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ * CAPTURE
+ ******************************************************************************/
+class StringPrint : public Print {
+public:
+  virtual size_t write(uint8_t c) { text += (char)c; return 1; }
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    text.append((const char*)buffer, size);
+    return size;
+  }
+  using Print::write;
+
+  std::string text;
+};
+
+static const unsigned MAX_REPORTED = 20;
+static unsigned failures = 0;
+static unsigned long checks = 0;
+
+static void report(const char* what, float value, uint8_t digits,
+                   const std::string& expected, const std::string& actual) {
+  failures++;
+  if (failures <= MAX_REPORTED) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    fprintf(stderr, "FAIL %s(%.9g [0x%08X], %u): expected \"%s\", got \"%s\"\n",
+            what, value, (unsigned)bits, digits, expected.c_str(), actual.c_str());
+  }
+}
+
+static void check(float value, uint8_t digits) {
+  StringPrint reference;
+  size_t referenceLength = reference.print(value, digits);
+
+  char buf[FORMAT_BUFFER_SIZE];
+  uint8_t length = formatFixed(buf, value, digits);
+  std::string formatted(buf, length);
+  if (formatted != reference.text || strlen(buf) != length) {
+    report("formatFixed", value, digits, reference.text, formatted);
+  }
+
+  StringPrint printed;
+  size_t printedLength = printFixed(printed, value, digits);
+  if (printed.text != reference.text || printedLength != referenceLength) {
+    report("printFixed", value, digits, reference.text, printed.text);
+  }
+
+  StringPrint printedLine;
+  printlnFixed(printedLine, value, digits);
+  if (printedLine.text != reference.text + "\r\n") {
+    report("printlnFixed", value, digits, reference.text + "\\r\\n", printedLine.text);
+  }
+  checks++;
+}
+
+/*******************************************************************************
+ * EDGE CASES
+ ******************************************************************************/
+static void checkEdgeCases() {
+  static const float values[] = {
+    0.0f, 0.5f, 0.05f, 0.005f, 1.0f, 9.5f, 9.95f, 9.995f, 9.9995f,
+    0.9999999f, 99.9999999f, 999.9995f, 0.125f, 0.375f, 2.675f, 1.005f,
+    0.1f, 0.2f, 0.3f, 1e-3f, 1e-5f, 1e-8f, 1e-9f, 1e-20f, 1e-38f, 1e-45f,
+    7.0f, 14.0f, 25.0f, 1413.0f, 12880.0f, 2500.0f, -59.16f, 4.999999f,
+    16777215.0f, 16777216.0f, 16777217.0f, 123456789.0f, 1e9f,
+    4294967040.0f, 4294967296.0f, 1e10f, 3.4e38f,
+    std::numeric_limits<float>::max(),
+    std::numeric_limits<float>::min(),
+    std::numeric_limits<float>::denorm_min(),
+    std::numeric_limits<float>::infinity(),
+    std::numeric_limits<float>::quiet_NaN()
+  };
+
+  for (uint8_t digits = 0; digits <= FORMAT_MAX_DIGITS; digits++) {
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+      check(values[i], digits);
+      check(-values[i], digits);
+    }
+  }
+}
+
+/*******************************************************************************
+ * RANDOM VALUES
+ ******************************************************************************/
+static void checkRandom(unsigned long count) {
+  std::mt19937 rng(20260216);
+  std::uniform_real_distribution<float> sensorRanges[] = {
+    std::uniform_real_distribution<float>(0.0f, 20000.0f),   // EC µS/cm
+    std::uniform_real_distribution<float>(-10.0f, 100.0f),   // Temperature °C
+    std::uniform_real_distribution<float>(0.0f, 14.0f),      // pH
+    std::uniform_real_distribution<float>(-5000.0f, 5000.0f) // Millivolts
+  };
+  const size_t rangeCount = sizeof(sensorRanges) / sizeof(sensorRanges[0]);
+
+  for (uint8_t digits = 0; digits <= FORMAT_MAX_DIGITS; digits++) {
+    for (unsigned long i = 0; i < count; i++) {
+      uint32_t bits = rng();
+      float value;
+      memcpy(&value, &bits, sizeof(value));
+      check(value, digits);
+
+      check(sensorRanges[i % rangeCount](rng), digits);
+    }
+  }
+}
+
+/*******************************************************************************
+ * MAIN
+ ******************************************************************************/
+int main(int argc, char** argv) {
+  unsigned long count = 100000;
+  if (argc > 1) {
+    count = strtoul(argv[1], NULL, 10);
+  }
+
+  checkEdgeCases();
+  checkRandom(count);
+
+  if (failures > 0) {
+    fprintf(stderr, "%u of %lu checks failed\n", failures, checks);
+    return 1;
+  }
+  printf("%lu checks passed (digits 0-%u)\n", checks, FORMAT_MAX_DIGITS);
+  return 0;
+}
@@ -0,0 +1,114 @@
+/*******************************************************************************
+ * PROFILE_SELECT.CPP - Switching to a Profile With a Damaged Record
+ *
+ * Purpose:
+ *   EEPROMManager::selectProfile() must not make a profile active when
+ *   all of its records fail validation: the calibration in RAM belongs to
+ *   the current profile, and the next SAVE has to file it there. Checks,
+ *   on the in-memory EEPROM of the Linux HAL:
+ *     - selecting an empty profile succeeds (LOAD_EMPTY) and switches
+ *     - selecting a profile whose only record is damaged returns
+ *       LOAD_CORRUPT, keeps the active profile (also across a reboot)
+ *       and leaves the calibration untouched
+ *     - a SAVE afterwards lands in the still-active profile
+ *
+ * Usage:
+ *   profile_select   (via ctest; exits 1 on the first failed check)
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include <Arduino.h>
+#include "HalLinux.h"
+#include "Hal.h"
+#include "Config.h"
+#include "SensorReader.h"
+#include "Calibration.h"
+#include "EEPROMManager.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static SensorReader sensor(PIN_EC_SENSOR, PIN_TEMP_SENSOR, PIN_PH_SENSOR);
+
+#define CHECK(condition)                                              \
+  do {                                                                \
+    if (!(condition)) {                                               \
+      fprintf(stderr, "FAIL %s:%d: %s\n", __FILE__, __LINE__, #condition); \
+      exit(1);                                                        \
+    }                                                                 \
+  } while (0)
+
+/*
+ * 3-point pH calibration whose neutral point sits at neutralMv
+ */
+static void calibratepH(Calibration& cal, float neutralMv) {
+  cal.forcepHPoint(0, neutralMv + 180);
+  cal.forcepHPoint(1, neutralMv);
+  cal.forcepHPoint(2, neutralMv - 178);
+}
+
+static float pHOffset(const Calibration& cal) {
+  float C, D, R2, RMSE;
+  cal.getpHEquation(C, D, R2, RMSE);
+  return D;
+}
+
+int main() {
+  halLinuxDiscardSerial();
+  sensor.begin();
+
+  // === PROFILE 0 AND PROFILE 1, ONE RECORD EACH ===
+  Calibration cal(&sensor);
+  cal.begin();
+  EEPROMManager eeprom;
+  CHECK(!eeprom.load(cal));
+
+  calibratepH(cal, 2500);
+  CHECK(eeprom.save(cal));
+
+  CHECK(eeprom.selectProfile(1, cal) == EEPROMManager::LOAD_EMPTY);
+  CHECK(eeprom.getProfile() == 1);
+  calibratepH(cal, 2400);
+  CHECK(eeprom.save(cal));
+  uint8_t damagedSlot = eeprom.getActiveSlot();
+
+  CHECK(eeprom.selectProfile(0, cal) == EEPROMManager::LOAD_OK);
+  CHECK(eeprom.getProfile() == 0);
+  float profile0Offset = pHOffset(cal);
+
+  // === DAMAGE PROFILE 1's ONLY RECORD (one bit in its pH equation) ===
+  uint16_t address = damagedSlot * JOURNAL_RECORD_SIZE + offsetof(JournalRecord, image) +
+                     offsetof(CalImage, pHEq);
+  uint8_t cell;
+  eeprom.readRaw(address, &cell, 1);
+  cell ^= 0x01;
+  CHECK(eeprom.writeRaw(address, &cell, 1));
+
+  // === SELECTING IT FAILS AND CHANGES NOTHING ===
+  CHECK(eeprom.selectProfile(1, cal) == EEPROMManager::LOAD_CORRUPT);
+  CHECK(eeprom.getProfile() == 0);
+  CHECK(pHOffset(cal) == profile0Offset);
+
+  Calibration rebooted(&sensor);
+  rebooted.begin();
+  EEPROMManager afterReboot;
+  CHECK(afterReboot.load(rebooted));
+  CHECK(afterReboot.getProfile() == 0);
+  CHECK(pHOffset(rebooted) == profile0Offset);
+
+  // === THE NEXT SAVE STAYS IN PROFILE 0 ===
+  calibratepH(cal, 2450);
+  CHECK(eeprom.save(cal));
+  uint8_t savedSlot = eeprom.getActiveSlot();
+  CHECK(savedSlot != damagedSlot);
+  uint8_t savedProfile;
+  eeprom.readRaw(savedSlot * JOURNAL_RECORD_SIZE + offsetof(JournalRecord, image) +
+                 offsetof(CalImage, profile), &savedProfile, 1);
+  CHECK(savedProfile == 0);
+  CHECK(eeprom.selectProfile(1, cal) == EEPROMManager::LOAD_CORRUPT);
+
+  printf("Damaged profile not selected, profile 0 kept\n");
+  return 0;
+}
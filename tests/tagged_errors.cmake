@@ -0,0 +1,70 @@
+#*******************************************************************************
+# TAGGED_ERRORS.CMAKE - Rejected Lines Still Get Their "#<id> ERR"
+#
+# Purpose:
+#   Lines the command queue does not keep (longer than CMD_LINE_MAX, or
+#   beyond the pipelining limit CMD_QUEUE_DEPTH) must be answered with the
+#   tagged error and the "#<id> ERR" terminator, or a pipelining host waits
+#   for them until it times out. Feeds firmware_native one burst of:
+#     - an overlong tagged line, an overlong untagged line, a tagged READ
+#     - then more tagged commands than the queue holds
+#
+# Usage (script mode, run by ctest):
+#   cmake -DFIRMWARE=<firmware_native> -DWORK=<scratch dir> -P tagged_errors.cmake
+#
+# Author: System Rewrite v1.0 - Complete Edition
+# Date: 2026-02-16
+#*******************************************************************************
+
+if(NOT FIRMWARE OR NOT WORK)
+  message(FATAL_ERROR "Usage: cmake -DFIRMWARE=<path> -DWORK=<dir> -P tagged_errors.cmake")
+endif()
+
+file(MAKE_DIRECTORY "${WORK}")
+
+function(run name input output)
+  file(WRITE "${WORK}/${name}.txt" "${input}")
+  execute_process(
+    COMMAND "${FIRMWARE}"
+    INPUT_FILE "${WORK}/${name}.txt"
+    OUTPUT_VARIABLE text
+    ERROR_VARIABLE text
+    RESULT_VARIABLE result
+    TIMEOUT 60
+  )
+  if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${name}: firmware_native failed (${result}):\n${text}")
+  endif()
+  set(${output} "${text}" PARENT_SCOPE)
+endfunction()
+
+# execute_process turns the firmware's CR LF line endings into LF
+function(expect name text wanted)
+  string(FIND "${text}" "${wanted}" at)
+  if(at EQUAL -1)
+    message(SEND_ERROR "${name}: \"${wanted}\" missing from output:\n${text}")
+  endif()
+endfunction()
+
+string(REPEAT "X" 80 long)
+
+# === OVERLONG LINES ===
+run(too_long "#6 ${long}\n${long}\n#7 READ\n" out)
+expect(too_long "${out}" "#6 ERROR: Command too long\n#6 ERR\n")
+expect(too_long "${out}" "\nERROR: Command too long\n")
+expect(too_long "${out}" "#7 OK\n")
+
+# === MORE IN FLIGHT THAN THE QUEUE HOLDS ===
+set(burst "")
+foreach(id RANGE 1 8)
+  string(APPEND burst "#${id} TASKS\n")
+endforeach()
+run(busy "${burst}" out)
+foreach(id RANGE 1 8)
+  string(REGEX MATCH "#${id} (OK|ERR)\n" terminator "${out}")
+  if(NOT terminator)
+    message(SEND_ERROR "busy: no terminator for #${id}:\n${out}")
+  endif()
+endforeach()
+expect(busy "${out}" "#1 OK\n")
+expect(busy "${out}" "#8 ERROR: Busy\n#8 ERR\n")
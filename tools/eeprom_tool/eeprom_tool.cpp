@@ -0,0 +1,539 @@
+/*******************************************************************************
+ * EEPROM_TOOL.CPP - Host CLI for EEPROM Backup / Restore (Fleet Cloning)
+ *
+ * Purpose:
+ *   Copies the complete 1 KB EEPROM of a sensor box (calibration journal,
+ *   calibration history) to a file and back, using the firmware's
+ *   EEDUMP / EELOAD commands. Provisioning a new unit from a reference
+ *   unit takes a few seconds instead of a full calibration session.
+ *
+ * Usage:
+ *   eeprom_tool backup  <port> <file>   Read the unit's EEPROM into file
+ *   eeprom_tool restore <port> <file>   Write file to the unit
+ *   eeprom_tool convert <in> <out>      Convert between HEX and raw
+ *                                       binary (no unit needed), e.g.
+ *                                       for firmware_native --eeprom
+ *
+ *   Options (before the command):
+ *     -b <baud>   Serial speed (default 115200)
+ *     -n          Don't wait for the boot banner (port does not reset
+ *                 the board on open, e.g. a simulator PTY)
+ *
+ *   <file> ending in .hex is Intel HEX, the format of
+ *   "avrdude -U eeprom:r:<file>:i", so backups can also be flashed with
+ *   avrdude and tools/eeprom_corpus images can be restored directly.
+ *   Any other name is a raw 1024-byte binary.
+ *
+ * Protocol:
+ *   Tagged commands ("#<id> CMD"), so every reply line carries the tag
+ *   and ends with "#<id> OK" or "#<id> ERR" (see ArduinoBothV15.ino).
+ *   Each 16-byte block carries a CRC16 (CCITT, init 0xFFFF) in both
+ *   directions. EELOAD blocks are sent one at a time; the unit reads
+ *   each block back from EEPROM before it answers OK. After the last
+ *   block the unit reloads its calibration from the new image (and
+ *   upgrades it if it came from older firmware, so a read-back of the
+ *   whole EEPROM may legitimately differ from the file).
+ *
+ * Build (Linux / macOS):
+ *   g++ -std=c++11 -O2 -Wall -o eeprom_tool eeprom_tool.cpp
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/select.h>
+#include <sys/time.h>
+#include <termios.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ * SETTINGS (must match ArduinoBothV15/Config.h)
+ ******************************************************************************/
+static const size_t   EEPROM_SIZE      = 1024;
+static const size_t   EE_CHUNK_BYTES   = 16;
+static const int      BOOT_WAIT_MS     = 3000;   // Uno resets when the port opens
+static const int      REPLY_TIMEOUT_MS = 5000;
+
+typedef std::vector<unsigned char> Image;
+
+/*******************************************************************************
+ * CRC-16-CCITT (same as ArduinoBothV15/CRC16.cpp)
+ ******************************************************************************/
+static unsigned short crc16(const unsigned char* data, size_t length) {
+  unsigned short crc = 0xFFFF;
+  for (size_t i = 0; i < length; i++) {
+    crc ^= (unsigned short)(data[i] << 8);
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc & 0x8000) ? (unsigned short)((crc << 1) ^ 0x1021)
+                           : (unsigned short)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+static long nowMs() {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec * 1000L + tv.tv_usec / 1000;
+}
+
+/*******************************************************************************
+ * CLASS: SerialPort - raw 8N1 line I/O on a POSIX tty
+ ******************************************************************************/
+class SerialPort {
+public:
+  SerialPort() : _fd(-1) {}
+  ~SerialPort() { if (_fd >= 0) close(_fd); }
+
+  bool open(const char* path, long baud) {
+    _fd = ::open(path, O_RDWR | O_NOCTTY);
+    if (_fd < 0) {
+      fprintf(stderr, "ERROR: Cannot open %s: %s\n", path, strerror(errno));
+      return false;
+    }
+
+    struct termios tio;
+    if (tcgetattr(_fd, &tio) != 0) {
+      fprintf(stderr, "ERROR: %s is not a serial port\n", path);
+      return false;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+
+    speed_t speed = _speed(baud);
+    if (speed == 0) {
+      fprintf(stderr, "ERROR: Unsupported baud rate %ld\n", baud);
+      return false;
+    }
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+
+    if (tcsetattr(_fd, TCSANOW, &tio) != 0) {
+      fprintf(stderr, "ERROR: Cannot configure %s\n", path);
+      return false;
+    }
+    return true;
+  }
+
+  bool writeLine(const std::string& line) {
+    std::string out = line + "\n";
+    size_t sent = 0;
+    while (sent < out.size()) {
+      ssize_t n = write(_fd, out.data() + sent, out.size() - sent);
+      if (n < 0) {
+        if (errno == EINTR || errno == EAGAIN) continue;
+        return false;
+      }
+      sent += (size_t)n;
+    }
+    return true;
+  }
+
+  // One line without "\r\n"; false on timeout
+  bool readLine(std::string& line, int timeoutMs) {
+    long deadline = nowMs() + timeoutMs;
+
+    for (;;) {
+      size_t eol = _rx.find('\n');
+      if (eol != std::string::npos) {
+        line = _rx.substr(0, eol);
+        _rx.erase(0, eol + 1);
+        if (!line.empty() && line[line.size() - 1] == '\r') {
+          line.erase(line.size() - 1);
+        }
+        return true;
+      }
+
+      long left = deadline - nowMs();
+      if (left <= 0) {
+        return false;
+      }
+
+      fd_set set;
+      FD_ZERO(&set);
+      FD_SET(_fd, &set);
+      struct timeval tv = { left / 1000, (left % 1000) * 1000 };
+      if (select(_fd + 1, &set, NULL, NULL, &tv) <= 0) {
+        continue;
+      }
+
+      char buf[256];
+      ssize_t n = read(_fd, buf, sizeof(buf));
+      if (n > 0) {
+        _rx.append(buf, (size_t)n);
+      }
+    }
+  }
+
+  void discardInput() {
+    tcflush(_fd, TCIFLUSH);
+    _rx.clear();
+  }
+
+private:
+  int _fd;
+  std::string _rx;
+
+  static speed_t _speed(long baud) {
+    switch (baud) {
+      case 9600:   return B9600;
+      case 19200:  return B19200;
+      case 38400:  return B38400;
+      case 57600:  return B57600;
+      case 115200: return B115200;
+      default:     return 0;
+    }
+  }
+};
+
+/*******************************************************************************
+ * IMAGE FILES (Intel HEX or raw binary)
+ ******************************************************************************/
+static bool endsWith(const std::string& s, const char* suffix) {
+  size_t n = strlen(suffix);
+  return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+}
+
+static bool writeImageFile(const std::string& path, const Image& image) {
+  FILE* f = fopen(path.c_str(), endsWith(path, ".hex") ? "w" : "wb");
+  if (f == NULL) {
+    fprintf(stderr, "ERROR: Cannot write %s: %s\n", path.c_str(), strerror(errno));
+    return false;
+  }
+
+  if (endsWith(path, ".hex")) {
+    // 32 data bytes per record, like avrdude
+    for (size_t addr = 0; addr < image.size(); addr += 32) {
+      size_t len = image.size() - addr < 32 ? image.size() - addr : 32;
+      unsigned sum = (unsigned)len + (unsigned)(addr >> 8) + (unsigned)(addr & 0xFF);
+      fprintf(f, ":%02X%04X00", (unsigned)len, (unsigned)addr);
+      for (size_t i = 0; i < len; i++) {
+        fprintf(f, "%02X", image[addr + i]);
+        sum += image[addr + i];
+      }
+      fprintf(f, "%02X\n", (unsigned)(-sum & 0xFF));
+    }
+    fprintf(f, ":00000001FF\n");
+  } else {
+    fwrite(image.data(), 1, image.size(), f);
+  }
+
+  return fclose(f) == 0;
+}
+
+static int hexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  return -1;
+}
+
+// Parse count bytes of hex text; false on a non-hex character
+static bool parseHex(const std::string& text, size_t pos, size_t count,
+                     unsigned char out[]) {
+  if (text.size() < pos + 2 * count) {
+    return false;
+  }
+  for (size_t i = 0; i < count; i++) {
+    int hi = hexValue(text[pos + 2 * i]);
+    int lo = hexValue(text[pos + 2 * i + 1]);
+    if (hi < 0 || lo < 0) {
+      return false;
+    }
+    out[i] = (unsigned char)((hi << 4) | lo);
+  }
+  return true;
+}
+
+static bool readImageFile(const std::string& path, Image& image) {
+  FILE* f = fopen(path.c_str(), "rb");
+  if (f == NULL) {
+    fprintf(stderr, "ERROR: Cannot read %s: %s\n", path.c_str(), strerror(errno));
+    return false;
+  }
+
+  // Cells not mentioned in a HEX file stay erased
+  image.assign(EEPROM_SIZE, 0xFF);
+  size_t size = 0;
+  bool ok = true;
+
+  if (endsWith(path, ".hex")) {
+    char buf[600];
+    int lineNo = 0;
+    while (ok && fgets(buf, sizeof(buf), f) != NULL) {
+      lineNo++;
+      std::string line(buf);
+      while (!line.empty() && (line[line.size() - 1] == '\n' || line[line.size() - 1] == '\r')) {
+        line.erase(line.size() - 1);
+      }
+      if (line.empty()) continue;
+
+      unsigned char rec[260];
+      if (line[0] != ':' || (line.size() - 1) % 2 != 0 ||
+          !parseHex(line, 1, (line.size() - 1) / 2, rec)) {
+        fprintf(stderr, "ERROR: %s:%d: not an Intel HEX record\n", path.c_str(), lineNo);
+        ok = false;
+        break;
+      }
+
+      size_t recLen = (line.size() - 1) / 2;
+      unsigned sum = 0;
+      for (size_t i = 0; i < recLen; i++) sum += rec[i];
+      if (recLen < 5 || rec[0] + 5u != recLen || (sum & 0xFF) != 0) {
+        fprintf(stderr, "ERROR: %s:%d: bad record length or checksum\n", path.c_str(), lineNo);
+        ok = false;
+        break;
+      }
+
+      unsigned type = rec[3];
+      if (type == 1) break;          // End of file
+      if (type != 0) continue;       // Segment/linear address records: unused below 64 KB
+
+      size_t addr = ((size_t)rec[1] << 8) | rec[2];
+      if (addr + rec[0] > EEPROM_SIZE) {
+        fprintf(stderr, "ERROR: %s:%d: data beyond %zu bytes\n", path.c_str(), lineNo, EEPROM_SIZE);
+        ok = false;
+        break;
+      }
+      memcpy(&image[addr], &rec[4], rec[0]);
+      if (addr + rec[0] > size) size = addr + rec[0];
+    }
+  } else {
+    size = fread(image.data(), 1, EEPROM_SIZE, f);
+    if (fgetc(f) != EOF) {
+      fprintf(stderr, "ERROR: %s is larger than %zu bytes\n", path.c_str(), EEPROM_SIZE);
+      ok = false;
+    } else if (size != EEPROM_SIZE) {
+      fprintf(stderr, "ERROR: %s has %zu bytes, expected %zu\n", path.c_str(), size, EEPROM_SIZE);
+      ok = false;
+    }
+  }
+
+  fclose(f);
+  return ok;
+}
+
+/*******************************************************************************
+ * DEVICE PROTOCOL
+ ******************************************************************************/
+static unsigned g_tag = 0;
+
+// Send one tagged command and collect its reply lines (tag stripped).
+// Returns false on timeout or a closing "#<id> ERR".
+static bool transact(SerialPort& port, const std::string& command,
+                     std::vector<std::string>& reply) {
+  char prefix[16];
+  g_tag = g_tag % 99999 + 1;
+  snprintf(prefix, sizeof(prefix), "#%u ", g_tag);
+  std::string tag(prefix);
+
+  reply.clear();
+  if (!port.writeLine(tag + command)) {
+    fprintf(stderr, "ERROR: Write to port failed\n");
+    return false;
+  }
+
+  std::string line;
+  while (port.readLine(line, REPLY_TIMEOUT_MS)) {
+    if (line.compare(0, tag.size(), tag) != 0) {
+      continue;                      // Untagged output (boot banner, ...)
+    }
+    std::string body = line.substr(tag.size());
+    if (body == "OK") return true;
+    if (body == "ERR") {
+      for (size_t i = 0; i < reply.size(); i++) {
+        fprintf(stderr, "  %s\n", reply[i].c_str());
+      }
+      return false;
+    }
+    reply.push_back(body);
+  }
+
+  fprintf(stderr, "ERROR: No reply to \"%s\"\n", command.c_str());
+  return false;
+}
+
+static void waitForBoot(SerialPort& port) {
+  std::string line;
+  long deadline = nowMs() + BOOT_WAIT_MS;
+  long left;
+  while ((left = deadline - nowMs()) > 0 && port.readLine(line, (int)left)) {
+    if (line == "Ready.") break;
+  }
+  port.discardInput();
+}
+
+// EEDUMP -> image, checking every block's CRC16
+static bool dumpDevice(SerialPort& port, Image& image) {
+  std::vector<std::string> reply;
+  if (!transact(port, "EEDUMP", reply)) {
+    return false;
+  }
+
+  image.assign(EEPROM_SIZE, 0xFF);
+  size_t received = 0;
+
+  for (size_t i = 0; i < reply.size(); i++) {
+    unsigned long offset;
+    char hex[2 * EE_CHUNK_BYTES + 1];
+    unsigned crcValue;
+    if (sscanf(reply[i].c_str(), "EELOAD %lu %32s %4x", &offset, hex, &crcValue) != 3) {
+      continue;                      // "EEDUMP 1024", "EEDUMP END"
+    }
+
+    unsigned char block[EE_CHUNK_BYTES];
+    if (offset != received || offset + EE_CHUNK_BYTES > EEPROM_SIZE ||
+        strlen(hex) != 2 * EE_CHUNK_BYTES ||
+        !parseHex(hex, 0, EE_CHUNK_BYTES, block)) {
+      fprintf(stderr, "ERROR: Bad EEDUMP line: %s\n", reply[i].c_str());
+      return false;
+    }
+    if (crc16(block, EE_CHUNK_BYTES) != crcValue) {
+      fprintf(stderr, "ERROR: CRC mismatch in block at offset %lu\n", offset);
+      return false;
+    }
+
+    memcpy(&image[offset], block, EE_CHUNK_BYTES);
+    received += EE_CHUNK_BYTES;
+  }
+
+  if (received != EEPROM_SIZE) {
+    fprintf(stderr, "ERROR: EEDUMP returned %zu of %zu bytes\n", received, EEPROM_SIZE);
+    return false;
+  }
+  return true;
+}
+
+// image -> EELOAD, one acknowledged block at a time
+static bool loadDevice(SerialPort& port, const Image& image) {
+  std::vector<std::string> reply;
+
+  for (size_t offset = 0; offset < EEPROM_SIZE; offset += EE_CHUNK_BYTES) {
+    char line[64];
+    int n = snprintf(line, sizeof(line), "EELOAD %zu ", offset);
+    for (size_t i = 0; i < EE_CHUNK_BYTES; i++) {
+      n += snprintf(line + n, sizeof(line) - n, "%02X", image[offset + i]);
+    }
+    snprintf(line + n, sizeof(line) - n, " %04X", crc16(&image[offset], EE_CHUNK_BYTES));
+
+    if (!transact(port, line, reply)) {
+      fprintf(stderr, "ERROR: Block at offset %zu rejected\n", offset);
+      return false;
+    }
+  }
+
+  // Reply to the last block: the unit's reload of the new image
+  for (size_t i = 0; i < reply.size(); i++) {
+    printf("  %s\n", reply[i].c_str());
+  }
+  return true;
+}
+
+/*******************************************************************************
+ * COMMANDS
+ ******************************************************************************/
+static int cmdBackup(SerialPort& port, const std::string& file) {
+  long start = nowMs();
+  Image image;
+  if (!dumpDevice(port, image) || !writeImageFile(file, image)) {
+    return 1;
+  }
+  printf("Backed up %zu bytes to %s in %.1f s\n", image.size(), file.c_str(),
+         (nowMs() - start) / 1000.0);
+  return 0;
+}
+
+static int cmdRestore(SerialPort& port, const std::string& file) {
+  Image image;
+  if (!readImageFile(file, image)) {
+    return 1;
+  }
+
+  long start = nowMs();
+  if (!loadDevice(port, image)) {
+    return 1;
+  }
+
+  printf("Restored %zu bytes from %s in %.1f s\n", image.size(),
+         file.c_str(), (nowMs() - start) / 1000.0);
+  return 0;
+}
+
+static int cmdConvert(const std::string& in, const std::string& out) {
+  Image image;
+  if (!readImageFile(in, image) || !writeImageFile(out, image)) {
+    return 1;
+  }
+  return 0;
+}
+
+static void usage() {
+  fprintf(stderr,
+          "Usage: eeprom_tool [-b baud] [-n] backup  <port> <file>\n"
+          "       eeprom_tool [-b baud] [-n] restore <port> <file>\n"
+          "       eeprom_tool convert <in> <out>\n"
+          "  <file>: .hex = Intel HEX (avrdude), anything else = raw binary\n"
+          "  -n: port does not reset the board, skip the boot wait\n");
+}
+
+/*******************************************************************************
+ * MAIN
+ ******************************************************************************/
+int main(int argc, char** argv) {
+  long baud = 115200;
+  bool waitBoot = true;
+
+  int arg = 1;
+  while (arg < argc && argv[arg][0] == '-') {
+    if (strcmp(argv[arg], "-b") == 0 && arg + 1 < argc) {
+      baud = strtol(argv[arg + 1], NULL, 10);
+      arg += 2;
+    } else if (strcmp(argv[arg], "-n") == 0) {
+      waitBoot = false;
+      arg++;
+    } else {
+      usage();
+      return 2;
+    }
+  }
+
+  if (argc - arg != 3) {
+    usage();
+    return 2;
+  }
+  std::string command = argv[arg];
+  const char* portPath = argv[arg + 1];
+  std::string file = argv[arg + 2];
+
+  if (command == "convert") {
+    return cmdConvert(portPath, file);
+  }
+  if (command != "backup" && command != "restore") {
+    usage();
+    return 2;
+  }
+
+  SerialPort port;
+  if (!port.open(portPath, baud)) {
+    return 1;
+  }
+  if (waitBoot) {
+    waitForBoot(port);
+  }
+
+  return command == "backup" ? cmdBackup(port, file) : cmdRestore(port, file);
+}
+
+/*******************************************************************************
+ * END OF EEPROM_TOOL
+ ******************************************************************************/
@@ -0,0 +1,321 @@
+/*******************************************************************************
+ * BENCH.CPP - Microbenchmark Harness (Host and AVR) Implementation
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "Bench.h"
+#include "Config.h"
+
+#if defined(__AVR__)
+#include <avr/interrupt.h>
+#else
+#include <chrono>
+#endif
+
+/*******************************************************************************
+ * SETTINGS
+ ******************************************************************************/
+#if defined(__AVR__)
+const uint32_t BENCH_MAX_ITERATIONS = 1000000UL;
+#else
+const uint32_t BENCH_MAX_ITERATIONS = 1000000000UL;
+#endif
+
+const uint8_t BENCH_NAME_WIDTH = 36;
+
+/*******************************************************************************
+ * CLOCK
+ ******************************************************************************/
+#if defined(__AVR__)
+
+static volatile uint16_t timerOverflows;
+
+ISR(TIMER1_OVF_vect) {
+  timerOverflows++;
+}
+
+static void clockStart() {
+  TIMSK0 &= ~_BV(TOIE0);   // millis() tick off for the run
+  TCCR1A = 0;
+  TCCR1B = 0;
+  TCNT1 = 0;
+  timerOverflows = 0;
+  TIFR1 = _BV(TOV1);
+  TIMSK1 = _BV(TOIE1);
+  TCCR1B = _BV(CS10);      // F_CPU, no prescaler
+}
+
+static BenchTicks clockStop() {
+  TCCR1B = 0;
+  uint32_t cycles = ((uint32_t)timerOverflows << 16) | TCNT1;
+  if (TIFR1 & _BV(TOV1)) {
+    cycles += 0x10000UL;   // Overflow not serviced before the stop
+    TIFR1 = _BV(TOV1);
+  }
+  TIMSK1 = 0;
+  TIMSK0 |= _BV(TOIE0);
+  return cycles;
+}
+
+static float ticksToSeconds(BenchTicks ticks) {
+  return (float)ticks / F_CPU;
+}
+
+#else
+
+static std::chrono::steady_clock::time_point clockStartTime;
+
+static void clockStart() {
+  clockStartTime = std::chrono::steady_clock::now();
+}
+
+static BenchTicks clockStop() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now() - clockStartTime).count();
+}
+
+static float ticksToSeconds(BenchTicks ticks) {
+  return ticks / 1e9;
+}
+
+#endif // __AVR__
+
+void BenchState::_start() {
+  _started = true;
+  clockStart();
+}
+
+void BenchState::_stop() {
+  if (_started) {
+    _ticks = clockStop();
+    _started = false;
+  }
+}
+
+/*******************************************************************************
+ * REGISTRATION
+ ******************************************************************************/
+static BenchCase* benchHead = NULL;
+
+BenchCase::BenchCase(const char* name, BenchFunction function)
+  : name(name),
+    function(function),
+    next(benchHead)
+{
+  benchHead = this;
+}
+
+/*
+ * strcmp for two PROGMEM strings
+ */
+static int compareNames(const char* a, const char* b) {
+  for (;;) {
+    uint8_t ca = pgm_read_byte(a++);
+    uint8_t cb = pgm_read_byte(b++);
+    if (ca != cb || ca == 0) {
+      return (int)ca - (int)cb;
+    }
+  }
+}
+
+/*
+ * Does the PROGMEM name contain filter (RAM)?
+ */
+static bool nameMatches(const char* name, const char* filter) {
+  if (filter == NULL || filter[0] == 0) {
+    return true;
+  }
+  size_t nameLength = strlen_P(name);
+  size_t filterLength = strlen(filter);
+  for (size_t start = 0; start + filterLength <= nameLength; start++) {
+    size_t i = 0;
+    while (i < filterLength && (char)pgm_read_byte(name + start + i) == filter[i]) {
+      i++;
+    }
+    if (i == filterLength) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/*
+ * Next case in name order after previous (NULL: first)
+ */
+static BenchCase* nextByName(BenchCase* previous) {
+  BenchCase* best = NULL;
+  for (BenchCase* c = benchHead; c != NULL; c = c->next) {
+    if (previous != NULL && compareNames(c->name, previous->name) <= 0) {
+      continue;
+    }
+    if (best == NULL || compareNames(c->name, best->name) < 0) {
+      best = c;
+    }
+  }
+  return best;
+}
+
+void benchList(Print& out) {
+  for (BenchCase* c = nextByName(NULL); c != NULL; c = nextByName(c)) {
+    out.println((const __FlashStringHelper*)c->name);
+  }
+}
+
+/*******************************************************************************
+ * MEASUREMENT
+ *
+ * Same growth rule as Google Benchmark: start with one iteration, then
+ * scale by the shortfall (x1.4 margin, between x2 and x10) until a run
+ * lasts minTimeS.
+ ******************************************************************************/
+static BenchTicks measure(BenchFunction function, float minTimeS, uint32_t& iterations) {
+  iterations = 1;
+  for (;;) {
+    BenchState state(iterations);
+    function(state);
+    BenchTicks ticks = state.getTicks();
+
+    float seconds = ticksToSeconds(ticks);
+    if (seconds >= minTimeS || iterations >= BENCH_MAX_ITERATIONS) {
+      return ticks;
+    }
+
+    float multiplier = seconds > 0 ? minTimeS * 1.4f / seconds : 10.0f;
+    multiplier = constrain(multiplier, 2.0f, 10.0f);
+    float next = iterations * multiplier;
+    iterations = next >= BENCH_MAX_ITERATIONS ? BENCH_MAX_ITERATIONS : (uint32_t)next;
+  }
+}
+
+/*******************************************************************************
+ * REPORTS
+ ******************************************************************************/
+static void printJsonHeader(Print& json, const BenchOptions& options) {
+  json.println(F("{"));
+  json.println(F("  \"context\": {"));
+  if (options.date) {
+    json.print(F("    \"date\": \""));
+    json.print(options.date);
+    json.println(F("\","));
+  }
+  json.println(F("    \"executable\": \"firmware_bench\","));
+#if defined(__AVR__)
+  json.println(F("    \"mode\": \"avr\","));
+  json.print(F("    \"mhz_per_cpu\": "));
+  json.print(F_CPU / 1000000UL);
+  json.println(',');
+#else
+  json.println(F("    \"mode\": \"host\","));
+#endif
+  json.print(F("    \"eeprom_version\": "));
+  json.println(EEPROM_VERSION);
+  json.println(F("  },"));
+  json.print(F("  \"benchmarks\": ["));
+}
+
+static void printJsonResult(Print& json, bool first, const char* name, uint32_t iterations,
+                            float nsPerIteration, BenchTicks ticks) {
+  json.println(first ? F("") : F(","));
+  json.println(F("    {"));
+  json.print(F("      \"name\": \""));
+  json.print((const __FlashStringHelper*)name);
+  json.println(F("\","));
+  json.println(F("      \"run_type\": \"iteration\","));
+  json.print(F("      \"iterations\": "));
+  json.print(iterations);
+  json.println(',');
+  json.print(F("      \"real_time\": "));
+  json.print(nsPerIteration, 3);
+  json.println(',');
+  json.print(F("      \"cpu_time\": "));
+  json.print(nsPerIteration, 3);
+  json.println(',');
+#if defined(__AVR__)
+  json.print(F("      \"cycles_per_iteration\": "));
+  json.print((float)ticks / iterations, 1);
+  json.println(',');
+#else
+  (void)ticks;
+#endif
+  json.println(F("      \"time_unit\": \"ns\""));
+  json.print(F("    }"));
+}
+
+static void printConsoleHeader(Print& console) {
+  console.print(F("Benchmark"));
+  for (uint8_t i = 9; i < BENCH_NAME_WIDTH; i++) {
+    console.print(' ');
+  }
+#if defined(__AVR__)
+  console.println(F("      Time(ns)      Cycles  Iterations"));
+#else
+  console.println(F("      Time(ns)  Iterations"));
+#endif
+}
+
+static void printRight(Print& console, const String& text, uint8_t width) {
+  for (uint8_t i = text.length(); i < width; i++) {
+    console.print(' ');
+  }
+  console.print(text);
+}
+
+static void printConsoleResult(Print& console, const char* name, uint32_t iterations,
+                               float nsPerIteration, BenchTicks ticks) {
+  console.print((const __FlashStringHelper*)name);
+  for (uint8_t i = strlen_P(name); i < BENCH_NAME_WIDTH; i++) {
+    console.print(' ');
+  }
+  printRight(console, String(nsPerIteration, 2), 14);
+#if defined(__AVR__)
+  printRight(console, String((float)ticks / iterations, 1), 12);
+#else
+  (void)ticks;
+#endif
+  printRight(console, String(iterations), 12);
+  console.println();
+}
+
+/*******************************************************************************
+ * RUNNER
+ ******************************************************************************/
+uint16_t benchRunAll(const BenchOptions& options) {
+  if (options.json) {
+    printJsonHeader(*options.json, options);
+  }
+  if (options.console) {
+    printConsoleHeader(*options.console);
+  }
+
+  uint16_t count = 0;
+  for (BenchCase* c = nextByName(NULL); c != NULL; c = nextByName(c)) {
+    if (!nameMatches(c->name, options.filter)) {
+      continue;
+    }
+
+    uint32_t iterations;
+    BenchTicks ticks = measure(c->function, options.minTimeS, iterations);
+    float nsPerIteration = ticksToSeconds(ticks) * 1e9f / iterations;
+
+    if (options.json) {
+      printJsonResult(*options.json, count == 0, c->name, iterations, nsPerIteration, ticks);
+    }
+    if (options.console) {
+      printConsoleResult(*options.console, c->name, iterations, nsPerIteration, ticks);
+    }
+    count++;
+  }
+
+  if (options.json) {
+    options.json->println();
+    options.json->println(F("  ]"));
+    options.json->println(F("}"));
+  }
+  return count;
+}
+
+/*******************************************************************************
+ * END OF BENCH HARNESS IMPLEMENTATION
+ ******************************************************************************/
@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * BENCH.H - Microbenchmark Harness (Host and AVR)
+ *
+ * Purpose:
+ *   Small Google-Benchmark-style harness that builds both natively and
+ *   for the ATmega328P, so the same firmware hot paths can be timed on a
+ *   workstation (nanoseconds) and in simavr (exact CPU cycles).
+ *
+ * Writing a benchmark:
+ *   static void BM_Crc16Block16(BenchState& state) {
+ *     uint8_t block[16] = { ... };
+ *     while (state.keepRunning()) {
+ *       benchKeep(crc16Update(0xFFFF, block, sizeof(block)));
+ *     }
+ *   }
+ *   BENCHMARK(BM_Crc16Block16);
+ *
+ * Timing:
+ *   Host: steady clock; iterations grow until a run lasts minTime.
+ *   AVR:  Timer1 at F_CPU (prescaler 1) counts cycles; Timer0 (millis)
+ *         is stopped during a run so no interrupt lands in the count.
+ *   Only the loop is timed; the loop overhead (keepRunning) is included.
+ *
+ * Output:
+ *   JSON in the layout Google Benchmark writes ("context", then one
+ *   object per benchmark with name, iterations, real_time, time_unit),
+ *   plus "cycles_per_iteration" on the AVR.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <Arduino.h>
+
+/*******************************************************************************
+ * CLASS: BenchState - iteration control handed to each benchmark
+ ******************************************************************************/
+#if defined(__AVR__)
+typedef uint32_t BenchTicks;   // CPU cycles
+#else
+typedef uint64_t BenchTicks;   // Nanoseconds
+#endif
+
+class BenchState {
+public:
+  explicit BenchState(uint32_t iterations)
+    : _remaining(iterations), _started(false), _ticks(0) {}
+
+  /*
+   * True while iterations are left. The clock runs from the first call
+   * to the last, so setup code before the loop is not measured.
+   */
+  bool keepRunning() {
+    if (_remaining > 0) {
+      if (!_started) {
+        _start();
+      }
+      _remaining--;
+      return true;
+    }
+    _stop();
+    return false;
+  }
+
+  BenchTicks getTicks() const { return _ticks; }
+
+private:
+  uint32_t _remaining;
+  bool _started;
+  BenchTicks _ticks;
+
+  void _start();
+  void _stop();
+};
+
+typedef void (*BenchFunction)(BenchState& state);
+
+/*
+ * Keep a result alive / make the compiler assume memory changed, so the
+ * measured work is not optimized away or hoisted out of the loop.
+ */
+template <typename T>
+inline void benchKeep(const T& value) {
+  __asm__ __volatile__("" : : "m"(value) : "memory");
+}
+
+inline void benchClobber() {
+  __asm__ __volatile__("" : : : "memory");
+}
+
+/*******************************************************************************
+ * REGISTRATION
+ ******************************************************************************/
+class BenchCase {
+public:
+  BenchCase(const char* name, BenchFunction function);   // name in PROGMEM
+
+  const char* name;
+  BenchFunction function;
+  BenchCase* next;
+};
+
+#define BENCHMARK(function) \
+  static const char function##_name[] PROGMEM = #function; \
+  static BenchCase function##_case(function##_name, function)
+
+/*******************************************************************************
+ * RUNNER
+ ******************************************************************************/
+struct BenchOptions {
+  const char* filter;   // Run names containing this (NULL: all)
+  float minTimeS;       // Per benchmark
+  Print* console;       // Human-readable table (NULL: none)
+  Print* json;          // JSON report (NULL: none)
+  const char* date;     // Context "date" (NULL: omitted)
+};
+
+/*
+ * Run every registered benchmark matching options.filter, in name order.
+ * Returns the number of benchmarks run.
+ */
+uint16_t benchRunAll(const BenchOptions& options);
+
+/*
+ * Print registered benchmark names, one per line.
+ */
+void benchList(Print& out);
+
+#endif // BENCH_H
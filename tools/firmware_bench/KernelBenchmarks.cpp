@@ -0,0 +1,250 @@
+/*******************************************************************************
+ * KERNELBENCHMARKS.CPP - Firmware Hot Paths (Host and AVR)
+ *
+ * Benchmarks that need only the firmware modules, so they run both
+ * natively and in simavr:
+ *
+ *   BM_Calibration*   least-squares fit, R², RMSE (5-point EC low set)
+ *   BM_Crc16*         CRC16 per byte, per block, over a calibration image
+ *                     and over EEPROM (EEPROMManager::_calculateCRC16)
+ *   BM_Format*        FastFormat against Print::print(float) (core)
+ *   BM_Filter*        exponential filter, window average, updateFilters()
+ *
+ * Private methods are reached through FirmwareBench, which the firmware
+ * classes declare as a friend. Each benchmark uses its own instances,
+ * never the sketch globals.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "Bench.h"
+#include "Config.h"
+#include "Calibration.h"
+#include "CRC16.h"
+#include "EEPROMManager.h"
+#include "FastFormat.h"
+#include "SensorReader.h"
+
+/*******************************************************************************
+ * FIXTURES
+ ******************************************************************************/
+
+// EC low calibration as the Calibrator records it: mV against uS/cm
+static const float EC_MV[5]  = { 180.4, 421.7, 899.2, 1551.8, 2049.3 };
+static const float EC_REF[5] = { 65.0, 200.0, 500.0, 1000.0, 1413.0 };
+
+static SensorReader benchSensor(PIN_EC_SENSOR, PIN_TEMP_SENSOR, PIN_PH_SENSOR);
+static Calibration benchCalibration(&benchSensor);
+static EEPROMManager benchEeprom;
+
+/*
+ * Print target that throws output away, so only formatting is timed
+ */
+class NullPrint : public Print {
+public:
+  virtual size_t write(uint8_t c) { benchKeep(c); return 1; }
+  virtual size_t write(const uint8_t* buffer, size_t size) { benchKeep(buffer); return size; }
+  using Print::write;
+};
+
+static NullPrint nullPrint;
+
+/*******************************************************************************
+ * CLASS: FirmwareBench - access to private firmware methods
+ ******************************************************************************/
+class FirmwareBench {
+public:
+  static void linearRegression(const float x[], const float y[], uint8_t count,
+                               float& C, float& D) {
+    benchCalibration._linearRegression(x, y, count, C, D);
+  }
+
+  static float calculateR2(const float x[], const float y[], float C, float D, uint8_t count) {
+    return benchCalibration._calculateR2(x, y, C, D, count);
+  }
+
+  static float calculateRMSE(const float x[], const float y[], float C, float D, uint8_t count) {
+    return benchCalibration._calculateRMSE(x, y, C, D, count);
+  }
+
+  static uint16_t calculateCRC16(uint16_t startAddr, uint16_t endAddr) {
+    return benchEeprom._calculateCRC16(startAddr, endAddr);
+  }
+
+  static float applyFilter(float newValue, float oldValue) {
+    return benchSensor._applyFilter(newValue, oldValue);
+  }
+
+  /*
+   * Fill the EC window with what one 200 ms filter period collects
+   * (3 samples at 66 ms) and average it
+   */
+  static float takeAverage() {
+    float millivolts = 0;
+    benchSensor._ecWindow.sum = 3 * 310;
+    benchSensor._ecWindow.count = 3;
+    benchSensor._takeAverage(benchSensor._ecWindow, millivolts);
+    return millivolts;
+  }
+
+  /*
+   * One filter period with full windows on a seeded sensor
+   */
+  static void updateFilters() {
+    benchSensor._seeded = true;
+    benchSensor._ecWindow.sum = 3 * 310;
+    benchSensor._ecWindow.count = 3;
+    benchSensor._tempWindow.sum = 3 * 164;
+    benchSensor._tempWindow.count = 3;
+    benchSensor._pHWindow.sum = 10 * 512;
+    benchSensor._pHWindow.count = 10;
+    benchSensor.updateFilters();
+  }
+};
+
+/*******************************************************************************
+ * CALIBRATION MATH
+ ******************************************************************************/
+static void BM_CalibrationLinearRegression5(BenchState& state) {
+  float C, D;
+  while (state.keepRunning()) {
+    FirmwareBench::linearRegression(EC_MV, EC_REF, 5, C, D);
+    benchKeep(C);
+    benchKeep(D);
+  }
+}
+BENCHMARK(BM_CalibrationLinearRegression5);
+
+static void BM_CalibrationR2_5(BenchState& state) {
+  float C, D;
+  FirmwareBench::linearRegression(EC_MV, EC_REF, 5, C, D);
+  while (state.keepRunning()) {
+    benchKeep(FirmwareBench::calculateR2(EC_MV, EC_REF, C, D, 5));
+  }
+}
+BENCHMARK(BM_CalibrationR2_5);
+
+static void BM_CalibrationRMSE5(BenchState& state) {
+  float C, D;
+  FirmwareBench::linearRegression(EC_MV, EC_REF, 5, C, D);
+  while (state.keepRunning()) {
+    benchKeep(FirmwareBench::calculateRMSE(EC_MV, EC_REF, C, D, 5));
+  }
+}
+BENCHMARK(BM_CalibrationRMSE5);
+
+/*******************************************************************************
+ * CRC16
+ ******************************************************************************/
+static void BM_Crc16Byte(BenchState& state) {
+  uint16_t crc = CRC16_INIT;
+  uint8_t data = 0;
+  while (state.keepRunning()) {
+    crc = crc16Update(crc, data++);
+  }
+  benchKeep(crc);
+}
+BENCHMARK(BM_Crc16Byte);
+
+static void BM_Crc16Block16(BenchState& state) {
+  uint8_t block[16];
+  for (uint8_t i = 0; i < sizeof(block); i++) {
+    block[i] = i * 17;
+  }
+  while (state.keepRunning()) {
+    benchKeep(crc16Update(CRC16_INIT, block, sizeof(block)));
+  }
+}
+BENCHMARK(BM_Crc16Block16);
+
+static void BM_Crc16CalImage(BenchState& state) {
+  static uint8_t image[CAL_IMAGE_SIZE];
+  for (uint16_t i = 0; i < CAL_IMAGE_SIZE; i++) {
+    image[i] = i * 31;
+  }
+  while (state.keepRunning()) {
+    benchKeep(crc16Update(CRC16_INIT, image, CAL_IMAGE_CRC_SPAN));
+  }
+}
+BENCHMARK(BM_Crc16CalImage);
+
+// Same span as a journal record check, read cell by cell from EEPROM
+static void BM_Crc16EepromCalImage(BenchState& state) {
+  while (state.keepRunning()) {
+    benchKeep(FirmwareBench::calculateCRC16(0, CAL_IMAGE_CRC_SPAN - 1));
+  }
+}
+BENCHMARK(BM_Crc16EepromCalImage);
+
+/*******************************************************************************
+ * FLOAT FORMATTING
+ ******************************************************************************/
+static void BM_FormatFixed2(BenchState& state) {
+  char buf[FORMAT_BUFFER_SIZE];
+  float value = 1413.27;
+  while (state.keepRunning()) {
+    benchKeep(formatFixed(buf, value, 2));
+    benchClobber();
+  }
+}
+BENCHMARK(BM_FormatFixed2);
+
+static void BM_FormatFixed4(BenchState& state) {
+  char buf[FORMAT_BUFFER_SIZE];
+  float value = 0.99871;
+  while (state.keepRunning()) {
+    benchKeep(formatFixed(buf, value, 4));
+    benchClobber();
+  }
+}
+BENCHMARK(BM_FormatFixed4);
+
+static void BM_FormatPrintFixed2(BenchState& state) {
+  float value = 1413.27;
+  while (state.keepRunning()) {
+    benchKeep(printFixed(nullPrint, value, 2));
+  }
+}
+BENCHMARK(BM_FormatPrintFixed2);
+
+// Baseline: the core's float printing that FastFormat replaces
+static void BM_FormatPrintFloat2(BenchState& state) {
+  float value = 1413.27;
+  Print& out = nullPrint;
+  while (state.keepRunning()) {
+    benchKeep(out.print(value, 2));
+  }
+}
+BENCHMARK(BM_FormatPrintFloat2);
+
+/*******************************************************************************
+ * FILTER KERNELS
+ ******************************************************************************/
+static void BM_FilterApply(BenchState& state) {
+  float filtered = 1200.0;
+  float input = 1210.0;
+  while (state.keepRunning()) {
+    filtered = FirmwareBench::applyFilter(input, filtered);
+    benchKeep(filtered);
+  }
+}
+BENCHMARK(BM_FilterApply);
+
+static void BM_FilterTakeAverage(BenchState& state) {
+  while (state.keepRunning()) {
+    benchKeep(FirmwareBench::takeAverage());
+  }
+}
+BENCHMARK(BM_FilterTakeAverage);
+
+static void BM_FilterUpdateFilters(BenchState& state) {
+  while (state.keepRunning()) {
+    FirmwareBench::updateFilters();
+  }
+}
+BENCHMARK(BM_FilterUpdateFilters);
+
+/*******************************************************************************
+ * END OF KERNEL BENCHMARKS
+ ******************************************************************************/
@@ -0,0 +1,51 @@
+/*******************************************************************************
+ * FIRMWARE_BENCH.INO - Cycle Counts on the ATmega328P (simavr or a Board)
+ *
+ * Purpose:
+ *   Runs the kernel benchmarks (KernelBenchmarks.cpp) on the real CPU
+ *   model and prints the JSON report to Serial, with
+ *   "cycles_per_iteration" counted by Timer1. The sketch-level
+ *   benchmarks (handleCommand, parseFloatArg) need the whole sketch and
+ *   run on the host only (main.cpp).
+ *
+ * Build and run under simavr (the firmware modules are used as a library):
+ *   arduino-cli compile --fqbn arduino:avr:uno \
+ *       --library ArduinoBothV15 --output-dir build/bench tools/firmware_bench
+ *   simavr -m atmega328p -f 16000000 build/bench/firmware_bench.ino.elf \
+ *       > bench_avr.json
+ *
+ * simavr prints the UART to stdout and exits when the CPU sleeps with
+ * interrupts off, which is how the sketch ends. On a board, read the JSON
+ * from the serial monitor at SERIAL_BAUD_RATE.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include "Bench.h"
+#include "Config.h"
+#include <avr/sleep.h>
+
+// Cycle counts do not vary between runs, so short runs are enough
+const float AVR_BENCH_MIN_TIME_S = 0.02;
+
+void setup() {
+  Serial.begin(SERIAL_BAUD_RATE);
+
+  BenchOptions options;
+  options.filter = NULL;
+  options.minTimeS = AVR_BENCH_MIN_TIME_S;
+  options.console = NULL;
+  options.json = &Serial;
+  options.date = NULL;   // No clock on the board
+  benchRunAll(options);
+
+  Serial.flush();
+  cli();
+  set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+  sleep_enable();
+  sleep_cpu();   // simavr: "sleeping with interrupts off, quitting"
+}
+
+void loop() {
+}
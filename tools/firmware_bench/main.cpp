@@ -0,0 +1,185 @@
+/*******************************************************************************
+ * MAIN.CPP - Host Entry Point for the Firmware Benchmarks
+ *
+ * Purpose:
+ *   Runs the kernel benchmarks (KernelBenchmarks.cpp) plus the sketch-level
+ *   ones below, which need the sketch globals and so exist on the host
+ *   only: command dispatch through handleCommand() and parseFloatArg().
+ *
+ * Usage:
+ *   firmware_bench [--filter text] [--min-time s] [--json file] [--list]
+ *
+ *   Save a baseline and compare a later firmware against it, e.g. with
+ *   Google Benchmark's tools/compare.py:
+ *     firmware_bench --json v15.json
+ *     compare.py benchmarks v15.json v16.json
+ *
+ * AVR cycle counts:
+ *   firmware_bench.ino runs the kernel benchmarks on the ATmega328P and
+ *   prints the same JSON to Serial (see that file). The Arduino builder
+ *   compiles every .cpp in the sketch folder, so this file is empty there.
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#if !defined(ARDUINO)
+
+#include <Arduino.h>
+#include "Bench.h"
+#include "HalLinux.h"
+#include "OutputQueue.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// ArduinoBothV15.ino
+void handleCommand(String command);
+float parseFloatArg(String command, String commandName);
+
+/*******************************************************************************
+ * SKETCH BENCHMARKS
+ *
+ * Each iteration includes queuing the reply and draining it to the
+ * (discarded) serial port, as the firmware's loop() would.
+ ******************************************************************************/
+static void benchCommand(BenchState& state, const char* text) {
+  String command(text);
+  while (state.keepRunning()) {
+    handleCommand(command);
+    SerialOut.flush();
+  }
+}
+
+static void BM_SketchHandleCommandRead(BenchState& state) {
+  benchCommand(state, "READ");
+}
+BENCHMARK(BM_SketchHandleCommandRead);
+
+static void BM_SketchHandleCommandStatusCompact(BenchState& state) {
+  benchCommand(state, "STATUS_COMPACT");
+}
+BENCHMARK(BM_SketchHandleCommandStatusCompact);
+
+// Falls through every comparison to the "unknown command" reply
+static void BM_SketchHandleCommandUnknown(BenchState& state) {
+  benchCommand(state, "NOT_A_COMMAND");
+}
+BENCHMARK(BM_SketchHandleCommandUnknown);
+
+static void BM_SketchParseFloatArg(BenchState& state) {
+  String command("SET_EC_LOW_5 1413.0");
+  String name("SET_EC_LOW_5");
+  while (state.keepRunning()) {
+    benchKeep(parseFloatArg(command, name));
+  }
+}
+BENCHMARK(BM_SketchParseFloatArg);
+
+/*******************************************************************************
+ * OUTPUT
+ ******************************************************************************/
+class FilePrint : public Print {
+public:
+  explicit FilePrint(FILE* file) : _file(file) {}
+  virtual size_t write(uint8_t c) { return fputc(c, _file) == EOF ? 0 : 1; }
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    return fwrite(buffer, 1, size, _file);
+  }
+  using Print::write;
+
+private:
+  FILE* _file;
+};
+
+static void usage(const char* program) {
+  fprintf(stderr,
+          "Usage: %s [--filter text] [--min-time s] [--json file] [--list]\n"
+          "  --filter:   run benchmarks whose name contains text\n"
+          "  --min-time: seconds per benchmark (default 0.1)\n"
+          "  --json:     write results as JSON (Google Benchmark layout)\n"
+          "  --list:     print benchmark names and exit\n",
+          program);
+}
+
+int main(int argc, char** argv) {
+  BenchOptions options;
+  options.filter = NULL;
+  options.minTimeS = 0.1;
+  options.console = NULL;
+  options.json = NULL;
+  options.date = NULL;
+
+  const char* jsonPath = NULL;
+  bool list = false;
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    bool hasValue = i + 1 < argc;
+
+    if (strcmp(arg, "--filter") == 0 && hasValue) {
+      options.filter = argv[++i];
+    } else if (strcmp(arg, "--min-time") == 0 && hasValue) {
+      options.minTimeS = atof(argv[++i]);
+      if (options.minTimeS <= 0) {
+        fprintf(stderr, "ERROR: Bad --min-time value: %s\n", argv[i]);
+        return 2;
+      }
+    } else if (strcmp(arg, "--json") == 0 && hasValue) {
+      jsonPath = argv[++i];
+    } else if (strcmp(arg, "--list") == 0) {
+      list = true;
+    } else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+
+  FilePrint console(stdout);
+  if (list) {
+    benchList(console);
+    return 0;
+  }
+
+  FILE* jsonFile = NULL;
+  if (jsonPath) {
+    jsonFile = fopen(jsonPath, "w");
+    if (!jsonFile) {
+      fprintf(stderr, "ERROR: Cannot write %s\n", jsonPath);
+      return 1;
+    }
+  }
+  FilePrint json(jsonFile);
+
+  char date[32];
+  time_t now = time(NULL);
+  strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+
+  options.console = &console;
+  options.json = jsonFile ? &json : NULL;
+  options.date = date;
+
+  // Boot the sketch once; its serial output is not part of the report
+  halLinuxDiscardSerial();
+  setup();
+  SerialOut.flush();
+
+  uint16_t count = benchRunAll(options);
+
+  if (jsonFile) {
+    fclose(jsonFile);
+  }
+  if (count == 0) {
+    fprintf(stderr, "ERROR: No benchmark matches \"%s\"\n", options.filter ? options.filter : "");
+    return 1;
+  }
+  return 0;
+}
+
+#endif // !ARDUINO
+
+/*******************************************************************************
+ * END OF BENCHMARK ENTRY POINT
+ ******************************************************************************/
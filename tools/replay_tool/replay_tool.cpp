@@ -0,0 +1,686 @@
+/*******************************************************************************
+ * REPLAY_TOOL.CPP - Replay Recorded Sensor Data Through the Firmware
+ *
+ * Purpose:
+ *   Feeds a recorded session through the firmware's own SensorReader
+ *   (sampling windows, exponential filter) and Calibration (equations,
+ *   EC range selection) on a virtual clock, once per candidate setting,
+ *   and writes the readings side by side. A day of data replays in
+ *   seconds, so FILTER_ALPHA and EC_RANGE_THRESHOLD_MV can be tuned on
+ *   real recordings instead of on the bench.
+ *
+ * Usage:
+ *   replay_tool [options] <recording.csv>
+ *
+ *   Options:
+ *     -e <file>   Calibration from an EEPROM image (raw 1024 bytes, e.g.
+ *                 from "eeprom_tool backup <port> unit.bin"); without it
+ *                 the firmware defaults (uncalibrated) are used
+ *     -a <list>   FILTER_ALPHA candidates, comma-separated, each in
+ *                 (0, 1] (default: the Config.h value)
+ *     -t <list>   EC_RANGE_THRESHOLD_MV candidates, comma-separated
+ *                 (default: the Config.h value)
+ *     -o <file>   Per-row output CSV (default: stdout)
+ *
+ *   Every alpha is combined with every threshold.
+ *
+ * Recordings:
+ *   SensorReader BackgroundLogger CSV
+ *     Timestamp,Elapsed (s),EC (µS/cm),Temperature (°C),pH
+ *     Readings are turned back into electrode voltages with the
+ *     calibration from -e (temperature and pH without calibration: the
+ *     uncalibrated formulas). These readings were filtered once on the
+ *     unit already; raw captures give a cleaner picture of filters.
+ *   Raw voltage capture
+ *     time_ms,ec_mv,temp_mv,ph_mv
+ *
+ *   Empty or invalid values (-1 = not calibrated) hold the last voltage.
+ *   Rows before a channel's first usable value, and every row of a
+ *   channel that has none, are left empty in the output and kept out of
+ *   the summary (the ADC sees the first usable voltage, or 0 mV).
+ *
+ * Output:
+ *   CSV, one row per recording row: time, input voltages, logged
+ *   readings (logger input), then EC / temperature / pH / EC range per
+ *   candidate. A summary per candidate goes to stderr:
+ *     *_ROUGH    RMS change between consecutive readings (lower =
+ *                smoother, but also slower to follow real changes)
+ *     SWITCHES   EC range changes (low <-> high)
+ *     *_RMSE     RMS difference to the logged readings (logger input)
+ *
+ * Author: System Rewrite v1.0 - Complete Edition
+ * Date: 2026-02-16
+ ******************************************************************************/
+
+#include <Arduino.h>
+#include "HalLinux.h"
+#include "Hal.h"
+#include "Config.h"
+#include "SensorReader.h"
+#include "Calibration.h"
+#include "EEPROMManager.h"
+
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ * RECORDING
+ ******************************************************************************/
+enum Channel { CH_EC, CH_TEMP, CH_PH, CH_COUNT };
+
+static const char* const CHANNEL_NAMES[CH_COUNT] = { "ec", "temp", "ph" };
+
+struct Row {
+  double timeMs;
+  float mv[CH_COUNT];          // Input voltages (held over invalid values)
+  bool mvValid[CH_COUNT];      // A usable value was seen at or before this row
+  float logged[CH_COUNT];      // Logger input only
+  bool loggedValid[CH_COUNT];
+};
+
+struct Recording {
+  bool fromLogger;
+  std::vector<Row> rows;
+};
+
+static std::vector<std::string> splitCsv(const std::string& line) {
+  std::vector<std::string> fields;
+  std::string field;
+  for (size_t i = 0; i < line.size(); i++) {
+    char c = line[i];
+    if (c == ',') {
+      fields.push_back(field);
+      field.clear();
+    } else if (c != '\r' && c != '\n' && c != '"') {
+      field += c;
+    }
+  }
+  fields.push_back(field);
+  return fields;
+}
+
+static bool parseValue(const std::string& text, float& value) {
+  char* end;
+  value = strtof(text.c_str(), &end);
+  return !text.empty() && end != text.c_str() && std::isfinite(value);
+}
+
+static bool parseTime(const std::string& text, double& value) {
+  char* end;
+  value = strtod(text.c_str(), &end);
+  return !text.empty() && end != text.c_str() && std::isfinite(value);
+}
+
+static int findColumn(const std::vector<std::string>& header, const char* prefix) {
+  for (size_t i = 0; i < header.size(); i++) {
+    if (header[i].compare(0, strlen(prefix), prefix) == 0) {
+      return (int)i;
+    }
+  }
+  return -1;
+}
+
+/*
+ * Electrode voltage (mV) of a logged reading, by inverting the equation
+ * the unit used. False if the reading cannot be inverted.
+ */
+static bool readingToMillivolts(Calibration& cal, Channel channel, float value, float& mv) {
+  float C, D, R2, RMSE;
+
+  switch (channel) {
+    case CH_EC:
+      if (value < 0) {
+        return false;
+      }
+      if (cal.isECLowCalibrated()) {
+        cal.getECLowEquation(C, D, R2, RMSE);
+        if (C != 0) {
+          mv = (value - D) / C;
+          if (mv < cal.getECRangeThreshold() || !cal.isECHighCalibrated()) {
+            return true;
+          }
+        }
+      }
+      if (cal.isECHighCalibrated()) {
+        cal.getECHighEquation(C, D, R2, RMSE);
+        if (C != 0) {
+          mv = (value - D) / C;
+          return true;
+        }
+      }
+      return false;
+
+    case CH_TEMP:
+      if (cal.isTempCalibrated()) {
+        cal.getTempEquation(C, D, R2, RMSE);
+        if (C == 0) {
+          return false;
+        }
+        mv = (value - D) / C;
+      } else {
+        mv = (value / TEMP_SCALE + TEMP_OFFSET_V) * 1000.0;
+      }
+      return true;
+
+    case CH_PH:
+      if (value < 0) {
+        return false;
+      }
+      if (cal.ispHCalibrated()) {
+        cal.getpHEquation(C, D, R2, RMSE);
+        if (C == 0) {
+          return false;
+        }
+        mv = (value - D) / C;
+      } else {
+        mv = (value - 7.0) * PH_MV_PER_UNIT + PH_NEUTRAL_MV;
+      }
+      return true;
+
+    default:
+      return false;
+  }
+}
+
+static bool readRecording(const char* path, Calibration& reference, Recording& recording) {
+  std::ifstream file(path);
+  if (!file) {
+    fprintf(stderr, "ERROR: Cannot open %s: %s\n", path, strerror(errno));
+    return false;
+  }
+
+  std::string line;
+  if (!std::getline(file, line)) {
+    fprintf(stderr, "ERROR: %s is empty\n", path);
+    return false;
+  }
+
+  // === COLUMNS ===
+  std::vector<std::string> header = splitCsv(line);
+  int timeColumn;
+  int columns[CH_COUNT];
+  double timeScale;
+
+  if (findColumn(header, "Elapsed") >= 0) {
+    recording.fromLogger = true;
+    timeColumn = findColumn(header, "Elapsed");
+    columns[CH_EC] = findColumn(header, "EC");
+    columns[CH_TEMP] = findColumn(header, "Temperature");
+    columns[CH_PH] = findColumn(header, "pH");
+    timeScale = 1000.0;
+  } else {
+    recording.fromLogger = false;
+    timeColumn = findColumn(header, "time_ms");
+    columns[CH_EC] = findColumn(header, "ec_mv");
+    columns[CH_TEMP] = findColumn(header, "temp_mv");
+    columns[CH_PH] = findColumn(header, "ph_mv");
+    timeScale = 1.0;
+  }
+
+  if (timeColumn < 0 || columns[CH_EC] < 0 || columns[CH_TEMP] < 0 || columns[CH_PH] < 0) {
+    fprintf(stderr, "ERROR: %s: unknown header (expected a BackgroundLogger CSV "
+                    "or time_ms,ec_mv,temp_mv,ph_mv)\n", path);
+    return false;
+  }
+
+  // === ROWS ===
+  float held[CH_COUNT];
+  bool haveHeld[CH_COUNT] = { false, false, false };
+  unsigned unusable[CH_COUNT] = { 0, 0, 0 };
+  unsigned lineNumber = 1;
+
+  while (std::getline(file, line)) {
+    lineNumber++;
+    std::vector<std::string> fields = splitCsv(line);
+    double time;
+    if (fields.size() <= (size_t)timeColumn || !parseTime(fields[timeColumn], time)) {
+      continue;   // Blank or comment line
+    }
+
+    Row row;
+    row.timeMs = time * timeScale;
+    if (!recording.rows.empty() && row.timeMs < recording.rows.back().timeMs) {
+      fprintf(stderr, "ERROR: %s:%u: time goes backwards\n", path, lineNumber);
+      return false;
+    }
+
+    for (int ch = 0; ch < CH_COUNT; ch++) {
+      float value, mv;
+      bool valid = (size_t)columns[ch] < fields.size() && parseValue(fields[columns[ch]], value);
+
+      row.loggedValid[ch] = false;
+      row.logged[ch] = 0;
+      if (recording.fromLogger && valid) {
+        row.loggedValid[ch] = value >= 0 || ch == CH_TEMP;
+        row.logged[ch] = value;
+        valid = readingToMillivolts(reference, (Channel)ch, value, mv);
+      } else {
+        mv = value;
+      }
+
+      if (valid) {
+        held[ch] = mv;
+        haveHeld[ch] = true;
+      } else {
+        unusable[ch]++;
+      }
+      row.mv[ch] = haveHeld[ch] ? held[ch] : 0;
+      row.mvValid[ch] = haveHeld[ch];
+    }
+    recording.rows.push_back(row);
+  }
+
+  // Leading rows without a value: feed the ADC the first usable voltage
+  // so the filter does not start from 0 mV (their output stays empty)
+  for (int ch = 0; ch < CH_COUNT; ch++) {
+    if (!haveHeld[ch]) {
+      continue;
+    }
+    size_t first = 0;
+    while (!recording.rows[first].mvValid[ch]) {
+      first++;
+    }
+    for (size_t r = 0; r < first; r++) {
+      recording.rows[r].mv[ch] = recording.rows[first].mv[ch];
+    }
+  }
+
+  if (recording.rows.empty()) {
+    fprintf(stderr, "ERROR: %s has no data rows\n", path);
+    return false;
+  }
+
+  for (int ch = 0; ch < CH_COUNT; ch++) {
+    if (unusable[ch] > 0) {
+      fprintf(stderr, "Note: %u %s value(s) unusable%s, previous voltage held\n",
+              unusable[ch], CHANNEL_NAMES[ch],
+              recording.fromLogger && !haveHeld[ch] ? " (channel not calibrated in -e image?)" : "");
+    }
+  }
+  return true;
+}
+
+/*******************************************************************************
+ * CANDIDATES
+ ******************************************************************************/
+struct Stats {
+  unsigned count;
+  double last;
+  double roughSum;    // Sum of squared changes between consecutive readings
+  unsigned roughCount;
+  double errorSum;    // Sum of squared differences to the logged readings
+  unsigned errorCount;
+};
+
+struct Candidate {
+  float alpha;
+  float threshold;
+  SensorReader* sensor;
+  Calibration* cal;
+  Stats stats[CH_COUNT];
+  unsigned switches;
+  char lastRange;
+  char name[32];
+};
+
+static bool parseList(const char* text, std::vector<float>& values) {
+  values.clear();
+  std::string list = text;
+  size_t start = 0;
+  while (start <= list.size()) {
+    size_t comma = list.find(',', start);
+    if (comma == std::string::npos) {
+      comma = list.size();
+    }
+    float value;
+    if (!parseValue(list.substr(start, comma - start), value)) {
+      return false;
+    }
+    values.push_back(value);
+    start = comma + 1;
+  }
+  return !values.empty();
+}
+
+static void record(Stats& stats, float value, bool loggedValid, float logged) {
+  if (stats.count > 0) {
+    double change = value - stats.last;
+    stats.roughSum += change * change;
+    stats.roughCount++;
+  }
+  stats.last = value;
+  stats.count++;
+
+  if (loggedValid) {
+    double error = value - logged;
+    stats.errorSum += error * error;
+    stats.errorCount++;
+  }
+}
+
+static void printStat(double sum, unsigned count) {
+  if (count == 0) {
+    fprintf(stderr, " %10s", "-");
+  } else {
+    fprintf(stderr, " %10.4f", sqrt(sum / count));
+  }
+}
+
+/*******************************************************************************
+ * REPLAY
+ *
+ * The ADC holds each row's voltages until the next row. Sampling and
+ * filter updates run at the scheduler periods of the firmware; readings
+ * are taken at the end of each row's interval.
+ ******************************************************************************/
+static float inputMv[CH_COUNT];
+
+static bool readInput(uint8_t pin, uint16_t& raw) {
+  float mv;
+  if (pin == PIN_EC_SENSOR) {
+    mv = inputMv[CH_EC];
+  } else if (pin == PIN_TEMP_SENSOR) {
+    mv = inputMv[CH_TEMP];
+  } else if (pin == PIN_PH_SENSOR) {
+    mv = inputMv[CH_PH];
+  } else {
+    return false;
+  }
+
+  float counts = mv / ADC_TO_MV_FACTOR + 0.5f;
+  raw = counts <= 0 ? 0 : counts >= ADC_MAX ? ADC_MAX : (uint16_t)counts;
+  return true;
+}
+
+static uint64_t clockUs = 0;
+
+static void advanceTo(uint64_t us) {
+  if (us > clockUs) {
+    halLinuxAdvanceClock((uint32_t)(us - clockUs));
+    clockUs = us;
+  }
+}
+
+static void runUntil(std::vector<Candidate>& candidates, uint64_t endUs, uint64_t next[4]) {
+  static const uint32_t periodsUs[4] = {
+    EC_SAMPLE_PERIOD_MS * 1000UL, TEMP_SAMPLE_PERIOD_MS * 1000UL,
+    PH_SAMPLE_PERIOD_MS * 1000UL, FILTER_PERIOD_MS * 1000UL
+  };
+
+  for (;;) {
+    int due = 0;
+    for (int task = 1; task < 4; task++) {
+      if (next[task] < next[due]) {
+        due = task;
+      }
+    }
+    if (next[due] >= endUs) {
+      break;
+    }
+
+    advanceTo(next[due]);
+    for (size_t i = 0; i < candidates.size(); i++) {
+      SensorReader* sensor = candidates[i].sensor;
+      switch (due) {
+        case 0: sensor->sampleEC(); break;
+        case 1: sensor->sampleTemp(); break;
+        case 2: sensor->samplepH(); break;
+        default: sensor->updateFilters(); break;
+      }
+    }
+    next[due] += periodsUs[due];
+  }
+  advanceTo(endUs);
+}
+
+static void writeHeader(FILE* out, const Recording& recording, const std::vector<Candidate>& candidates) {
+  fprintf(out, "time_s,ec_mv,temp_mv,ph_mv");
+  if (recording.fromLogger) {
+    fprintf(out, ",log_ec,log_temp,log_ph");
+  }
+  for (size_t i = 0; i < candidates.size(); i++) {
+    const char* name = candidates[i].name;
+    fprintf(out, ",ec_%s,temp_%s,ph_%s,range_%s", name, name, name, name);
+  }
+  fprintf(out, "\n");
+}
+
+static void replay(const Recording& recording, std::vector<Candidate>& candidates, FILE* out) {
+  uint64_t next[4];
+  uint64_t startUs = SENSOR_SETTLE_MS * 1000UL;
+  for (int task = 0; task < 4; task++) {
+    next[task] = startUs;
+  }
+  next[3] = startUs + FILTER_PERIOD_MS * 1000UL;
+
+  const std::vector<Row>& rows = recording.rows;
+  double firstMs = rows[0].timeMs;
+  double lastIntervalMs = rows.size() > 1 ? rows[1].timeMs - rows[0].timeMs : FILTER_PERIOD_MS;
+
+  writeHeader(out, recording, candidates);
+
+  for (size_t r = 0; r < rows.size(); r++) {
+    const Row& row = rows[r];
+    for (int ch = 0; ch < CH_COUNT; ch++) {
+      inputMv[ch] = row.mv[ch];
+    }
+
+    double endMs = r + 1 < rows.size() ? rows[r + 1].timeMs : row.timeMs + lastIntervalMs;
+    if (r + 1 < rows.size()) {
+      lastIntervalMs = rows[r + 1].timeMs - row.timeMs;
+    }
+    runUntil(candidates, startUs + (uint64_t)((endMs - firstMs) * 1000.0), next);
+
+    fprintf(out, "%.3f", (row.timeMs - firstMs) / 1000.0);
+    for (int ch = 0; ch < CH_COUNT; ch++) {
+      if (row.mvValid[ch]) {
+        fprintf(out, ",%.1f", row.mv[ch]);
+      } else {
+        fprintf(out, ",");
+      }
+    }
+    if (recording.fromLogger) {
+      for (int ch = 0; ch < CH_COUNT; ch++) {
+        if (row.loggedValid[ch]) {
+          fprintf(out, ",%.3f", row.logged[ch]);
+        } else {
+          fprintf(out, ",");
+        }
+      }
+    }
+
+    for (size_t i = 0; i < candidates.size(); i++) {
+      Candidate& candidate = candidates[i];
+      float readings[CH_COUNT];
+      readings[CH_EC] = candidate.cal->getCalibratedEC();
+      readings[CH_TEMP] = candidate.cal->getCalibratedTemperature();
+      readings[CH_PH] = candidate.cal->ispHCalibrated() ? candidate.cal->getCalibratedpH()
+                                                        : candidate.sensor->readpH();
+      char range = candidate.sensor->readVoltage_EC() < candidate.threshold ? 'L' : 'H';
+
+      for (int ch = 0; ch < CH_COUNT; ch++) {
+        if (!row.mvValid[ch] || (ch == CH_EC && readings[ch] < 0)) {
+          fprintf(out, ",");
+          continue;
+        }
+        fprintf(out, ",%.3f", readings[ch]);
+        record(candidate.stats[ch], readings[ch], row.loggedValid[ch], row.logged[ch]);
+      }
+      if (!row.mvValid[CH_EC]) {
+        fprintf(out, ",");
+        continue;
+      }
+      fprintf(out, ",%c", range);
+
+      if (candidate.lastRange != 0 && range != candidate.lastRange) {
+        candidate.switches++;
+      }
+      candidate.lastRange = range;
+    }
+    fprintf(out, "\n");
+  }
+}
+
+static void printSummary(const Recording& recording, const std::vector<Candidate>& candidates) {
+  fprintf(stderr, "\n%-18s %10s %10s %10s %8s %10s %10s %10s\n", "CANDIDATE",
+          "EC_ROUGH", "TEMP_ROUGH", "PH_ROUGH", "SWITCHES", "EC_RMSE", "TEMP_RMSE", "PH_RMSE");
+  for (size_t i = 0; i < candidates.size(); i++) {
+    const Candidate& candidate = candidates[i];
+    fprintf(stderr, "%-18s", candidate.name);
+    for (int ch = 0; ch < CH_COUNT; ch++) {
+      printStat(candidate.stats[ch].roughSum, candidate.stats[ch].roughCount);
+    }
+    fprintf(stderr, " %8u", candidate.switches);
+    for (int ch = 0; ch < CH_COUNT; ch++) {
+      printStat(candidate.stats[ch].errorSum, recording.fromLogger ? candidate.stats[ch].errorCount : 0);
+    }
+    fprintf(stderr, "\n");
+  }
+}
+
+static void usage() {
+  fprintf(stderr,
+          "Usage: replay_tool [-e eeprom.bin] [-a alphas] [-t thresholds] [-o out.csv] <recording.csv>\n"
+          "  <recording.csv>: BackgroundLogger CSV or time_ms,ec_mv,temp_mv,ph_mv\n"
+          "  -e: calibration from a raw EEPROM image (eeprom_tool backup)\n"
+          "  -a: FILTER_ALPHA candidates in (0, 1], e.g. 0.1,0.3,0.5 (default %.2f)\n"
+          "  -t: EC_RANGE_THRESHOLD_MV candidates, e.g. 900,980 (default %.0f)\n",
+          FILTER_ALPHA, EC_RANGE_THRESHOLD_MV);
+}
+
+/*******************************************************************************
+ * MAIN
+ ******************************************************************************/
+int main(int argc, char** argv) {
+  const char* eepromPath = NULL;
+  const char* outPath = NULL;
+  std::vector<float> alphas(1, FILTER_ALPHA);
+  std::vector<float> thresholds(1, EC_RANGE_THRESHOLD_MV);
+
+  int arg = 1;
+  while (arg < argc && argv[arg][0] == '-') {
+    const char* option = argv[arg];
+    if (arg + 1 >= argc) {
+      usage();
+      return 2;
+    }
+    const char* value = argv[arg + 1];
+
+    bool ok = true;
+    if (strcmp(option, "-e") == 0) {
+      eepromPath = value;
+    } else if (strcmp(option, "-o") == 0) {
+      outPath = value;
+    } else if (strcmp(option, "-a") == 0) {
+      ok = parseList(value, alphas);
+      // Outside (0, 1] the filter does not converge (or never moves)
+      for (size_t i = 0; ok && i < alphas.size(); i++) {
+        if (!(alphas[i] > 0 && alphas[i] <= 1)) {
+          fprintf(stderr, "ERROR: Alpha %g is outside (0, 1]\n", alphas[i]);
+          ok = false;
+        }
+      }
+    } else if (strcmp(option, "-t") == 0) {
+      ok = parseList(value, thresholds);
+    } else {
+      ok = false;
+    }
+    if (!ok) {
+      usage();
+      return 2;
+    }
+    arg += 2;
+  }
+
+  if (argc - arg != 1) {
+    usage();
+    return 2;
+  }
+  const char* recordingPath = argv[arg];
+
+  // === FIRMWARE ON A VIRTUAL CLOCK ===
+  halLinuxDiscardSerial();
+  halLinuxUseVirtualClock();
+  halLinuxSetAnalogSource(readInput);
+  if (eepromPath && !halLinuxLoadNv(eepromPath)) {
+    return 1;
+  }
+
+  EEPROMManager eeprom;
+  SensorReader referenceSensor(PIN_EC_SENSOR, PIN_TEMP_SENSOR, PIN_PH_SENSOR);
+  Calibration reference(&referenceSensor);
+  reference.begin();
+  if (eepromPath && !eeprom.load(reference)) {
+    fprintf(stderr, "ERROR: No valid calibration in %s\n", eepromPath);
+    return 1;
+  }
+
+  Recording recording;
+  if (!readRecording(recordingPath, reference, recording)) {
+    return 1;
+  }
+
+  std::vector<Candidate> candidates;
+  for (size_t a = 0; a < alphas.size(); a++) {
+    for (size_t t = 0; t < thresholds.size(); t++) {
+      Candidate candidate;
+      memset(&candidate, 0, sizeof(candidate));
+      candidate.alpha = alphas[a];
+      candidate.threshold = thresholds[t];
+      snprintf(candidate.name, sizeof(candidate.name), "a%.2f_t%.0f", alphas[a], thresholds[t]);
+
+      candidate.sensor = new SensorReader(PIN_EC_SENSOR, PIN_TEMP_SENSOR, PIN_PH_SENSOR);
+      candidate.sensor->setFilterAlpha(candidate.alpha);
+      candidate.sensor->begin();
+      candidate.cal = new Calibration(candidate.sensor);
+      candidate.cal->begin();
+      if (eepromPath) {
+        eeprom.load(*candidate.cal);
+      }
+      candidate.cal->setECRangeThreshold(candidate.threshold);
+      candidates.push_back(candidate);
+    }
+  }
+
+  FILE* out = stdout;
+  if (outPath) {
+    out = fopen(outPath, "w");
+    if (!out) {
+      fprintf(stderr, "ERROR: Cannot create %s: %s\n", outPath, strerror(errno));
+      return 1;
+    }
+  }
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  replay(recording, candidates, out);
+  double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  if (out != stdout) {
+    fclose(out);
+  }
+
+  const std::vector<Row>& rows = recording.rows;
+  double spanS = (rows.back().timeMs - rows.front().timeMs) / 1000.0;
+  fprintf(stderr, "Replayed %zu rows (%.1f h) x %zu candidates in %.2f s (%.0fx real time)\n",
+          rows.size(), spanS / 3600.0, candidates.size(), wallS,
+          wallS > 0 ? spanS / wallS : 0.0);
+  printSummary(recording, candidates);
+
+  for (size_t i = 0; i < candidates.size(); i++) {
+    delete candidates[i].cal;
+    delete candidates[i].sensor;
+  }
+  return 0;
+}
+
+/*******************************************************************************
+ * END OF REPLAY_TOOL
+ ******************************************************************************/